@@ -10,7 +10,8 @@
  *        - Registry protected by Tcl mutexes; keys are stable string handle
  *          names to avoid ABA hazards from pointer reuse.
  *        - Uses Tcl_Condition for signaling completion.
- *        - Pool is created on first oraexecasync, torn down at process exit.
+ *        - Pool is created on first use (oraexecasync, orafetchasync, fetch
+ *          readahead), torn down at process exit.
  *
  *  Copyright (c) 2025 Miguel Bañón.
  *
@@ -77,8 +78,12 @@ typedef struct OradpiAsyncEntry {
  * Thread-pool work queue
  * ========================================================================= */
 
+/* A work item is either an async execute (stmtKey set, proc NULL) or a
+ * generic job submitted through Oradpi_PoolSubmit (proc set). */
 typedef struct PoolWorkItem {
     char                *stmtKey; /* owned copy of registry key (not a raw pointer) */
+    Oradpi_PoolJobProc  *proc;
+    void                *clientData;
     struct PoolWorkItem *next;
 } PoolWorkItem;
 
@@ -116,6 +121,7 @@ int                         Oradpi_Cmd_ExecAsync(void *cd, Tcl_Interp *ip, Tcl_S
 int                         Oradpi_Cmd_WaitAsync(void *cd, Tcl_Interp *ip, Tcl_Size objc, Tcl_Obj *const objv[]);
 int                         Oradpi_StmtWaitForAsync(OradpiStmt *s, int cancel, int timeoutMs);
 int                         Oradpi_StmtIsAsyncBusy(OradpiStmt *s);
+int                         Oradpi_PoolSubmit(Oradpi_PoolJobProc *proc, void *clientData);
 
 static void                 PoolEnsure(void);
 static Tcl_Size             PoolThreadCount(void);
@@ -272,6 +278,14 @@ static void PoolThreadProc(void *cd) {
             gPool.tail = NULL;
         Tcl_MutexUnlock(&gPool.queueMutex);
 
+        if (item->proc) {
+            Oradpi_PoolJobProc *proc = item->proc;
+            void               *jcd  = item->clientData;
+            Tcl_Free((char *)item);
+            proc(jcd, 0);
+            continue;
+        }
+
         /* work item carries a string key, not a raw pointer */
         char *key = item->stmtKey;
         Tcl_Free((char *)item);
@@ -350,10 +364,40 @@ static void PoolEnqueue(const char *key) {
     memcpy(keyCopy, key, (size_t)klen + 1);
 
     PoolWorkItem *item = (PoolWorkItem *)Tcl_Alloc(sizeof(*item));
-    item->stmtKey      = keyCopy;
-    item->next         = NULL;
+    memset(item, 0, sizeof(*item));
+    item->stmtKey = keyCopy;
+
+    Tcl_MutexLock(&gPool.queueMutex);
+    if (gPool.tail)
+        gPool.tail->next = item;
+    else
+        gPool.head = item;
+    gPool.tail = item;
+    Tcl_ConditionNotify(&gPool.queueCond);
+    Tcl_MutexUnlock(&gPool.queueMutex);
+}
+
+/* Queue proc(clientData, 0) on a pool worker.  Jobs still queued at
+ * process exit are run as proc(clientData, 1) on the exiting thread so
+ * their owners can release state instead of waiting forever.  Jobs follow
+ * the worker contract below.  Returns TCL_ERROR (no interp message) when
+ * the pool cannot be started or is shutting down. */
+int Oradpi_PoolSubmit(Oradpi_PoolJobProc *proc, void *clientData) {
+    PoolEnsure();
+    if (PoolThreadCount() == 0)
+        return TCL_ERROR;
+
+    PoolWorkItem *item = (PoolWorkItem *)Tcl_Alloc(sizeof(*item));
+    memset(item, 0, sizeof(*item));
+    item->proc       = proc;
+    item->clientData = clientData;
 
     Tcl_MutexLock(&gPool.queueMutex);
+    if (gPool.shutdown) {
+        Tcl_MutexUnlock(&gPool.queueMutex);
+        Tcl_Free((char *)item);
+        return TCL_ERROR;
+    }
     if (gPool.tail)
         gPool.tail->next = item;
     else
@@ -361,6 +405,7 @@ static void PoolEnqueue(const char *key) {
     gPool.tail = item;
     Tcl_ConditionNotify(&gPool.queueCond);
     Tcl_MutexUnlock(&gPool.queueMutex);
+    return TCL_OK;
 }
 
 static void PoolExitHandler(void *unused) {
@@ -463,14 +508,19 @@ static void PoolExitHandler(void *unused) {
     }
 
     Tcl_MutexLock(&gPool.queueMutex);
-    while (gPool.head) {
-        PoolWorkItem *item = gPool.head;
-        gPool.head         = item->next;
+    PoolWorkItem *drained = gPool.head;
+    gPool.head            = NULL;
+    gPool.tail            = NULL;
+    Tcl_MutexUnlock(&gPool.queueMutex);
+    while (drained) {
+        PoolWorkItem *item = drained;
+        drained            = item->next;
+        if (item->proc)
+            item->proc(item->clientData, 1); /* canceled: never ran */
         if (item->stmtKey)
             Tcl_Free(item->stmtKey);
         Tcl_Free((char *)item);
     }
-    Tcl_MutexUnlock(&gPool.queueMutex);
 
     if (remaining == 0) {
         Tcl_ConditionFinalize(&gPool.exitCond);
@@ -701,7 +751,10 @@ int Oradpi_Cmd_ExecAsync(void *cd, Tcl_Interp *ip, Tcl_Size objc, Tcl_Obj *const
 
     if (!s->stmt || !s->owner || !s->owner->conn)
         return Oradpi_SetError(ip, (OradpiBase *)s, -1, "statement is not prepared");
+    if (s->fetchAsync)
+        return Oradpi_SetError(ip, (OradpiBase *)s, -1, "statement is busy (async fetch in progress)");
 
+    Oradpi_ReadaheadDiscard(s);
     PoolEnsure();
     if (PoolThreadCount() == 0)
         return Oradpi_SetError(ip, (OradpiBase *)s, -1, "failed to create async thread pool (Tcl_CreateThread failed; check system thread limits)");
@@ -913,6 +966,7 @@ int Oradpi_Cmd_WaitAsync(void *cd, Tcl_Interp *ip, Tcl_Size objc, Tcl_Obj *const
         if (dpiStmt_getRowCount(s->stmt, &rows) == DPI_SUCCESS)
             Oradpi_RecordRows((OradpiBase *)s, rows);
         CONN_GATE_LEAVE(s->owner);
+        Oradpi_ResultCacheStmtDone(s);
     }
 
     if (rc != 0) {
@@ -946,6 +1000,8 @@ int Oradpi_Cmd_WaitAsync(void *cd, Tcl_Interp *ip, Tcl_Size objc, Tcl_Obj *const
 int Oradpi_StmtWaitForAsync(OradpiStmt *s, int cancel, int timeoutMs) {
     if (!s || !s->base.name)
         return 0;
+    if (cancel)
+        Oradpi_FetchAsyncCancel(s);
     const char       *key = Tcl_GetString(s->base.name);
 
     OradpiAsyncEntry *ae  = AsyncLookup(key);
@@ -1003,6 +1059,8 @@ int Oradpi_StmtWaitForAsync(OradpiStmt *s, int cancel, int timeoutMs) {
 int Oradpi_StmtIsAsyncBusy(OradpiStmt *s) {
     if (!s || !s->base.name)
         return 0;
+    if (s->fetchAsync)
+        return 1;
     const char       *key = Tcl_GetString(s->base.name);
     OradpiAsyncEntry *ae  = AsyncLookup(key);
     if (!ae)
@@ -16,6 +16,8 @@
 
 #include <limits.h>
 #include <stdatomic.h>
+#include <stdio.h>
+#include <stdlib.h>
 #include <string.h>
 /* strncasecmp is declared in <strings.h> on POSIX, not <string.h> */
 #ifndef _WIN32
@@ -41,6 +43,7 @@ static BindStoreMap                *GetBindStoreMap(Tcl_Interp *ip);
 static PendingMap                  *GetPendingMap(Tcl_Interp *ip);
 static OradpiPendingRefs           *GetPendings(Tcl_Interp *ip, const char *stmtKey);
 static int                          is_blob_hint(const char *nameNoColon);
+static int                          IsCursorMarker(Tcl_Obj *v);
 static int                          is_clob_hint(const char *nameNoColon);
 static void                         StoreBind(BindStore *bs, const char *nameNoColon, Tcl_Obj *v);
 static int                          strcasestr_contains(const char *hay, const char *needle);
@@ -330,6 +333,78 @@ void Oradpi_ClearBindStoreForStmt(Tcl_Interp *ip, const char *stmtKey) {
     Oradpi_BindStoreForget(ip, stmtKey);
 }
 
+typedef struct BindKeyItem {
+    const char *name;
+    Tcl_Obj    *value;
+} BindKeyItem;
+
+static int CompareBindKeyItems(const void *a, const void *b) {
+    return strcmp(((const BindKeyItem *)a)->name, ((const BindKeyItem *)b)->name);
+}
+
+/* Append the stored binds of a statement to a result cache key, sorted by
+ * name so the key does not depend on bind order.  Returns 0 when the
+ * binds cannot key a cached result (a -cursor bind), else 1. */
+/* The bind type Oradpi_BindOneByValue picks for a value, as one letter
+ * for result cache keys: values with the same text can bind as different
+ * types (a bytearray as BLOB, "1.0" as a double) and select other rows. */
+static char BindKeyKind(const char *nameNoColon, Tcl_Obj *v) {
+    if (is_blob_hint(nameNoColon) || IsBytearrayObj(v))
+        return 'B';
+    Tcl_Size    sl = 0;
+    const char *sv = Tcl_GetStringFromObj(v, &sl);
+    if (sl > 0 && memchr(sv, '\0', (size_t)sl) != NULL)
+        return 'B';
+    if (sl > 4000)
+        return 'C';
+    Tcl_WideInt wi;
+    double      dd;
+    if (Tcl_GetWideIntFromObj(NULL, v, &wi) == TCL_OK)
+        return 'I';
+    if (Tcl_GetDoubleFromObj(NULL, v, &dd) == TCL_OK)
+        return 'D';
+    return 'S';
+}
+
+int Oradpi_BindStoreAppendKey(Tcl_Interp *ip, const char *stmtKey, Tcl_DString *ds) {
+    BindStoreMap  *bm = GetBindStoreMap(ip);
+    Tcl_HashEntry *he = Tcl_FindHashEntry(&bm->byStmt, stmtKey);
+    BindStore     *bs = he ? (BindStore *)Tcl_GetHashValue(he) : NULL;
+    if (!bs || bs->byName.numEntries == 0)
+        return 1;
+
+    Tcl_Size       n     = bs->byName.numEntries;
+    BindKeyItem   *items = (BindKeyItem *)Tcl_Alloc((size_t)n * sizeof(BindKeyItem));
+    Tcl_Size       k     = 0;
+    Tcl_HashSearch hs;
+    for (Tcl_HashEntry *e = Tcl_FirstHashEntry(&bs->byName, &hs); e && k < n; e = Tcl_NextHashEntry(&hs)) {
+        items[k].name  = (const char *)Tcl_GetHashKey(&bs->byName, e);
+        items[k].value = (Tcl_Obj *)Tcl_GetHashValue(e);
+        k++;
+    }
+    qsort(items, (size_t)k, sizeof(BindKeyItem), CompareBindKeyItems);
+
+    int ok = 1;
+    for (Tcl_Size i = 0; i < k && ok; i++) {
+        if (!items[i].value || IsCursorMarker(items[i].value)) {
+            ok = 0;
+            break;
+        }
+        /* Length-prefixed so no value can be mistaken for a separator. */
+        Tcl_Size    vlen = 0;
+        char        kind = BindKeyKind(items[i].name, items[i].value);
+        const char *v    = Tcl_GetStringFromObj(items[i].value, &vlen);
+        char        lenBuf[32];
+        snprintf(lenBuf, sizeof(lenBuf), "=%c%" TCL_SIZE_MODIFIER "d:", kind, vlen);
+        Tcl_DStringAppend(ds, "\n:", 2);
+        Tcl_DStringAppend(ds, items[i].name, -1);
+        Tcl_DStringAppend(ds, lenBuf, -1);
+        Tcl_DStringAppend(ds, v, vlen);
+    }
+    Tcl_Free((char *)items);
+    return ok;
+}
+
 /* ---- PendingRefs (dpiVar* refs kept alive until execution) ---- */
 
 /* PendingMap is embedded in OradpiInterpState; this
@@ -452,6 +527,171 @@ void Oradpi_PendingsForget(Tcl_Interp *ip, const char *stmtKey) {
     Tcl_DeleteHashEntry(he);
 }
 
+/* ---- REF CURSOR OUT binds ---- */
+
+/* The value "-cursor" binds a REF CURSOR OUT variable instead of a string. */
+static int IsCursorMarker(Tcl_Obj *v) {
+    Tcl_Size    n = 0;
+    const char *p = Tcl_GetStringFromObj(v, &n);
+    return n == 7 && memcmp(p, "-cursor", 7) == 0;
+}
+
+static OradpiCursorBind *FindCursorBind(OradpiStmt *s, const char *nameNoColon) {
+    for (Tcl_Size i = 0; i < s->nCursorBinds; i++)
+        if (strcmp(Tcl_GetString(s->cursorBinds[i].name), nameNoColon) == 0)
+            return &s->cursorBinds[i];
+    return NULL;
+}
+
+static OradpiCursorBind *AddCursorBind(OradpiStmt *s, const char *nameNoColon) {
+    OradpiCursorBind *cb = FindCursorBind(s, nameNoColon);
+    if (cb)
+        return cb;
+    size_t bytes   = sizeof(OradpiCursorBind) * (size_t)(s->nCursorBinds + 1);
+    s->cursorBinds = (OradpiCursorBind *)(s->cursorBinds ? Tcl_Realloc((char *)s->cursorBinds, bytes) : Tcl_Alloc(bytes));
+    cb             = &s->cursorBinds[s->nCursorBinds++];
+    memset(cb, 0, sizeof(*cb));
+    cb->name = Tcl_NewStringObj(nameNoColon, -1);
+    Tcl_IncrRefCount(cb->name);
+    return cb;
+}
+
+/* Drop the cursor binds of a statement that is being re-prepared or freed.
+ * Handles already registered from them stay open until oraclose. */
+void Oradpi_CursorBindsFree(OradpiStmt *s) {
+    for (Tcl_Size i = 0; i < s->nCursorBinds; i++) {
+        OradpiCursorBind *cb = &s->cursorBinds[i];
+        if (cb->var)
+            dpiVar_release(cb->var);
+        if (cb->handle)
+            Tcl_DecrRefCount(cb->handle);
+        Tcl_DecrRefCount(cb->name);
+    }
+    if (s->cursorBinds)
+        Tcl_Free((char *)s->cursorBinds);
+    s->cursorBinds  = NULL;
+    s->nCursorBinds = 0;
+}
+
+/* Bind a fresh statement variable for the next execute.  The cursor is
+ * registered by Oradpi_RegisterCursorBinds after the execute; prefetch has
+ * to be set on it here, before the execute that opens it. */
+static int BindOneCursor(Tcl_Interp *ip, OradpiStmt *s, const char *nameNoColon) {
+    dpiVar  *var      = NULL;
+    dpiData *data     = NULL;
+    uint32_t prefetch = s->prefetchRows ? s->prefetchRows : s->owner->prefetchRows;
+
+    CONN_GATE_ENTER(s->owner);
+    if (dpiConn_newVar(s->owner->conn, DPI_ORACLE_TYPE_STMT, DPI_NATIVE_TYPE_STMT, 1, 0, 0, 0, NULL, &var, &data) != DPI_SUCCESS) {
+        CONN_GATE_LEAVE(s->owner);
+        return Oradpi_SetErrorFromODPI(ip, (OradpiBase *)s, "dpiConn_newVar(STMT)");
+    }
+    if (dpiStmt_setPrefetchRows(data->value.asStmt, prefetch) != DPI_SUCCESS) {
+        CONN_GATE_LEAVE(s->owner);
+        dpiVar_release(var);
+        return Oradpi_SetErrorFromODPI(ip, (OradpiBase *)s, "dpiStmt_setPrefetchRows");
+    }
+    CONN_GATE_LEAVE(s->owner);
+
+    if (BindVarByNameDual(s, nameNoColon, var, ip, "dpiStmt_bindByName(STMT)") != TCL_OK) {
+        dpiVar_release(var);
+        return TCL_ERROR;
+    }
+
+    OradpiCursorBind *cb = AddCursorBind(s, nameNoColon);
+    if (cb->var)
+        dpiVar_release(cb->var);
+    cb->var  = var;
+    cb->data = data;
+    return TCL_OK;
+}
+
+/* The statement handle a returned cursor is registered as: the handle
+ * of the previous execute while the script keeps it open, so executing
+ * again does not pile up handles, else a new one.  The previous cursor
+ * and its fetch state are dropped.  Takes over the caller's reference to
+ * child. */
+static OradpiStmt *CursorBindStmt(Tcl_Interp *ip, OradpiStmt *s, OradpiCursorBind *cb, dpiStmt *child) {
+    OradpiStmt *rs = cb->handle ? Oradpi_LookupStmt(ip, cb->handle) : NULL;
+    if (rs && (rs->owner != s->owner || Oradpi_StmtIsAsyncBusy(rs)))
+        rs = NULL;
+    if (!rs) {
+        rs = Oradpi_NewStmt(ip, s->owner);
+    } else {
+        Oradpi_ReadaheadDiscard(rs);
+        Oradpi_FreeFetchCache(rs);
+        if (rs->stmt) {
+            CONN_GATE_ENTER(s->owner);
+            dpiStmt_close(rs->stmt, NULL, 0);
+            dpiStmt_release(rs->stmt);
+            CONN_GATE_LEAVE(s->owner);
+        }
+        rs->scrollable = 0;
+    }
+    rs->stmt         = child;
+    rs->stmtIsQuery  = 1;
+    rs->fetchArray   = s->fetchArray;
+    rs->fetchAuto    = s->fetchAuto;
+    rs->prefetchRows = s->prefetchRows;
+    rs->internMax    = s->internMax;
+    rs->dateFormat   = s->dateFormat;
+    return rs;
+}
+
+/* Close every cursor handle of s; used when an execute's cursors cannot
+ * all be registered. */
+static void CursorBindsUnregister(Tcl_Interp *ip, OradpiStmt *s) {
+    for (Tcl_Size i = 0; i < s->nCursorBinds; i++) {
+        OradpiCursorBind *cb = &s->cursorBinds[i];
+        if (!cb->handle)
+            continue;
+        OradpiStmt *rs = Oradpi_LookupStmt(ip, cb->handle);
+        if (rs && rs->owner == s->owner && !Oradpi_StmtIsAsyncBusy(rs))
+            Oradpi_RemoveStmt(ip, rs);
+        Tcl_DecrRefCount(cb->handle);
+        cb->handle = NULL;
+    }
+}
+
+/* Register the cursor each "orabind :name -cursor" variable returned as a
+ * statement handle of the same connection, with its fetch cache already
+ * built.  A NULL cursor leaves the bind without one.  On error no handle
+ * of this statement's cursor binds is left open. */
+int Oradpi_RegisterCursorBinds(Tcl_Interp *ip, OradpiStmt *s) {
+    for (Tcl_Size i = 0; i < s->nCursorBinds; i++) {
+        OradpiCursorBind *cb = &s->cursorBinds[i];
+        if (!cb->var || cb->data->isNull || !cb->data->value.asStmt) {
+            if (cb->handle) {
+                Tcl_DecrRefCount(cb->handle);
+                cb->handle = NULL;
+            }
+            continue;
+        }
+
+        dpiStmt *child = cb->data->value.asStmt;
+        CONN_GATE_ENTER(s->owner);
+        if (s->fetchArray && dpiStmt_setFetchArraySize(child, s->fetchArray) != DPI_SUCCESS) {
+            CONN_GATE_LEAVE(s->owner);
+            Oradpi_SetErrorFromODPI(ip, (OradpiBase *)s, "dpiStmt_setFetchArraySize");
+            CursorBindsUnregister(ip, s);
+            return TCL_ERROR;
+        }
+        dpiStmt_addRef(child);
+        CONN_GATE_LEAVE(s->owner);
+
+        OradpiStmt *rs = CursorBindStmt(ip, s, cb, child);
+        if (cb->handle)
+            Tcl_DecrRefCount(cb->handle);
+        cb->handle = rs->base.name;
+        Tcl_IncrRefCount(cb->handle);
+        if (Oradpi_BuildFetchCache(ip, rs) != TCL_OK) {
+            CursorBindsUnregister(ip, s);
+            return TCL_ERROR;
+        }
+    }
+    return TCL_OK;
+}
+
 /* ---- Core bind-by-value logic (shared) ---- */
 
 static int BindOneLobScalar(Tcl_Interp *ip, OradpiStmt *s, OradpiPendingRefs *pr, const char *nameNoColon, dpiOracleTypeNum lobType, const char *buf, uint32_t buflen) {
@@ -497,6 +737,8 @@ static int BindOneLobScalar(Tcl_Interp *ip, OradpiStmt *s, OradpiPendingRefs *pr
 }
 
 int Oradpi_BindOneByValue(Tcl_Interp *ip, OradpiStmt *s, OradpiPendingRefs *pr, const char *nameNoColon, Tcl_Obj *valueObj) {
+    if (IsCursorMarker(valueObj))
+        return BindOneCursor(ip, s, nameNoColon);
     if (is_blob_hint(nameNoColon)) {
         Tcl_Size             blen   = 0;
         const unsigned char *bp     = NULL;
@@ -606,6 +848,25 @@ int Oradpi_RebindAllStored(Tcl_Interp *ip, OradpiStmt *s, OradpiPendingRefs *pr,
 
 /* ---- Command implementations ---- */
 
+/* "orabind statement-handle :name": the cursor handle of a -cursor bind
+ * (empty before the first execute or for a NULL cursor), else the stored
+ * value. */
+static int BindQuery(Tcl_Interp *ip, OradpiStmt *s, const char *stmtKey, const char *nameNoColon) {
+    OradpiCursorBind *cb = FindCursorBind(s, nameNoColon);
+    if (cb) {
+        Tcl_SetObjResult(ip, cb->handle ? cb->handle : Tcl_NewObj());
+        return TCL_OK;
+    }
+    BindStoreMap  *bm = GetBindStoreMap(ip);
+    Tcl_HashEntry *he = Tcl_FindHashEntry(&bm->byStmt, stmtKey);
+    BindStore     *bs = he ? (BindStore *)Tcl_GetHashValue(he) : NULL;
+    Tcl_HashEntry *ve = bs ? Tcl_FindHashEntry(&bs->byName, nameNoColon) : NULL;
+    if (!ve)
+        return Oradpi_SetError(ip, (OradpiBase *)s, -1, "no such bind variable");
+    Tcl_SetObjResult(ip, (Tcl_Obj *)Tcl_GetHashValue(ve));
+    return TCL_OK;
+}
+
 /*
  * orabind statement-handle :name value ?:name value ...?
  *
@@ -613,7 +874,10 @@ int Oradpi_RebindAllStored(Tcl_Interp *ip, OradpiStmt *s, OradpiPendingRefs *pr,
  *   Bind names must start with ':'. Values are stored for automatic rebind
  *   on subsequent oraexec calls. Type inference: int64 > double > string;
  *   bytearray → BLOB; name hinting (blob/clob) overrides type inference.
- *   Returns: 0 on success.
+ *   The value -cursor binds a REF CURSOR OUT variable; each execute
+ *   registers the returned cursor as a statement handle, which
+ *   "orabind statement-handle :name" then returns.
+ *   Returns: 0 on success; the bound value or cursor handle when queried.
  *   Errors:  ODPI-C bind errors; invalid/unprepared handle; missing pairs.
  *   Thread-safety: safe — per-interp bind store only.
  */
@@ -634,6 +898,9 @@ int Oradpi_Cmd_Orabind(void *cd, Tcl_Interp *ip, Tcl_Size objc, Tcl_Obj *const o
         return Oradpi_SetError(ip, (OradpiBase *)s, -1, "statement is busy (async operation in progress)");
 
     const char        *stmtKey = Tcl_GetString(objv[1]);
+    if (objc == 3 && Tcl_GetString(objv[2])[0] == ':')
+        return BindQuery(ip, s, stmtKey, Oradpi_StripColon(Tcl_GetString(objv[2])));
+
     OradpiPendingRefs *pr      = GetPendings(ip, stmtKey);
     Oradpi_PendingsReleaseAll(pr);
     BindStore *bs  = GetBindStore(ip, stmtKey);
@@ -1028,8 +1295,11 @@ int Oradpi_Cmd_Orabindexec(void *cd, Tcl_Interp *ip, Tcl_Size objc, Tcl_Obj *con
         Oradpi_RecordRows((OradpiBase *)s, rows);
     CONN_GATE_LEAVE(s->owner);
     Oradpi_UpdateStmtType(s);
+    Oradpi_ResultCacheStmtDone(s);
 
     Oradpi_PendingsReleaseAll(pr);
+    if (s->nCursorBinds && Oradpi_RegisterCursorBinds(ip, s) != TCL_OK)
+        return TCL_ERROR;
 
     Tcl_SetObjResult(ip, Tcl_NewIntObj(0));
     return TCL_OK;
@@ -24,6 +24,7 @@
  * ========================================================================== */
 
 static int ExecOnce_WithRebind(Tcl_Interp *ip, OradpiStmt *s, const char *skey, int doCommit);
+static int CollectImplicitResults(Tcl_Interp *ip, OradpiStmt *s, Tcl_Obj *resultsVar);
 
 /* ------------------------------------------------------------------------- *
  * Implementation
@@ -48,6 +49,23 @@ static int ExecOnce_WithRebind(Tcl_Interp *ip, OradpiStmt *s, const char *skey,
     if (!s->stmt || !s->owner || !s->owner->conn)
         return Oradpi_SetError(ip, (OradpiBase *)s, -1, "statement is not prepared or connection closed");
 
+    /* Re-executing resets the cursor; rows read ahead are stale. */
+    Oradpi_ReadaheadDiscard(s);
+
+    /* A cached result answers the query without executing it; -commit
+     * needs the execute to commit, so it always goes to the database. */
+    if (s->resultCacheTtl && !doCommit) {
+        int hit = 0;
+        if (Oradpi_ResultCacheLookup(ip, s, skey, &hit) != TCL_OK)
+            return TCL_ERROR;
+        if (hit) {
+            Oradpi_PendingsForget(ip, skey);
+            Tcl_SetObjResult(ip, Tcl_NewIntObj(0));
+            return TCL_OK;
+        }
+        Oradpi_ResultCacheSubscribe(s);
+    }
+
     OradpiPendingRefs pr;
     Oradpi_PendingsInit(&pr);
 
@@ -92,8 +110,12 @@ static int ExecOnce_WithRebind(Tcl_Interp *ip, OradpiStmt *s, const char *skey,
                 Oradpi_RecordRows((OradpiBase *)s, rows);
             Oradpi_UpdateStmtType(s);
             CONN_GATE_LEAVE(s->owner);
+            Oradpi_ResultCacheExecuted(s);
+            Oradpi_ResultCacheStmtDone(s);
             Oradpi_PendingsFree(&pr);
             Oradpi_PendingsForget(ip, skey);
+            if (s->nCursorBinds && Oradpi_RegisterCursorBinds(ip, s) != TCL_OK)
+                return TCL_ERROR;
             Tcl_SetObjResult(ip, Tcl_NewIntObj(0));
             return TCL_OK;
         }
@@ -198,6 +220,7 @@ int Oradpi_Cmd_StmtSql(void *cd, Tcl_Interp *ip, Tcl_Size objc, Tcl_Obj *const o
     if (slen < 0 || (uint64_t)slen > UINT32_MAX)
         return Oradpi_SetError(ip, (OradpiBase *)s, -1, "SQL text exceeds maximum length");
     dpiStmt *newStmt = NULL;
+    Oradpi_ReadaheadDiscard(s);
     CONN_GATE_ENTER(s->owner);
     if (dpiConn_prepareStmt(s->owner->conn, 0, sql, (uint32_t)slen, NULL, 0, &newStmt) != DPI_SUCCESS) {
         CONN_GATE_LEAVE(s->owner);
@@ -208,8 +231,9 @@ int Oradpi_Cmd_StmtSql(void *cd, Tcl_Interp *ip, Tcl_Size objc, Tcl_Obj *const o
         dpiStmt_close(s->stmt, NULL, 0);
         dpiStmt_release(s->stmt);
     }
-    s->stmt = newStmt;
-    Oradpi_FreeFetchCache(s);
+    s->stmt       = newStmt;
+    s->scrollable = 0;
+    Oradpi_FetchCacheReparse(s, sql, slen);
     s->stmtIsDML = s->stmtIsPLSQL = s->stmtIsQuery = 0;
     /* Prime the classification cache before releasing the gate.
      * dpiStmt_getInfo does not round-trip; reading it here ensures
@@ -223,6 +247,11 @@ int Oradpi_Cmd_StmtSql(void *cd, Tcl_Interp *ip, Tcl_Size objc, Tcl_Obj *const o
 
     const char *skey = Tcl_GetString(objv[1]);
     Oradpi_ClearBindStoreForStmt(ip, skey);
+    Oradpi_CursorBindsFree(s);
+    Tcl_IncrRefCount(objv[2]);
+    if (s->sqlText)
+        Tcl_DecrRefCount(s->sqlText);
+    s->sqlText = objv[2];
 
     if (parseOnly) {
         Oradpi_UpdateStmtType(s);
@@ -233,14 +262,77 @@ int Oradpi_Cmd_StmtSql(void *cd, Tcl_Interp *ip, Tcl_Size objc, Tcl_Obj *const o
     return ExecOnce_WithRebind(ip, s, skey, doCommit);
 }
 
+/* Close the statement handles listed in handles and drop the list; the
+ * error path of CollectImplicitResults. */
+static int ImplicitResultsUnwind(Tcl_Interp *ip, Tcl_Obj *handles) {
+    Tcl_Size  n     = 0;
+    Tcl_Obj **elems = NULL;
+    if (Tcl_ListObjGetElements(NULL, handles, &n, &elems) == TCL_OK) {
+        for (Tcl_Size i = 0; i < n; i++) {
+            OradpiStmt *rs = Oradpi_LookupStmt(ip, elems[i]);
+            if (rs)
+                Oradpi_RemoveStmt(ip, rs);
+        }
+    }
+    Tcl_DecrRefCount(handles);
+    return TCL_ERROR;
+}
+
+/* Wrap each result set the block returned with DBMS_SQL.RETURN_RESULT in
+ * a statement handle of the same connection, with its fetch cache already
+ * built, and store the list of handles in resultsVar.  On error none of
+ * the handles is left open. */
+static int CollectImplicitResults(Tcl_Interp *ip, OradpiStmt *s, Tcl_Obj *resultsVar) {
+    Tcl_Obj *handles = Tcl_NewListObj(0, NULL);
+    Tcl_IncrRefCount(handles);
+    for (;;) {
+        dpiStmt *child = NULL;
+        CONN_GATE_ENTER(s->owner);
+        if (dpiStmt_getImplicitResult(s->stmt, &child) != DPI_SUCCESS) {
+            CONN_GATE_LEAVE(s->owner);
+            Oradpi_SetErrorFromODPI(ip, (OradpiBase *)s, "dpiStmt_getImplicitResult");
+            return ImplicitResultsUnwind(ip, handles);
+        }
+        if (child && s->fetchArray && dpiStmt_setFetchArraySize(child, s->fetchArray) != DPI_SUCCESS) {
+            dpiStmt_release(child);
+            CONN_GATE_LEAVE(s->owner);
+            Oradpi_SetErrorFromODPI(ip, (OradpiBase *)s, "dpiStmt_setFetchArraySize");
+            return ImplicitResultsUnwind(ip, handles);
+        }
+        CONN_GATE_LEAVE(s->owner);
+        if (!child)
+            break;
+
+        /* Fetch settings follow the parent statement. */
+        OradpiStmt *rs  = Oradpi_NewStmt(ip, s->owner);
+        rs->stmt        = child;
+        rs->stmtIsQuery = 1;
+        rs->fetchArray  = s->fetchArray;
+        rs->fetchAuto   = s->fetchAuto;
+        rs->internMax   = s->internMax;
+        rs->dateFormat  = s->dateFormat;
+        if (Tcl_ListObjAppendElement(ip, handles, rs->base.name) != TCL_OK) {
+            Oradpi_RemoveStmt(ip, rs);
+            return ImplicitResultsUnwind(ip, handles);
+        }
+        if (Oradpi_BuildFetchCache(ip, rs) != TCL_OK)
+            return ImplicitResultsUnwind(ip, handles);
+    }
+    if (!Tcl_ObjSetVar2(ip, resultsVar, NULL, handles, TCL_LEAVE_ERR_MSG))
+        return ImplicitResultsUnwind(ip, handles);
+    Tcl_DecrRefCount(handles);
+    return TCL_OK;
+}
+
 int Oradpi_Cmd_Plexec(void *cd, Tcl_Interp *ip, Tcl_Size objc, Tcl_Obj *const objv[]) {
     (void)cd;
     if (objc < 2) {
-        Tcl_WrongNumArgs(ip, 1, objv, "statement-handle ?{PLSQL block}? ?-commit?");
+        Tcl_WrongNumArgs(ip, 1, objv, "statement-handle ?{PLSQL block}? ?-commit? ?-results varName?");
         return TCL_ERROR;
     }
-    Tcl_Obj *blockObj = NULL;
-    int      doCommit = 0;
+    Tcl_Obj *blockObj   = NULL;
+    Tcl_Obj *resultsVar = NULL;
+    int      doCommit   = 0;
 
     Tcl_Size argi     = 2;
     while (argi < objc) {
@@ -250,11 +342,16 @@ int Oradpi_Cmd_Plexec(void *cd, Tcl_Interp *ip, Tcl_Size objc, Tcl_Obj *const ob
             argi++;
             continue;
         }
+        if (strcmp(t, "-results") == 0 && argi + 1 < objc) {
+            resultsVar = objv[argi + 1];
+            argi += 2;
+            continue;
+        }
         if (!blockObj) {
             blockObj = objv[argi++];
             continue;
         }
-        Tcl_WrongNumArgs(ip, 1, objv, "statement-handle ?{PLSQL block}? ?-commit?");
+        Tcl_WrongNumArgs(ip, 1, objv, "statement-handle ?{PLSQL block}? ?-commit? ?-results varName?");
         return TCL_ERROR;
     }
 
@@ -273,6 +370,7 @@ int Oradpi_Cmd_Plexec(void *cd, Tcl_Interp *ip, Tcl_Size objc, Tcl_Obj *const ob
         if (bl < 0 || (uint64_t)bl > UINT32_MAX)
             return Oradpi_SetError(ip, (OradpiBase *)s, -1, "PL/SQL text exceeds maximum length");
         dpiStmt *newStmt = NULL;
+        Oradpi_ReadaheadDiscard(s);
         CONN_GATE_ENTER(s->owner);
         if (dpiConn_prepareStmt(s->owner->conn, 0, sql, (uint32_t)bl, NULL, 0, &newStmt) != DPI_SUCCESS) {
             CONN_GATE_LEAVE(s->owner);
@@ -282,7 +380,8 @@ int Oradpi_Cmd_Plexec(void *cd, Tcl_Interp *ip, Tcl_Size objc, Tcl_Obj *const ob
             dpiStmt_close(s->stmt, NULL, 0);
             dpiStmt_release(s->stmt);
         }
-        s->stmt = newStmt;
+        s->stmt       = newStmt;
+        s->scrollable = 0;
         Oradpi_FreeFetchCache(s);
         s->stmtIsDML = s->stmtIsPLSQL = s->stmtIsQuery = 0;
         /* Prime classification cache before ExecOnce reads it (no round-trip). */
@@ -291,8 +390,24 @@ int Oradpi_Cmd_Plexec(void *cd, Tcl_Interp *ip, Tcl_Size objc, Tcl_Obj *const ob
         dpiStmt_deleteFromCache(s->stmt);
         CONN_GATE_LEAVE(s->owner);
         Oradpi_ClearBindStoreForStmt(ip, Tcl_GetString(objv[1]));
+        Oradpi_CursorBindsFree(s);
+        Tcl_IncrRefCount(blockObj);
+        if (s->sqlText)
+            Tcl_DecrRefCount(s->sqlText);
+        s->sqlText = blockObj;
     }
 
     const char *skey = Tcl_GetString(objv[1]);
-    return ExecOnce_WithRebind(ip, s, skey, doCommit);
+    if (!resultsVar)
+        return ExecOnce_WithRebind(ip, s, skey, doCommit);
+    if (ExecOnce_WithRebind(ip, s, skey, doCommit) != TCL_OK)
+        return TCL_ERROR;
+    /* Keep the execute result across the handle bookkeeping. */
+    Tcl_Obj *res = Tcl_GetObjResult(ip);
+    Tcl_IncrRefCount(res);
+    int code = CollectImplicitResults(ip, s, resultsVar);
+    if (code == TCL_OK)
+        Tcl_SetObjResult(ip, res);
+    Tcl_DecrRefCount(res);
+    return code;
 }
@@ -5,7 +5,9 @@
  *
  *        - Maps ODPI column types to Tcl objects; supports `-max`, name/position addressing, LOB streaming,
  *          and optional per-row callbacks.
- *        - Per-interp data paths only; no process-global state; thread-safe access to result buffers.
+ *        - Fetch state is per statement; the one process-wide structure is the result cache
+ *          (gRcTable under gRcMutex, freed by an exit handler).  Read-ahead, orafetchasync and
+ *          oraparallelscan run jobs on the shared worker pool (Oradpi_PoolSubmit).
  *
  *  Copyright (c) 2025 Miguel Bañón.
  *
@@ -17,7 +19,18 @@
 #include <inttypes.h>
 #include <limits.h>
 #include <math.h>
+#include <stdlib.h>
 #include <string.h>
+#include <time.h>
+/* strncasecmp is declared in <strings.h> on POSIX, not <string.h> */
+#ifndef _WIN32
+#include <strings.h>
+#endif
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <sys/mman.h>
+#endif
 
 #include "cmd_int.h"
 #include "dpi.h"
@@ -38,6 +51,10 @@ typedef struct OradpiFetchColMeta {
     dpiOracleTypeNum oracleTypeNum;
     dpiNativeTypeNum defaultNativeTypeNum;
     uint32_t         clientSizeInBytes;
+    int16_t          precision;
+    int8_t           scale;
+    int              numText; /* NUMBER defined as exact decimal text */
+    int              longLob; /* LOB defined as LONG_VARCHAR/LONG_RAW */
 } OradpiFetchColMeta;
 
 typedef struct OradpiFetchCell {
@@ -57,6 +74,9 @@ typedef struct OradpiFetchCell {
     dpiLob  *lob;
 } OradpiFetchCell;
 
+/* Receives each row of FetchCellRows. */
+typedef int(OradpiRowSinkProc)(Tcl_Interp *ip, void *sink, const OradpiFetchCell *row);
+
 /* ------------------------------------------------------------------------- *
  * Implementation
  * ------------------------------------------------------------------------- */
@@ -134,6 +154,8 @@ static int SnapshotColumnMeta(Tcl_Interp *ip, OradpiStmt *st, uint32_t numCols,
         meta[c - 1].oracleTypeNum        = qi.typeInfo.oracleTypeNum;
         meta[c - 1].defaultNativeTypeNum = qi.typeInfo.defaultNativeTypeNum;
         meta[c - 1].clientSizeInBytes    = qi.typeInfo.clientSizeInBytes;
+        meta[c - 1].precision            = qi.typeInfo.precision;
+        meta[c - 1].scale                = qi.typeInfo.scale;
         meta[c - 1].nameLen              = qi.nameLength;
         if (qi.nameLength == 0)
             continue;
@@ -265,59 +287,292 @@ static int SnapshotCellLocked(int inlineLobs, dpiNativeTypeNum nt, dpiData *d, i
     }
 }
 
-static Tcl_Obj *SnapshotCellToObj(Tcl_Interp *ip, GlobalConnRec *shared, OradpiFetchCell *cell) {
+/* Scalar conversions shared by the snapshot path (SnapshotCellToObj) and the
+ * direct buffer path (DataToObjDirect) so both produce identical values. */
+static Tcl_Obj *DoubleToObj(double dv) {
+    if (isfinite(dv)) {
+        double intpart;
+        if (modf(dv, &intpart) == 0.0) {
+            if (intpart >= (double)INT_MIN && intpart <= (double)INT_MAX)
+                return Tcl_NewIntObj((int)intpart);
+            if (intpart >= (double)LLONG_MIN && intpart <= (double)LLONG_MAX)
+                return Tcl_NewWideIntObj((Tcl_WideInt)((long long)intpart));
+        }
+    }
+    return Tcl_NewDoubleObj(dv);
+}
+
+static Tcl_Obj *Int64ToObj(int64_t v) {
+    if (v >= INT_MIN && v <= INT_MAX)
+        return Tcl_NewIntObj((int)v);
+    return Tcl_NewWideIntObj((Tcl_WideInt)v);
+}
+
+static Tcl_Obj *UInt64ToObj(uint64_t uv) {
+    if (uv <= (uint64_t)INT64_MAX)
+        return Tcl_NewWideIntObj((Tcl_WideInt)uv);
+    return Tcl_ObjPrintf("%" PRIu64, uv);
+}
+
+/* Days since 1970-01-01 for a proleptic Gregorian date (Howard Hinnant's
+ * days_from_civil); avoids timegm(), which is not available everywhere. */
+static int64_t DaysFromCivil(int y, unsigned m, unsigned d) {
+    y -= m <= 2;
+    int64_t  era = (y >= 0 ? y : y - 399) / 400;
+    unsigned yoe = (unsigned)(y - era * 400);
+    unsigned doy = (153 * (m > 2 ? m - 3 : m + 9) + 2) / 5 + d - 1;
+    unsigned doe = yoe * 365 + yoe / 4 - yoe / 100 + doy;
+    return era * 146097 + (int64_t)doe - 719468;
+}
+
+/* Whole seconds since the Unix epoch, normalized to UTC using the
+ * timestamp's own offset (zero for DATE and plain TIMESTAMP). */
+static int64_t TimestampToEpochSeconds(const dpiTimestamp *ts) {
+    int64_t secs = DaysFromCivil(ts->year, ts->month, ts->day) * 86400 + (int64_t)ts->hour * 3600 + (int64_t)ts->minute * 60 + ts->second;
+    return secs - ((int64_t)ts->tzHourOffset * 3600 + (int64_t)ts->tzMinuteOffset * 60);
+}
+
+static int64_t TimestampToEpochMicros(const dpiTimestamp *ts) {
+    return TimestampToEpochSeconds(ts) * 1000000 + ts->fsecond / 1000;
+}
+
+/* Local-time offsets for "-dateformat clock", one slot per wall-clock
+ * hour, so a column of dates costs one mktime() per distinct hour rather
+ * than one per cell.  The zone is the C library's: the TZ environment
+ * variable (which Tcl's env array writes through to) or else the system
+ * zone, the same source "clock scan" reads.  No Tcl code runs here, so
+ * conversions are safe inside fetch loops, with define buffers live or
+ * the connection gate held.  The cache is per thread and keyed on TZ;
+ * ClockZoneBegin revalidates it once per call. */
+#define CLOCK_ZONE_SLOTS 64
+#define CLOCK_ZONE_KEY_MAX 128
+
+typedef struct OradpiClockZoneCache {
+    int64_t       hour[CLOCK_ZONE_SLOTS]; /* hours since the epoch, wall clock */
+    int64_t       offset[CLOCK_ZONE_SLOTS];
+    unsigned char valid[CLOCK_ZONE_SLOTS];
+    char          key[CLOCK_ZONE_KEY_MAX]; /* TZ the slots were filled under */
+    int           keySet;                  /* key holds a TZ value (else unset) */
+    int           failed;                  /* a value could not be converted */
+    dpiTimestamp  failTs;
+} OradpiClockZoneCache;
+
+static Tcl_ThreadDataKey clockZoneKey;
+
+static OradpiClockZoneCache *ClockZone(void) {
+    return (OradpiClockZoneCache *)Tcl_GetThreadData(&clockZoneKey, sizeof(OradpiClockZoneCache));
+}
+
+/* Start of a call that may convert "clock" dates: drop the cached offsets
+ * if TZ changed since they were computed, and clear the failure mark. */
+static void ClockZoneBegin(void) {
+    OradpiClockZoneCache *zc  = ClockZone();
+    const char           *tz  = getenv("TZ");
+    size_t                len = tz ? strlen(tz) : 0;
+    int                   same;
+    if (tz)
+        same = zc->keySet && len < CLOCK_ZONE_KEY_MAX && memcmp(zc->key, tz, len + 1) == 0;
+    else
+        same = !zc->keySet;
+    if (!same || len >= CLOCK_ZONE_KEY_MAX) {
+        memset(zc->valid, 0, sizeof(zc->valid));
+        zc->keySet = tz != NULL;
+        if (tz && len < CLOCK_ZONE_KEY_MAX)
+            memcpy(zc->key, tz, len + 1);
+        else
+            zc->key[0] = '\0';
+    }
+    zc->failed = 0;
+}
+
+/* TCL_ERROR, with a message, when a "clock" conversion since
+ * ClockZoneBegin had no local time.  Checked before Tcl code can run. */
+static int ClockZoneCheck(Tcl_Interp *ip) {
+    OradpiClockZoneCache *zc = ClockZone();
+    if (!zc->failed)
+        return TCL_OK;
+    zc->failed = 0;
+    Tcl_SetObjResult(ip, Tcl_ObjPrintf("orafetch: -dateformat clock cannot convert %04d-%02u-%02u %02u:%02u:%02u to local time", zc->failTs.year, zc->failTs.month,
+                                       zc->failTs.day, zc->failTs.hour, zc->failTs.minute, zc->failTs.second));
+    Tcl_SetErrorCode(ip, "ORATCL", "DATEFORMAT", "CLOCK", NULL);
+    return TCL_ERROR;
+}
+
+/* Seconds since the epoch reading a zone-less value as local time.  A
+ * value the C library cannot place marks the zone cache failed (see
+ * ClockZoneCheck) and converts as UTC. */
+static int64_t TimestampToClockSeconds(const dpiTimestamp *ts) {
+    int64_t               hourKey = DaysFromCivil(ts->year, ts->month, ts->day) * 24 + ts->hour;
+    int64_t               wall    = hourKey * 3600 + (int64_t)ts->minute * 60 + ts->second;
+    OradpiClockZoneCache *zc      = ClockZone();
+    unsigned              slot    = (unsigned)((uint64_t)hourKey % CLOCK_ZONE_SLOTS);
+    if (zc->valid[slot] && zc->hour[slot] == hourKey)
+        return wall + zc->offset[slot];
+
+    struct tm tm;
+    memset(&tm, 0, sizeof(tm));
+    tm.tm_year  = ts->year - 1900;
+    tm.tm_mon   = ts->month - 1;
+    tm.tm_mday  = ts->day;
+    tm.tm_hour  = ts->hour;
+    tm.tm_isdst = -1;
+    time_t t    = mktime(&tm);
+    /* -1 is also 1969-12-31 23:59:59 UTC, which is never on the hour. */
+    if (t == (time_t)-1 || tm.tm_year != ts->year - 1900 || tm.tm_mon != ts->month - 1 || tm.tm_mday != ts->day) {
+        if (!zc->failed) {
+            zc->failed = 1;
+            zc->failTs = *ts;
+        }
+        return TimestampToEpochSeconds(ts);
+    }
+
+    zc->hour[slot]   = hourKey;
+    zc->offset[slot] = (int64_t)t - hourKey * 3600;
+    zc->valid[slot]  = 1;
+    return wall + zc->offset[slot];
+}
+
+/* Values of "-dateformat" / "oraconfig $S dateformat"; indexed by
+ * ORADPI_DATEFMT_*.  DATEFMT_NONE marks a column without a coltypes
+ * override in st->fetchDateFmt. */
+const char *const Oradpi_DateFormatNames[] = {"iso", "epoch", "epochmicros", "clock", NULL};
+#define DATEFMT_NONE 0xFF
+
+static void Put2Digits(char *p, unsigned v) {
+    p[0] = (char)('0' + v / 10);
+    p[1] = (char)('0' + v % 10);
+}
+
+/* Fixed-width "YYYY-MM-DDTHH:MM:SS.ffffff" without a format-string parse
+ * per cell.  buf must hold at least 40 bytes; returns the length. */
+static int FormatIsoTimestamp(char *buf, const dpiTimestamp *ts) {
+    if (ts->year < 0 || ts->year > 9999)
+        return snprintf(buf, 40, "%04d-%02u-%02uT%02u:%02u:%02u.%06u", ts->year, ts->month, ts->day, ts->hour, ts->minute, ts->second, ts->fsecond / 1000);
+    unsigned us = ts->fsecond / 1000;
+    Put2Digits(buf, (unsigned)ts->year / 100);
+    Put2Digits(buf + 2, (unsigned)ts->year % 100);
+    buf[4] = '-';
+    Put2Digits(buf + 5, ts->month);
+    buf[7] = '-';
+    Put2Digits(buf + 8, ts->day);
+    buf[10] = 'T';
+    Put2Digits(buf + 11, ts->hour);
+    buf[13] = ':';
+    Put2Digits(buf + 14, ts->minute);
+    buf[16] = ':';
+    Put2Digits(buf + 17, ts->second);
+    buf[19] = '.';
+    Put2Digits(buf + 20, us / 10000);
+    Put2Digits(buf + 22, (us / 100) % 100);
+    Put2Digits(buf + 24, us % 100);
+    buf[26] = '\0';
+    return 26;
+}
+
+static Tcl_Obj *TimestampToObj(const dpiTimestamp *ts, int dateFmt) {
+    char buf[40];
+    switch (dateFmt) {
+    case ORADPI_DATEFMT_EPOCH:
+        return Tcl_NewWideIntObj((Tcl_WideInt)TimestampToEpochSeconds(ts));
+    case ORADPI_DATEFMT_EPOCHMICROS:
+        return Tcl_NewWideIntObj((Tcl_WideInt)TimestampToEpochMicros(ts));
+    case ORADPI_DATEFMT_CLOCK:
+        return Tcl_NewWideIntObj((Tcl_WideInt)TimestampToClockSeconds(ts));
+    default:
+        return Tcl_NewStringObj(buf, FormatIsoTimestamp(buf, ts));
+    }
+}
+
+static Tcl_Obj *BytesToObj(const char *ptr, Tcl_Size len, int colIsChar) {
+    if (!ptr || len == 0)
+        return Tcl_NewObj();
+    return colIsChar ? Tcl_NewStringObj(ptr, len) : Tcl_NewByteArrayObj((const unsigned char *)ptr, len);
+}
+
+/* Intern tables are keyed on raw (not NUL-terminated) byte ranges, so
+ * they use a custom hash key type.  The lookup key points into the define
+ * buffer; AllocEntry copies it behind the entry. */
+typedef struct OradpiInternKey {
+    Tcl_Size    len;
+    const char *bytes;
+} OradpiInternKey;
+
+static TCL_HASH_TYPE InternHashKey(Tcl_HashTable *tbl, void *keyPtr) {
+    const OradpiInternKey *k = (const OradpiInternKey *)keyPtr;
+    uint32_t               h = 2166136261u; /* FNV-1a */
+    (void)tbl;
+    for (Tcl_Size i = 0; i < k->len; i++)
+        h = (h ^ (unsigned char)k->bytes[i]) * 16777619u;
+    return (TCL_HASH_TYPE)h;
+}
+
+static int InternCompareKeys(void *keyPtr, Tcl_HashEntry *hPtr) {
+    const OradpiInternKey *k      = (const OradpiInternKey *)keyPtr;
+    const OradpiInternKey *stored = (const OradpiInternKey *)hPtr->key.oneWordValue;
+    return k->len == stored->len && memcmp(k->bytes, stored->bytes, (size_t)k->len) == 0;
+}
+
+static Tcl_HashEntry *InternAllocEntry(Tcl_HashTable *tbl, void *keyPtr) {
+    const OradpiInternKey *k = (const OradpiInternKey *)keyPtr;
+    Tcl_HashEntry         *h = (Tcl_HashEntry *)Tcl_Alloc(sizeof(Tcl_HashEntry) + sizeof(OradpiInternKey) + (size_t)k->len);
+    OradpiInternKey       *copy = (OradpiInternKey *)(h + 1);
+    (void)tbl;
+    copy->len   = k->len;
+    copy->bytes = (const char *)(copy + 1);
+    memcpy((char *)(copy + 1), k->bytes, (size_t)k->len);
+    h->key.oneWordValue = (char *)copy;
+    h->clientData       = NULL;
+    return h;
+}
+
+static void InternFreeEntry(Tcl_HashEntry *hPtr) {
+    Tcl_Free((char *)hPtr);
+}
+
+static const Tcl_HashKeyType internKeyType = {TCL_HASH_KEY_TYPE_VERSION, 0, InternHashKey, InternCompareKeys, InternAllocEntry, InternFreeEntry};
+
+/* Return a shared object for a repeated value, interning new values while
+ * the table has room.  The result may already be referenced by the table,
+ * so callers must treat it as shared. */
+static Tcl_Obj *InternBytesObj(Tcl_HashTable *tbl, uint32_t maxEntries, const char *ptr, Tcl_Size len, int colIsChar) {
+    OradpiInternKey key = {len, ptr};
+    Tcl_HashEntry  *h;
+    Tcl_Obj        *o;
+    int             isNew;
+
+    if (!ptr || len == 0)
+        return Tcl_NewObj();
+    h = Tcl_FindHashEntry(tbl, (const char *)&key);
+    if (h)
+        return (Tcl_Obj *)Tcl_GetHashValue(h);
+    o = BytesToObj(ptr, len, colIsChar);
+    if ((uint32_t)tbl->numEntries < maxEntries) {
+        h = Tcl_CreateHashEntry(tbl, (const char *)&key, &isNew);
+        Tcl_IncrRefCount(o);
+        Tcl_SetHashValue(h, o);
+    }
+    return o;
+}
+
+static Tcl_Obj *SnapshotCellToObj(Tcl_Interp *ip, GlobalConnRec *shared, OradpiFetchCell *cell, int dateFmt) {
     if (!cell || cell->isNull)
         return Tcl_NewObj();
 
     switch (cell->nt) {
-    case DPI_NATIVE_TYPE_INT64: {
-        long long v = cell->scalar.i64;
-        if (v >= INT_MIN && v <= INT_MAX)
-            return Tcl_NewIntObj((int)v);
-        return Tcl_NewWideIntObj((Tcl_WideInt)v);
-    }
-    case DPI_NATIVE_TYPE_UINT64: {
-        uint64_t uv = cell->scalar.u64;
-        if (uv <= (uint64_t)INT64_MAX)
-            return Tcl_NewWideIntObj((Tcl_WideInt)uv);
-        return Tcl_ObjPrintf("%" PRIu64, uv);
-    }
-    case DPI_NATIVE_TYPE_FLOAT: {
-        double dv = (double)cell->scalar.f32;
-        if (isfinite(dv)) {
-            double intpart;
-            if (modf(dv, &intpart) == 0.0) {
-                if (intpart >= (double)INT_MIN && intpart <= (double)INT_MAX)
-                    return Tcl_NewIntObj((int)intpart);
-                if (intpart >= (double)LLONG_MIN && intpart <= (double)LLONG_MAX)
-                    return Tcl_NewWideIntObj((Tcl_WideInt)((long long)intpart));
-            }
-        }
-        return Tcl_NewDoubleObj(dv);
-    }
-    case DPI_NATIVE_TYPE_DOUBLE: {
-        double dv = cell->scalar.f64;
-        if (isfinite(dv)) {
-            double intpart;
-            if (modf(dv, &intpart) == 0.0) {
-                if (intpart >= (double)INT_MIN && intpart <= (double)INT_MAX)
-                    return Tcl_NewIntObj((int)intpart);
-                if (intpart >= (double)LLONG_MIN && intpart <= (double)LLONG_MAX)
-                    return Tcl_NewWideIntObj((Tcl_WideInt)((long long)intpart));
-            }
-        }
-        return Tcl_NewDoubleObj(dv);
-    }
+    case DPI_NATIVE_TYPE_INT64:
+        return Int64ToObj(cell->scalar.i64);
+    case DPI_NATIVE_TYPE_UINT64:
+        return UInt64ToObj(cell->scalar.u64);
+    case DPI_NATIVE_TYPE_FLOAT:
+        return DoubleToObj((double)cell->scalar.f32);
+    case DPI_NATIVE_TYPE_DOUBLE:
+        return DoubleToObj(cell->scalar.f64);
     case DPI_NATIVE_TYPE_BOOLEAN:
         return Tcl_NewBooleanObj(cell->scalar.boolean ? 1 : 0);
-    case DPI_NATIVE_TYPE_TIMESTAMP: {
-        const dpiTimestamp *ts = &cell->scalar.ts;
-        return Tcl_ObjPrintf("%04d-%02u-%02uT%02u:%02u:%02u.%06u", ts->year, ts->month, ts->day, ts->hour, ts->minute, ts->second, ts->fsecond / 1000);
-    }
+    case DPI_NATIVE_TYPE_TIMESTAMP:
+        return TimestampToObj(&cell->scalar.ts, dateFmt);
     case DPI_NATIVE_TYPE_BYTES:
-        if (!cell->bytes || cell->bytesLen == 0)
-            return Tcl_NewObj();
-        return cell->colIsChar ? Tcl_NewStringObj(cell->bytes, cell->bytesLen) : Tcl_NewByteArrayObj((const unsigned char *)cell->bytes, cell->bytesLen);
+        return BytesToObj(cell->bytes, cell->bytesLen, cell->colIsChar);
     case DPI_NATIVE_TYPE_LOB:
         if (cell->lob) {
             /* Use snapshotted shared instead of st->owner->shared */
@@ -325,473 +580,4335 @@ static Tcl_Obj *SnapshotCellToObj(Tcl_Interp *ip, GlobalConnRec *shared, OradpiF
             cell->lob    = NULL; /* ownership transferred to the wrapper */
             return L->base.name;
         }
-        if (!cell->bytes || cell->bytesLen == 0)
-            return Tcl_NewObj();
-        return cell->colIsChar ? Tcl_NewStringObj(cell->bytes, cell->bytesLen) : Tcl_NewByteArrayObj((const unsigned char *)cell->bytes, cell->bytesLen);
+        return BytesToObj(cell->bytes, cell->bytesLen, cell->colIsChar);
     default:
         return Tcl_NewObj();
     }
 }
 
-/* Invalidate and free the per-statement fetch metadata cache.
- * Called on re-parse (oraparse / orasql / oraplexec) and at statement
- * teardown (Oradpi_FreeStmt).  Safe to call on a statement with no cache. */
-void Oradpi_FreeFetchCache(OradpiStmt *s) {
-    if (!s || s->fetchCacheNumCols == 0)
-        return;
-    uint32_t n = s->fetchCacheNumCols;
-    if (s->fetchIsChar) {
-        Tcl_Free((char *)s->fetchIsChar);
-        s->fetchIsChar = NULL;
+/* Build a Tcl_Obj straight from a define buffer entry, skipping the
+ * OradpiFetchCell snapshot.  Only valid for non-LOB columns: BYTES values
+ * are copied once, directly from the ODPI buffer into the new object.  The
+ * caller must convert every column of a row before the first reentrancy
+ * point, since a nested fetch may overwrite the buffer. */
+static Tcl_Obj *DataToObjDirect(Tcl_Interp *ip, dpiNativeTypeNum nt, const dpiData *d, int colIsChar, int dateFmt) {
+    if (!d || d->isNull)
+        return Tcl_NewObj();
+
+    switch (nt) {
+    case DPI_NATIVE_TYPE_INT64:
+        return Int64ToObj(d->value.asInt64);
+    case DPI_NATIVE_TYPE_UINT64:
+        return UInt64ToObj(d->value.asUint64);
+    case DPI_NATIVE_TYPE_FLOAT:
+        return DoubleToObj((double)d->value.asFloat);
+    case DPI_NATIVE_TYPE_DOUBLE:
+        return DoubleToObj(d->value.asDouble);
+    case DPI_NATIVE_TYPE_BOOLEAN:
+        return Tcl_NewBooleanObj(d->value.asBoolean ? 1 : 0);
+    case DPI_NATIVE_TYPE_TIMESTAMP:
+        return TimestampToObj(&d->value.asTimestamp, dateFmt);
+    case DPI_NATIVE_TYPE_BYTES:
+        if (d->value.asBytes.length > (uint32_t)TCL_SIZE_MAX)
+            return NULL;
+        return BytesToObj(d->value.asBytes.ptr, (Tcl_Size)d->value.asBytes.length, colIsChar);
+    default:
+        return Tcl_NewObj();
     }
-    if (s->fetchColNames) {
-        for (uint32_t c = 0; c < n; c++)
-            if (s->fetchColNames[c])
-                Tcl_DecrRefCount(s->fetchColNames[c]);
-        Tcl_Free((char *)s->fetchColNames);
-        s->fetchColNames = NULL;
+}
+
+/* Per-column output form for one orafetch call, from an array built by
+ * ResolveDateFmts (NULL = ISO throughout). */
+static int DateFmtAt(const unsigned char *dateFmts, uint32_t c) {
+    return dateFmts ? dateFmts[c] : ORADPI_DATEFMT_ISO;
+}
+
+/* Combine the call's (or statement's) date format with the coltypes
+ * overrides of the fetch cache.  "clock" reads zone-less values as local
+ * time, so columns that carry a zone fall back to "epoch".  Returns NULL
+ * when every column is ISO; otherwise a Tcl_Alloc'd [numCols] array. */
+static unsigned char *ResolveDateFmts(const OradpiStmt *st, uint32_t numCols, int base) {
+    if (base == ORADPI_DATEFMT_ISO && !st->fetchDateFmt)
+        return NULL;
+    unsigned char *out = (unsigned char *)Tcl_Alloc(numCols);
+    for (uint32_t c = 0; c < numCols; c++) {
+        int f = (st->fetchDateFmt && st->fetchDateFmt[c] != DATEFMT_NONE) ? st->fetchDateFmt[c] : base;
+        if (f == ORADPI_DATEFMT_CLOCK && st->fetchDateTz && st->fetchDateTz[c])
+            f = ORADPI_DATEFMT_EPOCH;
+        out[c] = (unsigned char)f;
     }
-    if (s->fetchNumberKeys) {
-        for (uint32_t c = 0; c < n; c++)
-            if (s->fetchNumberKeys[c])
-                Tcl_DecrRefCount(s->fetchNumberKeys[c]);
-        Tcl_Free((char *)s->fetchNumberKeys);
-        s->fetchNumberKeys = NULL;
+    return out;
+}
+
+static int IsZonedTimestampType(dpiOracleTypeNum otn) {
+    return otn == DPI_ORACLE_TYPE_TIMESTAMP_TZ || otn == DPI_ORACLE_TYPE_TIMESTAMP_LTZ;
+}
+
+/* DataToObjDirect with interning for character columns that have an
+ * intern table.  Reads st->fetchIntern fresh so a callback that disables
+ * interning between rows is honored. */
+static Tcl_Obj *ColumnValueObj(Tcl_Interp *ip, OradpiStmt *st, uint32_t c, dpiNativeTypeNum nt, const dpiData *d, int dateFmt) {
+    if (st->fetchIntern && st->fetchIntern[c] && nt == DPI_NATIVE_TYPE_BYTES && !d->isNull && d->value.asBytes.length <= (uint32_t)TCL_SIZE_MAX)
+        return InternBytesObj(st->fetchIntern[c], st->internMax, d->value.asBytes.ptr, (Tcl_Size)d->value.asBytes.length, 1);
+    return DataToObjDirect(ip, nt, d, st->fetchIsChar[c], dateFmt);
+}
+
+/* -packed column encodings.  PACK_NONE columns stay Tcl lists. */
+enum { PACK_NONE = 0, PACK_INT64, PACK_FLOAT64, PACK_TIMESTAMP };
+static const char *const packKindNames[] = {"", "int64", "float64", "timestamp"};
+
+static int PackKindForNative(dpiNativeTypeNum nt) {
+    switch (nt) {
+    case DPI_NATIVE_TYPE_INT64:
+        return PACK_INT64;
+    case DPI_NATIVE_TYPE_FLOAT:
+    case DPI_NATIVE_TYPE_DOUBLE:
+        return PACK_FLOAT64;
+    case DPI_NATIVE_TYPE_TIMESTAMP:
+        return PACK_TIMESTAMP;
+    default:
+        return PACK_NONE;
     }
-    /* Release pre-defined output variables. */
-    if (s->fetchVars) {
-        for (uint32_t c = 0; c < n; c++)
-            if (s->fetchVars[c])
-                dpiVar_release(s->fetchVars[c]);
-        Tcl_Free((char *)s->fetchVars);
-        s->fetchVars = NULL;
-        Tcl_Free((char *)s->fetchVarData);
-        s->fetchVarData = NULL;
-        Tcl_Free((char *)s->fetchNativeTypes);
-        s->fetchNativeTypes = NULL;
+}
+
+static void PutLE64(unsigned char *p, uint64_t v) {
+    for (int i = 0; i < 8; i++)
+        p[i] = (unsigned char)(v >> (8 * i));
+}
+
+/* NUMBER text defines (SelectNumberDefines) as a double, for -packed,
+ * -arrow and oraresult.  Tcl's number parser is used rather than strtod,
+ * which follows LC_NUMERIC: an embedding application (or Tk) may have set
+ * a locale with a decimal comma. */
+static int DecimalTextToDouble(Tcl_Interp *ip, const char *p, Tcl_Size len, double *out) {
+    Tcl_Obj *obj = Tcl_NewStringObj(p, len);
+    Tcl_IncrRefCount(obj);
+    int rc = Tcl_GetDoubleFromObj(ip, obj, out);
+    Tcl_DecrRefCount(obj);
+    return rc;
+}
+
+/* NUMBER text that is a whole number within int64, as oraresult keeps
+ * it.  Returns 0 for fractions, exponents and values out of range. */
+static int DecimalTextToInt64(const char *p, Tcl_Size len, int64_t *out) {
+    Tcl_Size i   = (len > 0 && p[0] == '-') ? 1 : 0;
+    int      neg = (i == 1);
+    uint64_t max = neg ? (uint64_t)INT64_MAX + 1 : (uint64_t)INT64_MAX;
+    uint64_t v   = 0;
+    if (i == len)
+        return 0;
+    for (; i < len; i++) {
+        if (p[i] < '0' || p[i] > '9')
+            return 0;
+        unsigned d = (unsigned)(p[i] - '0');
+        if (v > (max - d) / 10)
+            return 0;
+        v = v * 10 + d;
     }
-    s->fetchCacheNumCols = 0;
+    if (!neg)
+        *out = (int64_t)v;
+    else
+        *out = (v == (uint64_t)INT64_MAX + 1) ? INT64_MIN : -(int64_t)v;
+    return 1;
 }
 
-/*
- * orafetch statement-handle ?-datavariable varName? ?-dataarray arrName?
- *         ?-indexbyname? ?-indexbynumber? ?-command script? ?-max N?
- *         ?-resultvariable varName? ?-returnrows? ?-asdict?
- *
- *   Fetches rows from a previously executed query. By default returns 0
- *   while rows remain and 1403 at end-of-data. Use -returnrows or
- *   -resultvariable to collect row lists. Options control variable binding,
- *   per-row callbacks, and result format (dict, array, etc.).
- *   Returns: 0 (rows fetched), 1403 (no data found), or a row list when
- *   -returnrows is used.
- *   Errors:  ODPI-C fetch errors; invalid handle; async busy (errors immediately).
- *   Thread-safety: safe — per-interp state only.
- */
-int Oradpi_Cmd_Fetch(void *cd, Tcl_Interp *ip, Tcl_Size objc, Tcl_Obj *const objv[]) {
-    Tcl_Obj            *dataVar     = NULL;
-    Tcl_Obj            *dataArray   = NULL;
-    int                 indexByName = 0, indexByNumber = 0;
-    Tcl_Obj            *cmd             = NULL;
-    Tcl_WideInt         maxRows         = 0;
-    Tcl_Obj            *resultVar       = NULL;
-    /* default to status-code mode (0 / 1403) as documented.
-     * Default to status-code mode (0 / 1403).  -returnrows explicitly
-     * enables list-return mode.  Plain "orafetch $S" fetches a single row
-     * and returns 0 (rows remain) or 1403 (end-of-data). */
-    int                 returnRows      = 0;
-    int                 asDict          = 0;
+/* Append one batch of a packed column: 8 little-endian bytes per row into
+ * dataObj (zero for NULL) and one bit per row into nullObj, set when the
+ * row is NULL.  Both objects are unshared bytearrays owned by the caller;
+ * rowBase is the number of rows already packed. */
+static int PackColumnBatch(Tcl_Interp *ip, int kind, dpiNativeTypeNum nt, const dpiData *col, uint32_t n, uint64_t rowBase, Tcl_Obj *dataObj, Tcl_Obj *nullObj) {
+    uint64_t total = rowBase + n;
+    if (total > (uint64_t)(TCL_SIZE_MAX / 8)) {
+        Tcl_SetObjResult(ip, Tcl_NewStringObj("packed column exceeds maximum bytearray size", -1));
+        return TCL_ERROR;
+    }
+    Tcl_Size       oldBits  = (Tcl_Size)((rowBase + 7) / 8);
+    Tcl_Size       newBits  = (Tcl_Size)((total + 7) / 8);
+    unsigned char *data     = Tcl_SetByteArrayLength(dataObj, (Tcl_Size)(total * 8)) + rowBase * 8;
+    unsigned char *nullBits = Tcl_SetByteArrayLength(nullObj, newBits);
+    memset(nullBits + oldBits, 0, (size_t)(newBits - oldBits));
 
-    uint32_t            numCols         = 0;
-    Tcl_Size            numColsSize     = 0;
-    OradpiFetchColMeta *meta            = NULL;
-    OradpiFetchCell    *cells           = NULL;
-    Tcl_Obj           **colNames        = NULL;
-    Tcl_Obj           **colVals         = NULL;
-    Tcl_Obj           **numberKeys      = NULL;
-    Tcl_Obj            *rowsList        = NULL;
-    Tcl_Obj            *rowObj          = NULL;
-    uint64_t            fetched         = 0;
-    int                 code            = TCL_OK;
-    int                 needNames       = 0;
-    size_t              metaBytes       = 0;
-    size_t              cellBytes       = 0;
-    size_t              colNameBytes    = 0;
-    size_t              colValBytes     = 0;
+    for (uint32_t r = 0; r < n; r++) {
+        uint64_t bits = 0;
+        uint64_t row  = rowBase + r;
+        if (col[r].isNull) {
+            nullBits[row / 8] |= (unsigned char)(1u << (row % 8));
+        } else {
+            switch (kind) {
+            case PACK_INT64:
+                bits = (uint64_t)col[r].value.asInt64;
+                break;
+            case PACK_FLOAT64: {
+                double dv = (nt == DPI_NATIVE_TYPE_FLOAT) ? (double)col[r].value.asFloat : col[r].value.asDouble;
+                if (nt == DPI_NATIVE_TYPE_BYTES && DecimalTextToDouble(ip, col[r].value.asBytes.ptr, (Tcl_Size)col[r].value.asBytes.length, &dv) != TCL_OK)
+                    return TCL_ERROR;
+                memcpy(&bits, &dv, sizeof(bits));
+                break;
+            }
+            case PACK_TIMESTAMP:
+                bits = (uint64_t)TimestampToEpochMicros(&col[r].value.asTimestamp);
+                break;
+            }
+        }
+        PutLE64(data + (size_t)r * 8, bits);
+    }
+    return TCL_OK;
+}
 
-    /* Snapshot handles for reentrancy safety, initialized to NULL
-     * so the single cleanup label can conditionally release them. */
-    dpiStmt            *fetchStmt       = NULL;
-    GlobalConnRec      *fetchShared     = NULL;
-    Tcl_Obj            *stmtNameSnap    = NULL;
-    int                 fetchInlineLobs = 0;
-    int                 fetchDead       = 0;
+/* ---- NUMBER define selection ---- */
 
-    (void)cd;
-    if (objc < 2) {
-        Tcl_WrongNumArgs(ip, 1, objv, "statement-handle ?options?");
+/* ODPI-C already defines NUMBER(p,0) with p <= 18 as INT64 and everything
+ * else as DOUBLE.  With the connection's exactNumbers key set, those
+ * remaining NUMBERs (unconstrained, fractional, or integers too wide for
+ * int64) are defined as exact decimal text instead, so values are never
+ * rounded through a double and no per-cell integer probing is needed.
+ * Runs once per fetch-cache build. */
+static void SelectNumberDefines(OradpiFetchColMeta *meta, uint32_t numCols) {
+    for (uint32_t c = 0; c < numCols; c++) {
+        if (meta[c].oracleTypeNum != DPI_ORACLE_TYPE_NUMBER || meta[c].defaultNativeTypeNum != DPI_NATIVE_TYPE_DOUBLE)
+            continue;
+        meta[c].defaultNativeTypeNum = DPI_NATIVE_TYPE_BYTES;
+        meta[c].isChar               = 1;
+        meta[c].numText              = 1;
+    }
+}
+
+/* ---- LOB define selection ("oraconfig $L inlineLobMax") ---- */
+
+/* Above 32767 bytes ODPI-C gives a variable dynamically grown (piecewise)
+ * buffers, which take a value of any length. */
+#define ORADPI_LONGLOB_DEFINE_BYTES 32768
+
+/* With inlineLobMax set, CLOB, NCLOB and BLOB columns are defined as
+ * LONG_VARCHAR, LONG_NVARCHAR and LONG_RAW, so the values arrive inside
+ * the fetch array instead of as locators that each cost round trips to
+ * read.  The limit only sizes the auto fetch budget here; fetched batches
+ * are checked against it (LongLobOverflow). */
+static void SelectLobDefines(OradpiFetchColMeta *meta, uint32_t numCols, uint32_t maxBytes) {
+    if (!maxBytes)
+        return;
+    for (uint32_t c = 0; c < numCols; c++) {
+        dpiOracleTypeNum otn;
+        switch (meta[c].oracleTypeNum) {
+        case DPI_ORACLE_TYPE_CLOB:
+            otn = DPI_ORACLE_TYPE_LONG_VARCHAR;
+            break;
+        case DPI_ORACLE_TYPE_NCLOB:
+            otn = DPI_ORACLE_TYPE_LONG_NVARCHAR;
+            break;
+        case DPI_ORACLE_TYPE_BLOB:
+            otn = DPI_ORACLE_TYPE_LONG_RAW;
+            break;
+        default:
+            continue;
+        }
+        meta[c].oracleTypeNum        = otn;
+        meta[c].defaultNativeTypeNum = DPI_NATIVE_TYPE_BYTES;
+        meta[c].clientSizeInBytes    = maxBytes;
+        meta[c].longLob              = 1;
+    }
+}
+
+/* ---- Column type overrides ("oraconfig $S coltypes") ---- */
+
+enum { COLTYPE_DEFAULT, COLTYPE_INT64, COLTYPE_UINT64, COLTYPE_DOUBLE, COLTYPE_STRING, COLTYPE_ISO, COLTYPE_EPOCH, COLTYPE_EPOCHMICROS, COLTYPE_CLOCK };
+static const char *const colTypeNames[] = {"default", "int64", "uint64", "double", "string", "iso", "epoch", "epochmicros", "clock", NULL};
+
+/* Define size for date/timestamp columns fetched as text in NLS format. */
+#define ORADPI_COLTYPE_TEXT_BYTES 80
+
+/* Syntax check at configuration time; columns are resolved only once a
+ * result set exists. */
+int Oradpi_CheckColTypes(Tcl_Interp *ip, Tcl_Obj *spec) {
+    Tcl_Size  n     = 0;
+    Tcl_Obj **elems = NULL;
+    if (Tcl_ListObjGetElements(ip, spec, &n, &elems) != TCL_OK)
+        return TCL_ERROR;
+    if (n % 2) {
+        Tcl_SetObjResult(ip, Tcl_NewStringObj("coltypes must be a list of column/type pairs", -1));
         return TCL_ERROR;
     }
-    OradpiStmt *st = Oradpi_LookupStmt(ip, objv[1]);
-    if (!st)
-        return Oradpi_SetError(ip, NULL, -1, "invalid statement handle");
-    if (!st->stmt)
-        return Oradpi_SetError(ip, (OradpiBase *)st, -1, "statement is not prepared or connection closed");
-    if (Oradpi_StmtIsAsyncBusy(st))
-        return Oradpi_SetError(ip, (OradpiBase *)st, -1, "statement is busy (async operation in progress)");
+    for (Tcl_Size i = 0; i < n; i += 2) {
+        int kind;
+        if (Tcl_GetIndexFromObj(ip, elems[i + 1], colTypeNames, "column type", 0, &kind) != TCL_OK)
+            return TCL_ERROR;
+    }
+    return TCL_OK;
+}
 
-    static const char *const fetchOpts[] = {"-datavariable", "-dataarray", "-indexbyname", "-indexbynumber", "-command", "-max", "-resultvariable", "-returnrows", "-asdict", NULL};
-    enum FetchOptIdx { FOPT_DATAVAR, FOPT_DATAARRAY, FOPT_BYNAME, FOPT_BYNUMBER, FOPT_COMMAND, FOPT_MAX, FOPT_RESULTVAR, FOPT_RETURNROWS, FOPT_ASDICT };
+/* A key is a 0-based column position or a column name (case-insensitive,
+ * matched against the upper-cased names orafetch reports). */
+static int ColTypeColumn(Tcl_Obj *key, const OradpiFetchColMeta *meta, uint32_t numCols, uint32_t *colOut) {
+    Tcl_WideInt pos;
+    if (Tcl_GetWideIntFromObj(NULL, key, &pos) == TCL_OK) {
+        if (pos < 0 || pos >= (Tcl_WideInt)numCols)
+            return 0;
+        *colOut = (uint32_t)pos;
+        return 1;
+    }
+    Tcl_Size    klen = 0;
+    const char *k    = Tcl_GetStringFromObj(key, &klen);
+    Tcl_Obj    *want = upper_copy(k, (uint32_t)klen);
+    int         found = 0;
+    Tcl_IncrRefCount(want);
+    for (uint32_t c = 0; c < numCols && !found; c++) {
+        Tcl_Obj *have = upper_copy(meta[c].name, meta[c].nameLen);
+        Tcl_IncrRefCount(have);
+        if (strcmp(Tcl_GetString(have), Tcl_GetString(want)) == 0) {
+            *colOut = c;
+            found   = 1;
+        }
+        Tcl_DecrRefCount(have);
+    }
+    Tcl_DecrRefCount(want);
+    return found;
+}
 
-    for (Tcl_Size i = 2; i < objc; i++) {
-        int optIdx;
-        if (Tcl_GetIndexFromObj(ip, objv[i], fetchOpts, "option", 0, &optIdx) != TCL_OK)
+/* Rewrite meta[] so the define step requests the overridden native types,
+ * letting Oracle convert into the representation that is returned instead
+ * of converting each cell afterwards.  dateFmt[] receives the output form
+ * of each column.  Called before any cache state is allocated, so an
+ * unresolvable entry fails the fetch without leaving a partial cache. */
+static int ApplyColTypes(Tcl_Interp *ip, OradpiStmt *st, uint32_t numCols, OradpiFetchColMeta *meta, unsigned char *dateFmt) {
+    Tcl_Size  n     = 0;
+    Tcl_Obj **elems = NULL;
+    if (Tcl_ListObjGetElements(ip, st->colTypes, &n, &elems) != TCL_OK)
+        return TCL_ERROR;
+    for (Tcl_Size i = 0; i < n; i += 2) {
+        uint32_t c = 0;
+        int      kind;
+        if (Tcl_GetIndexFromObj(ip, elems[i + 1], colTypeNames, "column type", 0, &kind) != TCL_OK)
             return TCL_ERROR;
+        if (!ColTypeColumn(elems[i], meta, numCols, &c)) {
+            Tcl_SetObjResult(ip, Tcl_ObjPrintf("orafetch: coltypes column \"%s\" is not in the result set", Tcl_GetString(elems[i])));
+            return TCL_ERROR;
+        }
 
-        switch ((enum FetchOptIdx)optIdx) {
-        case FOPT_DATAVAR:
-            if (i + 1 >= objc) {
-                Tcl_WrongNumArgs(ip, 1, objv, "statement-handle ?options?");
-                return TCL_ERROR;
+        dpiOracleTypeNum otn     = meta[c].oracleTypeNum;
+        int              isNum   = (otn == DPI_ORACLE_TYPE_NUMBER);
+        int              isDate  = (otn == DPI_ORACLE_TYPE_DATE || otn == DPI_ORACLE_TYPE_TIMESTAMP || otn == DPI_ORACLE_TYPE_TIMESTAMP_TZ || otn == DPI_ORACLE_TYPE_TIMESTAMP_LTZ);
+        int              ok      = 1;
+        switch (kind) {
+        case COLTYPE_DEFAULT:
+            break;
+        case COLTYPE_INT64:
+        case COLTYPE_UINT64:
+        case COLTYPE_DOUBLE:
+            ok = isNum || (kind == COLTYPE_DOUBLE && (otn == DPI_ORACLE_TYPE_NATIVE_DOUBLE || otn == DPI_ORACLE_TYPE_NATIVE_FLOAT));
+            if (isNum) {
+                meta[c].defaultNativeTypeNum = (kind == COLTYPE_INT64) ? DPI_NATIVE_TYPE_INT64 : (kind == COLTYPE_UINT64) ? DPI_NATIVE_TYPE_UINT64 : DPI_NATIVE_TYPE_DOUBLE;
+                meta[c].isChar               = 0;
+                meta[c].numText              = 0;
             }
-            dataVar    = objv[++i];
-            returnRows = 0;
             break;
-        case FOPT_DATAARRAY:
-            if (i + 1 >= objc) {
-                Tcl_WrongNumArgs(ip, 1, objv, "statement-handle ?options?");
-                return TCL_ERROR;
+        case COLTYPE_STRING:
+            /* NUMBER as exact decimal text; dates as NLS-formatted text
+             * converted by the client library.  Character columns are
+             * already strings. */
+            if (isNum) {
+                meta[c].defaultNativeTypeNum = DPI_NATIVE_TYPE_BYTES;
+                meta[c].numText              = 0;
+            } else if (isDate) {
+                meta[c].oracleTypeNum        = DPI_ORACLE_TYPE_VARCHAR;
+                meta[c].defaultNativeTypeNum = DPI_NATIVE_TYPE_BYTES;
+                meta[c].clientSizeInBytes    = ORADPI_COLTYPE_TEXT_BYTES;
+            } else {
+                ok = meta[c].isChar;
             }
-            dataArray  = objv[++i];
-            returnRows = 0;
+            meta[c].isChar = 1;
             break;
-        case FOPT_BYNAME:
-            indexByName = 1;
-            returnRows  = 0;
-            break;
-        case FOPT_BYNUMBER:
-            indexByNumber = 1;
-            returnRows    = 0;
-            break;
-        case FOPT_COMMAND:
-            if (i + 1 >= objc) {
-                Tcl_WrongNumArgs(ip, 1, objv, "statement-handle ?options?");
-                return TCL_ERROR;
-            }
-            cmd        = objv[++i];
-            returnRows = 0;
-            break;
-        case FOPT_MAX:
-            if (i + 1 >= objc) {
-                Tcl_WrongNumArgs(ip, 1, objv, "statement-handle ?options?");
-                return TCL_ERROR;
-            }
-            if (Tcl_GetWideIntFromObj(ip, objv[++i], &maxRows) != TCL_OK)
-                return TCL_ERROR;
-            break;
-        case FOPT_RESULTVAR:
-            if (i + 1 >= objc) {
-                Tcl_WrongNumArgs(ip, 1, objv, "statement-handle ?options?");
-                return TCL_ERROR;
-            }
-            resultVar  = objv[++i];
-            returnRows = 0;
-            break;
-        case FOPT_RETURNROWS:
-            returnRows = 1;
-            break;
-        case FOPT_ASDICT:
-            asDict     = 1;
-            returnRows = 0;
+        case COLTYPE_ISO:
+        case COLTYPE_EPOCH:
+        case COLTYPE_EPOCHMICROS:
+        case COLTYPE_CLOCK:
+            ok         = isDate;
+            dateFmt[c] = (unsigned char)(ORADPI_DATEFMT_ISO + (kind - COLTYPE_ISO));
             break;
         }
+        if (!ok) {
+            Tcl_SetObjResult(ip, Tcl_ObjPrintf("orafetch: coltypes column \"%s\" cannot be fetched as %s", Tcl_GetString(elems[i]), colTypeNames[kind]));
+            return TCL_ERROR;
+        }
     }
+    return TCL_OK;
+}
 
-    if (maxRows < 0)
-        return Oradpi_SetError(ip, (OradpiBase *)st, -1, "orafetch: -max must be >= 0");
-    /* Default to single-row fetch only in plain status-code mode.
-     * When -command, -resultvar, or -returnrows is active, fetch all rows
-     * unless the caller explicitly provides -max.  Note: this means
-     * "orafetch $S -command {…}" on a large result set will iterate all
-     * rows — callers should use -max to limit if the table is large. */
-    if (!returnRows && !cmd && !resultVar && maxRows == 0)
-        maxRows = 1;
+/* ---- Adaptive fetch sizing ("fetchrows auto") ---- */
 
-    /* Column count is cached after the first fetch — skip the ODPI call
-     * and gate acquire/release on every subsequent invocation. */
-    if (st->fetchCacheNumCols > 0) {
-        numCols = st->fetchCacheNumCols;
-    } else {
-        CONN_GATE_ENTER(st->owner);
-        if (dpiStmt_getNumQueryColumns(st->stmt, &numCols) != DPI_SUCCESS) {
-            CONN_GATE_LEAVE(st->owner);
-            return Oradpi_SetErrorFromODPI(ip, (OradpiBase *)st, "dpiStmt_getNumQueryColumns");
-        }
-        CONN_GATE_LEAVE(st->owner);
+/* Estimated define-buffer bytes per row: ODPI-C keeps a dpiData plus
+ * indicator and length words per cell, and a clientSizeInBytes buffer for
+ * variable-length columns.  Fixed-size types are charged a flat 24 bytes
+ * (a NUMBER or DATE in OCI form, or a LOB locator pointer). */
+static uint32_t FetchAutoCap(const OradpiFetchColMeta *meta, uint32_t numCols, uint32_t budget) {
+    uint64_t rowBytes = 0;
+    for (uint32_t c = 0; c < numCols; c++)
+        rowBytes += sizeof(dpiData) + 8 + (meta[c].clientSizeInBytes ? meta[c].clientSizeInBytes : 24);
+    uint64_t rows = rowBytes ? budget / rowBytes : ORADPI_FETCHAUTO_MAX_ROWS;
+    if (rows < 1)
+        rows = 1;
+    if (rows > ORADPI_FETCHAUTO_MAX_ROWS)
+        rows = ORADPI_FETCHAUTO_MAX_ROWS;
+    return (uint32_t)rows;
+}
+
+/* dpiStmt_fetchRows for the interp-side loops; caller holds the gate.
+ * In auto mode a -max limited call narrows the ODPI array to the rows it
+ * will consume, so a lookup is served from the rows prefetched by the
+ * execute instead of costing a fetch round trip, and the array is restored
+ * afterwards (readahead and orafetchasync read it).  Each unlimited full
+ * batch is timed and steers fetchArray within [MIN_ROWS, fetchAutoCap]. */
+static int FetchRowsAdaptive(OradpiStmt *st, dpiStmt *fetchStmt, uint32_t batchLimit, uint32_t *batchStart, uint32_t *batchCount, int *moreRows) {
+    if (!st->fetchAuto || !st->fetchAutoCap)
+        return dpiStmt_fetchRows(fetchStmt, batchLimit, batchStart, batchCount, moreRows);
+
+    if (batchLimit < st->fetchArray) {
+        if (dpiStmt_setFetchArraySize(fetchStmt, batchLimit) != DPI_SUCCESS)
+            return DPI_FAILURE;
+        int rc = dpiStmt_fetchRows(fetchStmt, batchLimit, batchStart, batchCount, moreRows);
+        if (dpiStmt_setFetchArraySize(fetchStmt, st->fetchArray) != DPI_SUCCESS)
+            return DPI_FAILURE;
+        return rc;
     }
 
-    if (numCols == 0) {
-        Tcl_SetObjResult(ip, returnRows ? Tcl_NewListObj(0, NULL) : Tcl_NewIntObj(1403));
-        return TCL_OK;
+    Tcl_Time t0, t1;
+    Tcl_GetTime(&t0);
+    if (dpiStmt_fetchRows(fetchStmt, batchLimit, batchStart, batchCount, moreRows) != DPI_SUCCESS)
+        return DPI_FAILURE;
+    Tcl_GetTime(&t1);
+    if (*batchCount < batchLimit || !*moreRows)
+        return DPI_SUCCESS;
+
+    long long elapsedUs = (long long)(t1.sec - t0.sec) * 1000000LL + (t1.usec - t0.usec);
+    uint32_t  next      = st->fetchArray;
+    uint32_t  floor     = st->fetchAutoCap < ORADPI_FETCHAUTO_MIN_ROWS ? st->fetchAutoCap : ORADPI_FETCHAUTO_MIN_ROWS;
+    if (elapsedUs < ORADPI_FETCHAUTO_TARGET_US && next < st->fetchAutoCap)
+        next = (next > st->fetchAutoCap / 2) ? st->fetchAutoCap : next * 2;
+    else if (elapsedUs > 4LL * ORADPI_FETCHAUTO_TARGET_US && next > floor)
+        next = (next / 2 < floor) ? floor : next / 2;
+    if (next != st->fetchArray && dpiStmt_setFetchArraySize(fetchStmt, next) == DPI_SUCCESS)
+        st->fetchArray = next;
+    return DPI_SUCCESS;
+}
+
+/* LONG defines of LOB columns read values of any length; the first value
+ * in rows [start, start+count) longer than maxBytes fails the batch. */
+static const char *const lobOverflowMsg = "LOB value exceeds inlineLobMax bytes; raise inlineLobMax, or set it to 0 and read the value with oralob";
+
+static int LongLobOverflow(dpiData *const *varData, const unsigned char *longLob, uint32_t numCols, uint32_t maxBytes, uint32_t start, uint32_t count) {
+    for (uint32_t c = 0; c < numCols; c++) {
+        if (!longLob[c])
+            continue;
+        const dpiData *col = varData[c] + start;
+        for (uint32_t r = 0; r < count; r++)
+            if (!col[r].isNull && col[r].value.asBytes.length > maxBytes)
+                return 1;
     }
+    return 0;
+}
 
-    numColsSize = (Tcl_Size)numCols;
-    needNames   = (asDict || (dataArray && indexByName));
+/* Returns DPI_SUCCESS, DPI_FAILURE (ODPI error pending) or
+ * ORADPI_FETCH_LOBOVERFLOW; report failures with FetchRowsError. */
+#define ORADPI_FETCH_LOBOVERFLOW (-2)
 
-    /* Metadata cache check.  On the first orafetch after a parse the cache
-     * is empty (fetchCacheNumCols == 0); we snapshot column info from ODPI
-     * once and store it.  On every subsequent call we skip all ODPI
-     * round-trips, DString allocations (upper_copy), and Tcl_ObjPrintf
-     * calls and just IncrRefCount the already-built objects instead. */
-    if (st->fetchCacheNumCols != numCols) {
-        Oradpi_FreeFetchCache(st);
+static int FetchRowsLocked(OradpiStmt *st, dpiStmt *fetchStmt, uint32_t batchLimit, uint32_t *batchStart, uint32_t *batchCount, int *moreRows) {
+    if (FetchRowsAdaptive(st, fetchStmt, batchLimit, batchStart, batchCount, moreRows) != DPI_SUCCESS)
+        return DPI_FAILURE;
+    if (st->fetchLongLob && LongLobOverflow(st->fetchVarData, st->fetchLongLob, st->fetchCacheNumCols, st->fetchLobMax, *batchStart, *batchCount))
+        return ORADPI_FETCH_LOBOVERFLOW;
+    return DPI_SUCCESS;
+}
 
-        if (Oradpi_CheckedAllocBytes(ip, numColsSize, sizeof(*meta), &metaBytes, "column metadata snapshot") != TCL_OK) {
-            code = TCL_ERROR;
-            goto cleanup;
-        }
-        meta = (OradpiFetchColMeta *)Tcl_Alloc(metaBytes);
-        memset(meta, 0, metaBytes);
-        if (SnapshotColumnMeta(ip, st, numCols, meta) != TCL_OK) {
-            code = TCL_ERROR;
-            goto cleanup;
-        }
+static int FetchRowsError(Tcl_Interp *ip, OradpiStmt *st, int rc) {
+    if (rc == ORADPI_FETCH_LOBOVERFLOW)
+        return Oradpi_SetError(ip, (OradpiBase *)st, -1, lobOverflowMsg);
+    return Oradpi_SetErrorFromODPI(ip, (OradpiBase *)st, "dpiStmt_fetchRows");
+}
 
-        st->fetchIsChar     = (int *)Tcl_Alloc(numCols * sizeof(int));
-        st->fetchColNames   = (Tcl_Obj **)Tcl_Alloc(numCols * sizeof(Tcl_Obj *));
-        st->fetchNumberKeys = (Tcl_Obj **)Tcl_Alloc(numCols * sizeof(Tcl_Obj *));
-        memset(st->fetchColNames, 0, numCols * sizeof(Tcl_Obj *));
-        memset(st->fetchNumberKeys, 0, numCols * sizeof(Tcl_Obj *));
+/* Column-major drain for orafetch -columns.  Each batch returned by
+ * dpiStmt_fetchRows is walked one define buffer at a time, appending to the
+ * per-column lists.  No script or variable trace runs inside this loop, so
+ * the statement cannot be closed underneath it and the per-row liveness
+ * checks of the row-oriented loop are unnecessary.  With -packed, columns
+ * whose packKind is set are encoded by PackColumnBatch instead. */
+static int FetchColumnsBatched(Tcl_Interp *ip, OradpiStmt *st, dpiStmt *fetchStmt, GlobalConnRec *shared, int inlineLobs, uint32_t numCols, Tcl_WideInt maxRows, const unsigned char *dateFmts, Tcl_Obj **colLists,
+                               const unsigned char *packKind, Tcl_Obj **colNulls, uint64_t *fetchedOut) {
+    dpiData         **varData     = st->fetchVarData;
+    dpiNativeTypeNum *nativeTypes = st->fetchNativeTypes;
+    uint64_t          fetched     = 0;
+    int               moreRows    = 1;
+
+    *fetchedOut = 0;
+    while (moreRows && (maxRows == 0 || (Tcl_WideInt)fetched < maxRows)) {
+        uint32_t batchStart = 0, batchCount = 0;
+        uint32_t batchLimit = st->fetchArray;
+        if (maxRows > 0 && maxRows - (Tcl_WideInt)fetched < (Tcl_WideInt)batchLimit)
+            batchLimit = (uint32_t)(maxRows - (Tcl_WideInt)fetched);
+
+        Oradpi_SharedConnGateEnter(shared);
+        int fetchRc = FetchRowsLocked(st, fetchStmt, batchLimit, &batchStart, &batchCount, &moreRows);
+        if (fetchRc != DPI_SUCCESS) {
+            Oradpi_SharedConnGateLeave(shared);
+            return FetchRowsError(ip, st, fetchRc);
+        }
+        Oradpi_SharedConnGateLeave(shared);
+        if (batchCount == 0)
+            break;
 
         for (uint32_t c = 0; c < numCols; c++) {
-            st->fetchIsChar[c]   = meta[c].isChar;
-            st->fetchColNames[c] = meta[c].nameLen ? upper_copy(meta[c].name, meta[c].nameLen) : Tcl_NewStringObj("", 0);
-            Tcl_IncrRefCount(st->fetchColNames[c]);
-            st->fetchNumberKeys[c] = Tcl_ObjPrintf("%u", c);
-            Tcl_IncrRefCount(st->fetchNumberKeys[c]);
-        }
-        st->fetchCacheNumCols = numCols;
-
-        /* Build per-column output variable cache to eliminate N
-         * dpiStmt_getQueryValue calls per row.  Done before FreeFetchMeta so
-         * meta[c] type fields are still valid.  Object columns need a
-         * dpiObjectType* unavailable here; any failure falls back to
-         * dpiStmt_getQueryValue for the entire statement. */
-        st->fetchVars         = (dpiVar **)Tcl_Alloc(numCols * sizeof(dpiVar *));
-        st->fetchVarData      = (dpiData **)Tcl_Alloc(numCols * sizeof(dpiData *));
-        st->fetchNativeTypes  = (dpiNativeTypeNum *)Tcl_Alloc(numCols * sizeof(dpiNativeTypeNum));
-        memset(st->fetchVars, 0, numCols * sizeof(dpiVar *));
-        memset(st->fetchVarData, 0, numCols * sizeof(dpiData *));
-
-        int varBuildOk = 1;
-        CONN_GATE_ENTER(st->owner);
-        for (uint32_t c = 0; c < numCols; c++) {
-            dpiVar  *var  = NULL;
-            dpiData *data = NULL;
-            if (meta[c].oracleTypeNum == DPI_ORACLE_TYPE_OBJECT) {
-                varBuildOk = 0;
-                break;
-            }
-            /* clientSizeInBytes is measured in bytes; pass sizeIsBytes=1 for
-             * variable-length char/raw types.  For fixed-size types (NUMBER,
-             * DATE, LOB, etc.) size is ignored by ODPI-C so both 0 and 1 are
-             * safe — use 0 to be explicit. */
-            int sizeIsBytes = (meta[c].clientSizeInBytes > 0) ? 1 : 0;
-            if (dpiConn_newVar(st->owner->conn, meta[c].oracleTypeNum, meta[c].defaultNativeTypeNum, st->fetchArray, meta[c].clientSizeInBytes, sizeIsBytes, 0, NULL, &var, &data) != DPI_SUCCESS) {
-                varBuildOk = 0;
-                break;
+            dpiData *col = varData[c] + batchStart;
+            if (packKind && packKind[c] != PACK_NONE) {
+                if (PackColumnBatch(ip, packKind[c], nativeTypes[c], col, batchCount, fetched, colLists[c], colNulls[c]) != TCL_OK)
+                    return TCL_ERROR;
+                continue;
             }
-            if (dpiStmt_define(st->stmt, c + 1, var) != DPI_SUCCESS) {
-                dpiVar_release(var);
-                varBuildOk = 0;
-                break;
+            for (uint32_t r = 0; r < batchCount; r++) {
+                Tcl_Obj *v;
+                if (nativeTypes[c] == DPI_NATIVE_TYPE_LOB) {
+                    OradpiFetchCell cell;
+                    const char     *where = NULL;
+                    const char     *msg   = NULL;
+                    Oradpi_SharedConnGateEnter(shared);
+                    int rc = SnapshotCellLocked(inlineLobs, nativeTypes[c], &col[r], st->fetchIsChar[c], &cell, &where, &msg);
+                    Oradpi_SharedConnGateLeave(shared);
+                    if (rc != TCL_OK) {
+                        FreeFetchCells(&cell, 1, shared);
+                        if (where)
+                            return Oradpi_SetErrorFromODPI(ip, (OradpiBase *)st, where);
+                        Tcl_SetObjResult(ip, Tcl_NewStringObj(msg ? msg : "failed to snapshot fetched value", -1));
+                        return TCL_ERROR;
+                    }
+                    v = SnapshotCellToObj(ip, shared, &cell, DateFmtAt(dateFmts, c));
+                    FreeFetchCells(&cell, 1, shared);
+                } else {
+                    v = ColumnValueObj(ip, st, c, nativeTypes[c], &col[r], DateFmtAt(dateFmts, c));
+                    if (!v) {
+                        Tcl_SetObjResult(ip, Tcl_NewStringObj("fetched byte value is too large", -1));
+                        return TCL_ERROR;
+                    }
+                }
+                LAPPEND_CHK(ip, colLists[c], v);
             }
-            st->fetchVars[c]        = var;
-            st->fetchVarData[c]     = data;
-            st->fetchNativeTypes[c] = meta[c].defaultNativeTypeNum;
         }
-        CONN_GATE_LEAVE(st->owner);
-
-        if (!varBuildOk) {
-            for (uint32_t c = 0; c < numCols; c++)
-                if (st->fetchVars[c])
-                    dpiVar_release(st->fetchVars[c]);
-            Tcl_Free((char *)st->fetchVars);
-            st->fetchVars = NULL;
-            Tcl_Free((char *)st->fetchVarData);
-            st->fetchVarData = NULL;
-            Tcl_Free((char *)st->fetchNativeTypes);
-            st->fetchNativeTypes = NULL;
-        }
-
-        /* Compute LOB flag from the isChar/oracle-type metadata.
-         * Checked once here; the fast path uses it to decide whether the
-         * connection gate is needed per row. */
-        int hasLob = 0;
-        for (uint32_t c = 0; c < numCols && !hasLob; c++)
-            if (meta[c].defaultNativeTypeNum == DPI_NATIVE_TYPE_LOB)
-                hasLob = 1;
-        st->fetchHasLobCols = hasLob;
-
-        /* meta name copies served only to build the cache; free them now. */
-        FreeFetchMeta(meta, numColsSize);
-        meta = NULL;
+        fetched += batchCount;
     }
+    *fetchedOut = fetched;
+    return TCL_OK;
+}
 
-    if (needNames) {
-        if (Oradpi_CheckedAllocBytes(ip, numColsSize, sizeof(Tcl_Obj *), &colNameBytes, "column name array") != TCL_OK) {
-            code = TCL_ERROR;
-            goto cleanup;
-        }
-        colNames = (Tcl_Obj **)Tcl_Alloc(colNameBytes);
-        for (uint32_t c = 0; c < numCols; c++) {
-            colNames[c] = st->fetchColNames[c];
-            Tcl_IncrRefCount(colNames[c]);
-        }
-    }
+/* ==========================================================================
+ * Scrollable cursors
+ *
+ * "oraparse -scrollable" prepares a scrollable cursor and "orafetch
+ * -position" moves it with dpiStmt_scroll before the usual fetch paths
+ * run.  Row lists fetched from a scrollable statement are also kept in a
+ * bounded window of converted rows, so a -returnrows/-resultvariable page
+ * that lies inside it is answered without a round trip or conversion;
+ * the cursor then catches up (scrollNext) on the next fetch that reads.
+ * ========================================================================== */
 
-    if (Oradpi_CheckedAllocBytes(ip, numColsSize, sizeof(Tcl_Obj *), &colValBytes, "fetched row value array") != TCL_OK) {
-        code = TCL_ERROR;
-        goto cleanup;
+enum { SCROLL_ABSOLUTE, SCROLL_RELATIVE, SCROLL_FIRST, SCROLL_LAST };
+static const char *const scrollModeNames[] = {"absolute", "relative", "first", "last", NULL};
+
+static void ScrollWindowDrop(OradpiStmt *s) {
+    if (s->scrollWin) {
+        Tcl_DecrRefCount(s->scrollWin);
+        s->scrollWin = NULL;
     }
-    colVals = (Tcl_Obj **)Tcl_Alloc(colValBytes);
-    memset(colVals, 0, colValBytes);
+    s->scrollNext = 0;
+}
 
-    if (dataArray && indexByNumber) {
-        size_t keyBytes = 0;
-        if (Oradpi_CheckedAllocBytes(ip, numColsSize, sizeof(Tcl_Obj *), &keyBytes, "numeric column keys") != TCL_OK) {
-            code = TCL_ERROR;
-            goto cleanup;
-        }
-        numberKeys = (Tcl_Obj **)Tcl_Alloc(keyBytes);
-        for (uint32_t c = 0; c < numCols; c++) {
-            numberKeys[c] = st->fetchNumberKeys[c];
-            Tcl_IncrRefCount(numberKeys[c]);
+/* Window rows are only interchangeable between calls that build rows the
+ * same way. */
+static int ScrollShape(int asDict, int dateFormat) {
+    return (dateFormat << 1) | (asDict != 0);
+}
+
+/* 1-based row a -position request starts from: 0 for "last", which only
+ * the server can resolve, and -1 when it lies before the first row.
+ * "relative" counts from the last row returned (0 returns it again). */
+static int ScrollTarget(Tcl_Interp *ip, OradpiStmt *st, int mode, Tcl_WideInt offset, Tcl_WideInt *target) {
+    uint64_t consumed = 0;
+    switch (mode) {
+    case SCROLL_ABSOLUTE:
+        *target = offset;
+        break;
+    case SCROLL_RELATIVE:
+        if (st->scrollNext) {
+            consumed = st->scrollNext - 1;
+        } else {
+            CONN_GATE_ENTER(st->owner);
+            if (dpiStmt_getRowCount(st->stmt, &consumed) != DPI_SUCCESS) {
+                CONN_GATE_LEAVE(st->owner);
+                return Oradpi_SetErrorFromODPI(ip, (OradpiBase *)st, "dpiStmt_getRowCount");
+            }
+            CONN_GATE_LEAVE(st->owner);
         }
+        *target = (Tcl_WideInt)consumed + offset;
+        break;
+    case SCROLL_FIRST:
+        *target = 1;
+        break;
+    default:
+        *target = 0;
+        return TCL_OK;
     }
+    if (*target < 1)
+        *target = -1;
+    return TCL_OK;
+}
 
-    if (returnRows || resultVar) {
-        rowsList = Tcl_NewListObj(0, NULL);
-        Tcl_IncrRefCount(rowsList);
+/* Position the cursor so the next fetch returns row target (0 = the last
+ * row).  A row outside the result set sets *outside rather than failing,
+ * so paging past either end simply returns no rows. */
+static int ScrollTo(Tcl_Interp *ip, OradpiStmt *st, Tcl_WideInt target, int *outside) {
+    *outside = 0;
+    if (target > INT32_MAX)
+        return Oradpi_SetError(ip, (OradpiBase *)st, -1, "orafetch: -position is beyond the scrollable range");
+    CONN_GATE_ENTER(st->owner);
+    if (dpiStmt_scroll(st->stmt, target ? DPI_MODE_FETCH_ABSOLUTE : DPI_MODE_FETCH_LAST, (int32_t)target, 0) != DPI_SUCCESS) {
+        CONN_GATE_LEAVE(st->owner);
+        dpiErrorInfo ei;
+        if (!Oradpi_CaptureODPIError(&ei))
+            return Oradpi_SetError(ip, (OradpiBase *)st, -1, "dpiStmt_scroll");
+        if (ei.message && strncmp(ei.message, "DPI-1027", 8) == 0) {
+            *outside = 1;
+            return TCL_OK;
+        }
+        return Oradpi_SetErrorFromODPIInfo(ip, (OradpiBase *)st, "dpiStmt_scroll", &ei);
     }
+    CONN_GATE_LEAVE(st->owner);
+    return TCL_OK;
+}
 
-    if (Oradpi_CheckedAllocBytes(ip, numColsSize, sizeof(*cells), &cellBytes, "fetched row snapshot array") != TCL_OK) {
-        code = TCL_ERROR;
-        goto cleanup;
+/* Rows [target, target + count) from the window, or NULL unless all of
+ * them are there. */
+static Tcl_Obj *ScrollWindowGet(OradpiStmt *st, int shape, Tcl_WideInt target, Tcl_WideInt count) {
+    Tcl_Size  len   = 0;
+    Tcl_Obj **elems = NULL;
+    if (!st->scrollWin || st->scrollWinShape != shape || target < 1 || count < 1)
+        return NULL;
+    if (Tcl_ListObjGetElements(NULL, st->scrollWin, &len, &elems) != TCL_OK)
+        return NULL;
+    uint64_t first = (uint64_t)target;
+    if (first < st->scrollWinFirst || first - st->scrollWinFirst + (uint64_t)count > (uint64_t)len)
+        return NULL;
+    return Tcl_NewListObj((Tcl_Size)count, elems + (first - st->scrollWinFirst));
+}
+
+/* Record rows fetched from row first on.  Rows adjoining the window on
+ * either side extend it, anything else replaces it; the end away from the
+ * new rows is trimmed to ORADPI_SCROLL_WINDOW_ROWS. */
+static void ScrollWindowPut(OradpiStmt *st, int shape, uint64_t first, Tcl_Obj *rows) {
+    Tcl_Size  n     = 0;
+    Tcl_Obj **elems = NULL;
+    if (Tcl_ListObjGetElements(NULL, rows, &n, &elems) != TCL_OK || n == 0)
+        return;
+    Tcl_Obj *win = st->scrollWin;
+    Tcl_Size len = 0;
+    if (win && (st->scrollWinShape != shape || Tcl_ListObjLength(NULL, win, &len) != TCL_OK))
+        len = -1;
+    int atEnd = 1;
+    if (win && len >= 0 && first == st->scrollWinFirst + (uint64_t)len) {
+        atEnd = 1;
+    } else if (win && len >= 0 && first + (uint64_t)n == st->scrollWinFirst) {
+        atEnd = 0;
+    } else {
+        if (win)
+            Tcl_DecrRefCount(win);
+        st->scrollWin = NULL;
+        if (n > ORADPI_SCROLL_WINDOW_ROWS)
+            return;
+        st->scrollWin      = rows;
+        st->scrollWinFirst = first;
+        st->scrollWinShape = shape;
+        Tcl_IncrRefCount(rows);
+        return;
     }
-    cells = (OradpiFetchCell *)Tcl_Alloc(cellBytes);
-    memset(cells, 0, cellBytes);
+    /* The window may also be a list the script holds; copy before
+     * extending it. */
+    if (Tcl_IsShared(win)) {
+        Tcl_Obj *dup = Tcl_DuplicateObj(win);
+        Tcl_IncrRefCount(dup);
+        Tcl_DecrRefCount(win);
+        win           = dup;
+        st->scrollWin = win;
+    }
+    (void)Tcl_ListObjReplace(NULL, win, atEnd ? len : 0, 0, n, elems);
+    if (!atEnd)
+        st->scrollWinFirst = first;
+    len += n;
+    if (len > ORADPI_SCROLL_WINDOW_ROWS) {
+        Tcl_Size drop = len - ORADPI_SCROLL_WINDOW_ROWS;
+        if (atEnd) {
+            (void)Tcl_ListObjReplace(NULL, win, 0, drop, 0, NULL);
+            st->scrollWinFirst += (uint64_t)drop;
+        } else {
+            (void)Tcl_ListObjReplace(NULL, win, ORADPI_SCROLL_WINDOW_ROWS, drop, 0, NULL);
+        }
+    }
+}
 
-    /* Snapshot dpiStmt* and GlobalConnRec* with addRef to hold
-     * independent lifetime references during the fetch loop.  Callbacks
-     * (-command) and variable traces (-datavariable, -dataarray,
-     * -resultvariable) are reentrancy points where Tcl can legally call
-     * oraclose or oralogoff, freeing the statement and connection wrappers
-     * while the C function is still using them.
-     *
-     * With these holds, the underlying ODPI resources survive the loop
-     * even if the Tcl-level wrappers are destroyed.  After each reentrancy
-     * point, we verify liveness by checking if the statement is still
-     * registered in the interp; if not, we break cleanly. */
-    fetchStmt       = st->stmt;
-    fetchShared     = st->owner ? st->owner->shared : NULL;
-    fetchInlineLobs = st->owner ? st->owner->inlineLobs : 0;
-    stmtNameSnap    = st->base.name;
+/* A published query result (see "Result cache" below).  The rows are
+ * immutable once listed; every statement serving them holds a reference. */
+typedef struct OradpiResultCacheEntry {
+    Tcl_HashEntry   *hashEntry; /* NULL once unlisted */
+    int              refCount;  /* table + serving statements */
+    uint32_t         numCols;
+    uint32_t         numRows;
+    OradpiFetchCell *cells;
+    Tcl_WideInt      createdMs;
+    Tcl_WideInt      expiresMs;
+    size_t           bytes;    /* counted against ORADPI_RESULTCACHE_BYTES */
+    uint64_t         subscrId; /* 0: TTL only */
+    uint64_t         queryId;
+} OradpiResultCacheEntry;
 
-    if (dpiStmt_addRef(fetchStmt) != DPI_SUCCESS) {
-        code        = Oradpi_SetErrorFromODPI(ip, (OradpiBase *)st, "dpiStmt_addRef (fetch hold)");
-        fetchStmt   = NULL; /* prevent cleanup from releasing a ref we never took */
-        fetchShared = NULL;
-        goto cleanup;
-    }
-    if (fetchShared)
-        Oradpi_SharedConnAddRef(fetchShared);
-    Tcl_IncrRefCount(stmtNameSnap);
+struct OradpiReadahead;
+static void ResultCacheRelease(OradpiResultCacheEntry *e);
+static void ResultCacheUnlist(OradpiResultCacheEntry *e);
+static void ResultCacheForget(OradpiStmt *s);
+static void ResultCachePublish(struct OradpiReadahead *ra);
 
-    /* =========================================================================
-     * Fetch loop — two paths share the same reentrancy zone:
-     *
-     *   Fast path (when st->fetchVarData != NULL):
-     *     dpiStmt_fetchRows drains the ODPI buffer in one call per batch;
-     *     per-row values come from direct dpiData[] buffer access — zero
-     *     dpiStmt_getQueryValue ODPI calls in the hot inner loop.
-     *     The gate is acquired once per batch (not per row), reducing lock
-     *     contention against async workers or adopted-connection threads.
-     *
-     *   Fallback (st->fetchVarData == NULL):
-     *     Original dpiStmt_fetch + dpiStmt_getQueryValue per row.
-     *     Used when var creation failed (e.g. object-type columns).
-     * ========================================================================= */
-    if (st->fetchVarData) {
-        /* ------------------------------------------------------------------
-         * FAST PATH
-         * ------------------------------------------------------------------ */
-        int               moreRows   = 1;
-        uint32_t          batchStart = 0, batchCount = 0, batchPos = 0;
-        /* Snapshot cache pointers before reentrancy so callbacks that change
-         * fetch settings (orastmt -fetchrows) cannot cause UAF — fetchDead
-         * is checked at the top of every iteration. */
-        dpiData         **varData     = st->fetchVarData;
-        dpiNativeTypeNum *nativeTypes = st->fetchNativeTypes;
+/* ==========================================================================
+ * Readahead
+ *
+ * With "oraconfig $S readahead 1", batches are fetched on a pool worker:
+ * the worker calls dpiStmt_fetchRows under the connection gate and
+ * snapshots the rows out of the define buffers into OradpiFetchCell
+ * arrays (no Tcl_Obj, per the worker contract).  As soon as orafetch takes
+ * a batch it queues the next one, so the network round trip overlaps with
+ * Tcl object construction.  The interp thread never reads the define
+ * buffers while readahead is active.  Rows left over by -max are kept
+ * for the next orafetch call.
+ * ========================================================================== */
 
-        for (;;) {
-            if (fetchDead) {
-                Tcl_SetObjResult(ip, Tcl_NewStringObj("orafetch: statement closed during callback", -1));
-                code = TCL_ERROR;
-                goto cleanup;
-            }
+typedef struct OradpiReadahead {
+    Tcl_Mutex         lock;
+    Tcl_Condition     cond;
+    int               refCount;  /* statement + active fetch loop + queued job */
+    int               pending;   /* a worker job is queued or running */
+    int               discarded; /* detached from its statement */
 
-            /* Drain the next batch when the current one is exhausted.
-             * Pass maxRows (when limited) rather than fetchArray so ODPI-C
-             * advances bufferRowIndex by at most the number of rows this call
-             * will consume.  Without this, a fetchArray-sized advance discards
-             * unprocessed buffered rows when the caller uses -max N < fetchArray
-             * across multiple orafetch calls. */
-            uint32_t batchLimit = (maxRows > 0 && maxRows < (Tcl_WideInt)st->fetchArray) ? (uint32_t)maxRows : st->fetchArray;
-            if (batchPos >= batchCount) {
-                if (!moreRows)
-                    break;
+    dpiStmt          *stmt;   /* addRef'd */
+    GlobalConnRec    *shared; /* SharedConnAddRef'd */
+    uint32_t          numCols;
+    uint32_t          fetchArray;
+    dpiData         **varData;     /* [numCols] copy of the buffer pointers */
+    dpiNativeTypeNum *nativeTypes; /* [numCols] */
+    int              *isChar;      /* [numCols] */
+    unsigned char    *longLob;     /* [numCols] or NULL; see fetchLongLob */
+    uint32_t          lobMax;
 
-                /* The gate is held only for the duration of one batch fetch
-                 * (which may trigger a network round-trip), then released
-                 * before processing any rows.  This allows async workers and
-                 * adopted-connection threads to acquire the gate between
-                 * batches. */
-                Oradpi_SharedConnGateEnter(fetchShared);
-                if (dpiStmt_fetchRows(fetchStmt, batchLimit, &batchStart, &batchCount, &moreRows) != DPI_SUCCESS) {
-                    Oradpi_SharedConnGateLeave(fetchShared);
-                    code = Oradpi_SetErrorFromODPI(ip, (OradpiBase *)st, "dpiStmt_fetchRows");
-                    goto cleanup;
-                }
-                Oradpi_SharedConnGateLeave(fetchShared);
+    /* Produced by the worker; read once pending drops to 0. */
+    OradpiFetchCell  *nextCells;
+    uint32_t          nextRows;
+    int               nextMore;
+    int               nextFailed;
+    int               nextErrCode;
+    char             *nextErrMsg;
 
-                if (batchCount == 0)
-                    break;
-                batchPos = 0;
-            }
+    /* Batch being consumed on the interp thread. */
+    OradpiFetchCell  *curCells;
+    uint32_t          curRows;
+    uint32_t          curPos;
+    int               more; /* the cursor may have rows beyond curCells */
 
-            uint32_t    rowIdx        = batchStart + batchPos++;
-            const char *snapshotWhere = NULL;
-            const char *snapshotMsg   = NULL;
+    /* Result cache.  A cached readahead serves an entry's rows (borrowed,
+     * no statement or worker); otherwise consumed batches are kept in
+     * fillCells while the result is small enough to publish under fillKey. */
+    OradpiResultCacheEntry *cached;
+    char                   *fillKey;
+    uint32_t                fillTtl;
+    OradpiFetchCell        *fillCells;
+    uint32_t                fillRows;
+    size_t                  fillBytes;
+    uint64_t                fillSubscrId; /* registration of the fill, see OradpiStmt */
+    uint64_t                fillQueryId;
+    uint64_t                fillChangeSeq;
+} OradpiReadahead;
 
-            memset(colVals, 0, colValBytes);
-            FreeFetchCells(cells, numColsSize, fetchShared);
-            memset(cells, 0, cellBytes);
+static void ReadaheadDropFill(OradpiReadahead *ra) {
+    if (ra->fillCells) {
+        FreeFetchCells(ra->fillCells, (Tcl_Size)ra->fillRows * ra->numCols, ra->shared);
+        Tcl_Free((char *)ra->fillCells);
+    }
+    if (ra->fillKey)
+        Tcl_Free(ra->fillKey);
+    ra->fillCells = NULL;
+    ra->fillRows  = 0;
+    ra->fillBytes = 0;
+    ra->fillKey   = NULL;
+}
 
-            /* Snapshot directly from pre-defined var buffers without
-             * dpiStmt_getQueryValue calls.  For scalar-only queries
-             * (fetchHasLobCols == 0), SnapshotCellLocked does only pure
-             * struct copies with no ODPI calls, so the connection gate is
-             * unnecessary.  Skipping it eliminates per-row lock contention
-             * when multiple interpreters share one session.  For LOB queries
-             * the gate is still needed for dpiLob_addRef. */
-            int needGate = st->fetchHasLobCols;
-            if (needGate)
-                Oradpi_SharedConnGateEnter(fetchShared);
+static void ReadaheadFree(OradpiReadahead *ra) {
+    if (ra->cached)
+        ResultCacheRelease(ra->cached);
+    else if (ra->curCells) {
+        FreeFetchCells(ra->curCells, (Tcl_Size)ra->curRows * ra->numCols, ra->shared);
+        Tcl_Free((char *)ra->curCells);
+    }
+    ReadaheadDropFill(ra);
+    if (ra->nextCells) {
+        FreeFetchCells(ra->nextCells, (Tcl_Size)ra->nextRows * ra->numCols, ra->shared);
+        Tcl_Free((char *)ra->nextCells);
+    }
+    if (ra->nextErrMsg)
+        Tcl_Free(ra->nextErrMsg);
+    Tcl_Free((char *)ra->varData);
+    Tcl_Free((char *)ra->nativeTypes);
+    Tcl_Free((char *)ra->isChar);
+    if (ra->longLob)
+        Tcl_Free((char *)ra->longLob);
+    if (ra->stmt)
+        dpiStmt_release(ra->stmt);
+    if (ra->shared)
+        Oradpi_SharedConnRelease(ra->shared);
+    Tcl_ConditionFinalize(&ra->cond);
+    Tcl_MutexFinalize(&ra->lock);
+    Tcl_Free((char *)ra);
+}
+
+static void ReadaheadRelease(OradpiReadahead *ra) {
+    Tcl_MutexLock(&ra->lock);
+    int doFree = (--ra->refCount == 0);
+    Tcl_MutexUnlock(&ra->lock);
+    if (doFree)
+        ReadaheadFree(ra);
+}
+
+/* Worker body.  Follows the worker contract in cmd_int.h. */
+static void ReadaheadJob(void *clientData, int canceled) {
+    OradpiReadahead *ra      = (OradpiReadahead *)clientData;
+    OradpiFetchCell *cells   = NULL;
+    uint32_t         rows    = 0;
+    int              more    = 0;
+    int              failed  = 0;
+    int              errCode = 0;
+    char            *errMsg  = NULL;
+    const char      *msg     = NULL;
+
+    Tcl_MutexLock(&ra->lock);
+    int skip = canceled || ra->discarded;
+    Tcl_MutexUnlock(&ra->lock);
+
+    if (skip) {
+        failed = 1;
+        msg    = "readahead fetch canceled";
+    } else {
+        uint32_t start = 0;
+        Oradpi_SharedConnGateEnter(ra->shared);
+        if (dpiStmt_fetchRows(ra->stmt, ra->fetchArray, &start, &rows, &more) != DPI_SUCCESS) {
+            dpiErrorInfo ei;
+            memset(&ei, 0, sizeof(ei));
+            (void)Oradpi_CaptureODPIError(&ei);
+            failed  = 1;
+            errCode = (int)ei.code;
+            rows    = 0;
+            if (ei.message && ei.messageLength > 0) {
+                errMsg = (char *)Tcl_Alloc((size_t)ei.messageLength + 1);
+                memcpy(errMsg, ei.message, ei.messageLength);
+                errMsg[ei.messageLength] = '\0';
+            } else
+                msg = "dpiStmt_fetchRows failed";
+        } else if (ra->longLob && LongLobOverflow(ra->varData, ra->longLob, ra->numCols, ra->lobMax, start, rows)) {
+            failed = 1;
+            rows   = 0;
+            msg    = lobOverflowMsg;
+        } else if (rows > 0) {
+            size_t cellBytes = 0;
+            if (Oradpi_CheckedAllocBytes(NULL, (Tcl_Size)rows * ra->numCols, sizeof(OradpiFetchCell), &cellBytes, NULL) != TCL_OK) {
+                failed = 1;
+                msg    = "readahead batch is too large";
+            } else {
+                cells = (OradpiFetchCell *)Tcl_Alloc(cellBytes);
+                memset(cells, 0, cellBytes);
+                for (uint32_t r = 0; r < rows && !failed; r++) {
+                    for (uint32_t c = 0; c < ra->numCols; c++) {
+                        const char *where = NULL;
+                        if (SnapshotCellLocked(0, ra->nativeTypes[c], &ra->varData[c][start + r], ra->isChar[c], &cells[(size_t)r * ra->numCols + c], &where, &msg) != TCL_OK) {
+                            failed = 1;
+                            if (!msg)
+                                msg = "failed to snapshot fetched value";
+                            break;
+                        }
+                    }
+                }
+            }
+        }
+        Oradpi_SharedConnGateLeave(ra->shared);
+    }
+
+    if (failed && cells) {
+        FreeFetchCells(cells, (Tcl_Size)rows * ra->numCols, NULL);
+        Tcl_Free((char *)cells);
+        cells = NULL;
+        rows  = 0;
+    }
+    if (failed && !errMsg && msg) {
+        size_t n = strlen(msg);
+        errMsg   = (char *)Tcl_Alloc(n + 1);
+        memcpy(errMsg, msg, n + 1);
+    }
+
+    Tcl_MutexLock(&ra->lock);
+    ra->nextCells   = cells;
+    ra->nextRows    = rows;
+    ra->nextMore    = more;
+    ra->nextFailed  = failed;
+    ra->nextErrCode = errCode;
+    ra->nextErrMsg  = errMsg;
+    ra->pending     = 0;
+    Tcl_ConditionNotify(&ra->cond);
+    int doFree = (--ra->refCount == 0);
+    Tcl_MutexUnlock(&ra->lock);
+    if (doFree)
+        ReadaheadFree(ra);
+}
+
+static int ReadaheadSubmit(OradpiReadahead *ra) {
+    Tcl_MutexLock(&ra->lock);
+    ra->pending = 1;
+    ra->refCount++;
+    Tcl_MutexUnlock(&ra->lock);
+    if (Oradpi_PoolSubmit(ReadaheadJob, ra) != TCL_OK) {
+        Tcl_MutexLock(&ra->lock);
+        ra->pending = 0;
+        ra->refCount--; /* the statement still holds a reference */
+        Tcl_MutexUnlock(&ra->lock);
+        return TCL_ERROR;
+    }
+    return TCL_OK;
+}
+
+/* Serve the statement's result cache hit: the whole result is one
+ * batch of borrowed cells, and the entry reference moves to the readahead. */
+static OradpiReadahead *ReadaheadFromCache(OradpiStmt *st) {
+    OradpiResultCacheEntry *e  = st->rcHit;
+    OradpiReadahead        *ra = (OradpiReadahead *)Tcl_Alloc(sizeof(*ra));
+    memset(ra, 0, sizeof(*ra));
+    ra->refCount = 1; /* st->ra */
+    ra->numCols  = e->numCols;
+    ra->cached   = e;
+    ra->curCells = e->cells;
+    ra->curRows  = e->numRows;
+    st->rcHit    = NULL;
+    st->ra       = ra;
+    return ra;
+}
+
+/* Return the readahead state for st, creating it on first use.  NULL when
+ * readahead is off or not applicable: it needs the define buffers, and
+ * LOB columns are excluded because their snapshots take LOB references.
+ * A result being cached always goes through readahead so that its
+ * batches can be kept. */
+static OradpiReadahead *ReadaheadEnsure(OradpiStmt *st) {
+    if (st->ra)
+        return st->ra;
+    if (st->rcHit)
+        return ReadaheadFromCache(st);
+    if ((!st->readahead && !st->rcKey) || st->scrollable || !st->fetchVarData || st->fetchHasLobCols || !st->owner || !st->owner->shared)
+        return NULL;
+    if (dpiStmt_addRef(st->stmt) != DPI_SUCCESS)
+        return NULL;
+
+    uint32_t         n  = st->fetchCacheNumCols;
+    OradpiReadahead *ra = (OradpiReadahead *)Tcl_Alloc(sizeof(*ra));
+    memset(ra, 0, sizeof(*ra));
+    ra->refCount    = 1; /* st->ra */
+    ra->stmt        = st->stmt;
+    ra->shared      = st->owner->shared;
+    Oradpi_SharedConnAddRef(ra->shared);
+    ra->numCols     = n;
+    ra->fetchArray  = st->fetchArray;
+    ra->varData     = (dpiData **)Tcl_Alloc(n * sizeof(dpiData *));
+    ra->nativeTypes = (dpiNativeTypeNum *)Tcl_Alloc(n * sizeof(dpiNativeTypeNum));
+    ra->isChar      = (int *)Tcl_Alloc(n * sizeof(int));
+    memcpy(ra->varData, st->fetchVarData, n * sizeof(dpiData *));
+    memcpy(ra->nativeTypes, st->fetchNativeTypes, n * sizeof(dpiNativeTypeNum));
+    memcpy(ra->isChar, st->fetchIsChar, n * sizeof(int));
+    if (st->fetchLongLob) {
+        ra->longLob = (unsigned char *)Tcl_Alloc(n);
+        memcpy(ra->longLob, st->fetchLongLob, n);
+        ra->lobMax = st->fetchLobMax;
+    }
+    ra->more = 1;
+    if (st->rcKey) {
+        ra->fillKey       = st->rcKey;
+        ra->fillTtl       = st->resultCacheTtl;
+        ra->fillSubscrId  = st->rcSubscrId;
+        ra->fillQueryId   = st->rcQueryId;
+        ra->fillChangeSeq = st->rcChangeSeq;
+        st->rcKey         = NULL;
+    }
+    st->ra = ra;
+    return ra;
+}
+
+/* Memory held by n snapshotted cells, for the result cache budget. */
+static size_t FetchCellsBytes(const OradpiFetchCell *cells, size_t n) {
+    size_t bytes = n * sizeof(OradpiFetchCell);
+    for (size_t i = 0; i < n; i++)
+        if (cells[i].bytes)
+            bytes += (size_t)cells[i].bytesLen;
+    return bytes;
+}
+
+/* Done with the current batch.  Cached rows are only borrowed; the batch
+ * of a result being cached moves to the fill buffer until it grows past
+ * ORADPI_RESULTCACHE_ROWS or ORADPI_RESULTCACHE_BYTES, when caching is
+ * given up for this result. */
+static void ReadaheadRetire(OradpiReadahead *ra) {
+    if (ra->curCells && !ra->cached) {
+        size_t n     = (size_t)ra->curRows * ra->numCols;
+        size_t bytes = ra->fillKey ? FetchCellsBytes(ra->curCells, n) : 0;
+        if (ra->fillKey && (uint64_t)ra->fillRows + ra->curRows <= ORADPI_RESULTCACHE_ROWS && ra->fillBytes + bytes <= ORADPI_RESULTCACHE_BYTES) {
+            size_t have = (size_t)ra->fillRows * ra->numCols;
+            ra->fillCells = (OradpiFetchCell *)Tcl_Realloc((char *)ra->fillCells, (have + n) * sizeof(OradpiFetchCell));
+            memcpy(ra->fillCells + have, ra->curCells, n * sizeof(OradpiFetchCell));
+            ra->fillRows += ra->curRows;
+            ra->fillBytes += bytes;
+        } else {
+            ReadaheadDropFill(ra);
+            FreeFetchCells(ra->curCells, (Tcl_Size)n, ra->shared);
+        }
+        Tcl_Free((char *)ra->curCells);
+    }
+    ra->curCells = NULL;
+    ra->curRows = ra->curPos = 0;
+}
+
+/* Point *rowOut at the next prefetched row (numCols cells), or NULL at
+ * end of data.  Waits for the in-flight batch when the current one is
+ * used up, then immediately queues the following one. */
+static int ReadaheadNextRow(Tcl_Interp *ip, OradpiStmt *st, OradpiReadahead *ra, OradpiFetchCell **rowOut) {
+    *rowOut = NULL;
+    if (ra->curPos >= ra->curRows) {
+        ReadaheadRetire(ra);
+        if (!ra->more) {
+            if (ra->fillKey)
+                ResultCachePublish(ra);
+            return TCL_OK;
+        }
+
+        Tcl_MutexLock(&ra->lock);
+        int pending = ra->pending;
+        Tcl_MutexUnlock(&ra->lock);
+        if (!pending && ReadaheadSubmit(ra) != TCL_OK)
+            return Oradpi_SetError(ip, (OradpiBase *)st, -1, "orafetch: failed to queue readahead fetch (worker pool unavailable)");
+
+        Tcl_MutexLock(&ra->lock);
+        while (ra->pending)
+            Tcl_ConditionWait(&ra->cond, &ra->lock, NULL);
+        OradpiFetchCell *cells   = ra->nextCells;
+        uint32_t         rows    = ra->nextRows;
+        int              more    = ra->nextMore;
+        int              failed  = ra->nextFailed;
+        int              errCode = ra->nextErrCode;
+        char            *errMsg  = ra->nextErrMsg;
+        ra->nextCells            = NULL;
+        ra->nextRows             = 0;
+        ra->nextFailed           = 0;
+        ra->nextErrMsg           = NULL;
+        Tcl_MutexUnlock(&ra->lock);
+
+        if (failed) {
+            ra->more = 0;
+            ReadaheadDropFill(ra); /* never publish a partial result */
+            int rc   = Oradpi_SetError(ip, (OradpiBase *)st, errCode ? errCode : -1, errMsg ? errMsg : "readahead fetch failed");
+            if (errMsg)
+                Tcl_Free(errMsg);
+            return rc;
+        }
+        ra->curCells = cells;
+        ra->curRows  = rows;
+        ra->more     = more && rows > 0;
+        if (ra->more)
+            (void)ReadaheadSubmit(ra); /* on failure the next batch is queued on demand */
+        if (rows == 0) {
+            if (ra->fillKey)
+                ResultCachePublish(ra);
+            return TCL_OK;
+        }
+    }
+    *rowOut = &ra->curCells[(size_t)ra->curPos++ * ra->numCols];
+    return TCL_OK;
+}
+
+/* Called whenever the cursor is reset or its buffers change; the scroll
+ * window describes the same cursor and goes with it. */
+void Oradpi_ReadaheadDiscard(OradpiStmt *s) {
+    if (s) {
+        ScrollWindowDrop(s);
+        ResultCacheForget(s);
+    }
+    OradpiReadahead *ra = s ? s->ra : NULL;
+    if (!ra)
+        return;
+    s->ra = NULL;
+    /* The worker reads the statement's define buffers; wait for it before
+     * the caller re-parses, re-executes or frees them. */
+    Tcl_MutexLock(&ra->lock);
+    ra->discarded = 1;
+    while (ra->pending)
+        Tcl_ConditionWait(&ra->cond, &ra->lock, NULL);
+    Tcl_MutexUnlock(&ra->lock);
+    ReadaheadRelease(ra);
+}
+
+/* ==========================================================================
+ * Result cache
+ *
+ * With "oraconfig $S resultcache seconds", a query's rows are published
+ * in a process-wide table once they have all been fetched, keyed by the
+ * session identity (user, schema, database, time zone, NLS settings), the
+ * column type overrides, the SQL text and the bound values with their
+ * bind types.  A later execute of the same key on any connection of the
+ * process skips the round trip and orafetch serves the cached rows.
+ * Entries live for the publishing statement's TTL; on a connection opened
+ * with "oralogon -events" the statement is prepared through a change
+ * notification subscription, so the execute that reads the rows also
+ * registers the query, and a change to its tables drops the entry.
+ * Results with LOB columns, REF CURSOR binds, more than
+ * ORADPI_RESULTCACHE_ROWS rows or ORADPI_RESULTCACHE_BYTES bytes are not
+ * cached.
+ * ========================================================================== */
+
+static Tcl_Mutex     gRcMutex;
+static int           gRcInited = 0;
+static Tcl_HashTable gRcTable;
+static uint64_t      gRcNextSubscrId = 0;
+static size_t        gRcBytes        = 0; /* sum of listed entries' bytes */
+static uint64_t      gRcChangeSeq    = 0; /* notifications received */
+
+static Tcl_WideInt   ResultCacheNowMs(void) {
+    Tcl_Time t;
+    Tcl_GetTime(&t);
+    return (Tcl_WideInt)t.sec * 1000 + t.usec / 1000;
+}
+
+static void ResultCacheFreeEntry(OradpiResultCacheEntry *e) {
+    FreeFetchCells(e->cells, (Tcl_Size)e->numRows * e->numCols, NULL);
+    Tcl_Free((char *)e->cells);
+    Tcl_Free((char *)e);
+}
+
+static void ResultCacheExitHandler(void *unused) {
+    (void)unused;
+    Tcl_MutexLock(&gRcMutex);
+    if (gRcInited) {
+        Tcl_HashSearch search;
+        Tcl_HashEntry *he;
+        for (he = Tcl_FirstHashEntry(&gRcTable, &search); he; he = Tcl_NextHashEntry(&search)) {
+            OradpiResultCacheEntry *e = (OradpiResultCacheEntry *)Tcl_GetHashValue(he);
+            e->hashEntry              = NULL;
+            if (--e->refCount == 0)
+                ResultCacheFreeEntry(e);
+        }
+        Tcl_DeleteHashTable(&gRcTable);
+        gRcInited = 0;
+    }
+    Tcl_MutexUnlock(&gRcMutex);
+}
+
+/* Caller holds gRcMutex. */
+static void ResultCacheInitLocked(void) {
+    if (!gRcInited) {
+        Tcl_InitHashTable(&gRcTable, TCL_STRING_KEYS);
+        gRcInited = 1;
+        Tcl_CreateExitHandler(ResultCacheExitHandler, NULL);
+    }
+}
+
+/* Caller holds gRcMutex.  Returns 1 when the last reference went away and
+ * the caller must free e after unlocking. */
+static int ResultCacheUnlistLocked(OradpiResultCacheEntry *e) {
+    if (!e->hashEntry)
+        return 0;
+    Tcl_DeleteHashEntry(e->hashEntry);
+    e->hashEntry = NULL;
+    gRcBytes -= e->bytes;
+    return --e->refCount == 0;
+}
+
+static void ResultCacheUnlist(OradpiResultCacheEntry *e) {
+    Tcl_MutexLock(&gRcMutex);
+    int doFree = ResultCacheUnlistLocked(e);
+    Tcl_MutexUnlock(&gRcMutex);
+    if (doFree)
+        ResultCacheFreeEntry(e);
+}
+
+static void ResultCacheRelease(OradpiResultCacheEntry *e) {
+    Tcl_MutexLock(&gRcMutex);
+    int doFree = (--e->refCount == 0);
+    Tcl_MutexUnlock(&gRcMutex);
+    if (doFree)
+        ResultCacheFreeEntry(e);
+}
+
+/* Drop the entries of a subscription; with queryId != 0 only that query's.
+ * Called from the notification thread.  The rows hold no LOB references,
+ * so an entry can be freed while the table is locked. */
+static void ResultCacheDropSubscr(uint64_t subscrId, uint64_t queryId) {
+    Tcl_MutexLock(&gRcMutex);
+    gRcChangeSeq++;
+    if (gRcInited) {
+        Tcl_HashSearch search;
+        Tcl_HashEntry *he = Tcl_FirstHashEntry(&gRcTable, &search);
+        while (he) {
+            OradpiResultCacheEntry *e = (OradpiResultCacheEntry *)Tcl_GetHashValue(he);
+            he                        = Tcl_NextHashEntry(&search);
+            if (e->subscrId != subscrId || (queryId && e->queryId != queryId))
+                continue;
+            if (ResultCacheUnlistLocked(e))
+                ResultCacheFreeEntry(e);
+        }
+    }
+    Tcl_MutexUnlock(&gRcMutex);
+}
+
+static void ResultCacheForget(OradpiStmt *s) {
+    if (s->rcHit) {
+        ResultCacheRelease(s->rcHit);
+        s->rcHit = NULL;
+    }
+    if (s->rcKey) {
+        Tcl_Free(s->rcKey);
+        s->rcKey = NULL;
+    }
+    s->rcSubscrId = s->rcQueryId = 0;
+}
+
+/* Caller holds gRcMutex.  Make room for one more entry of the given size:
+ * expired entries go first, then those closest to expiry. */
+static void ResultCacheEvictLocked(Tcl_WideInt now, size_t bytes) {
+    Tcl_HashSearch          search;
+    Tcl_HashEntry          *he = Tcl_FirstHashEntry(&gRcTable, &search);
+    while (he) {
+        OradpiResultCacheEntry *e = (OradpiResultCacheEntry *)Tcl_GetHashValue(he);
+        he                        = Tcl_NextHashEntry(&search);
+        if (e->expiresMs <= now && ResultCacheUnlistLocked(e))
+            ResultCacheFreeEntry(e);
+    }
+    while (gRcTable.numEntries > 0 && (gRcTable.numEntries >= ORADPI_RESULTCACHE_ENTRIES || gRcBytes + bytes > ORADPI_RESULTCACHE_BYTES)) {
+        OradpiResultCacheEntry *oldest = NULL;
+        for (he = Tcl_FirstHashEntry(&gRcTable, &search); he; he = Tcl_NextHashEntry(&search)) {
+            OradpiResultCacheEntry *e = (OradpiResultCacheEntry *)Tcl_GetHashValue(he);
+            if (!oldest || e->expiresMs < oldest->expiresMs)
+                oldest = e;
+        }
+        if (ResultCacheUnlistLocked(oldest))
+            ResultCacheFreeEntry(oldest);
+    }
+}
+
+/* The session part of the cache key, read from the server on first use
+ * and after Oradpi_ResultCacheStmtDone: the same SQL text names
+ * different objects for different users, schemas and databases, and
+ * returns different values under other time zone or NLS settings.  With
+ * ip NULL a failure is not reported. */
+static const char *ResultCacheIdentity(Tcl_Interp *ip, OradpiStmt *s) {
+    static const char sql[] = "SELECT SYS_CONTEXT('USERENV','SESSION_USER') || '/' || SYS_CONTEXT('USERENV','CURRENT_SCHEMA') || '@' || "
+                              "SYS_CONTEXT('USERENV','DB_UNIQUE_NAME') || '/' || SYS_CONTEXT('USERENV','CON_NAME') || '/' || SESSIONTIMEZONE || '/' || "
+                              "(SELECT LISTAGG(parameter || '=' || value, ';') WITHIN GROUP (ORDER BY parameter) FROM NLS_SESSION_PARAMETERS) FROM DUAL";
+    OradpiConn      *co = s->owner;
+    if (co->rcIdentity)
+        return co->rcIdentity;
+
+    dpiStmt         *q     = NULL;
+    const char      *fn    = NULL;
+    uint32_t         ncols = 0, bufIdx = 0;
+    int              found = 0;
+    dpiNativeTypeNum nt;
+    dpiData         *d = NULL;
+    dpiErrorInfo     ei;
+    CONN_GATE_ENTER(co);
+    if (dpiConn_prepareStmt(co->conn, 0, sql, (uint32_t)(sizeof(sql) - 1), NULL, 0, &q) != DPI_SUCCESS)
+        fn = "dpiConn_prepareStmt";
+    else if (dpiStmt_execute(q, DPI_MODE_EXEC_DEFAULT, &ncols) != DPI_SUCCESS)
+        fn = "dpiStmt_execute";
+    else if (dpiStmt_fetch(q, &found, &bufIdx) != DPI_SUCCESS)
+        fn = "dpiStmt_fetch";
+    else if (found && dpiStmt_getQueryValue(q, 1, &nt, &d) != DPI_SUCCESS)
+        fn = "dpiStmt_getQueryValue";
+    if (fn)
+        (void)Oradpi_CaptureODPIError(&ei);
+    else {
+        const char *text = "";
+        uint32_t    len  = 0;
+        if (found && d && !d->isNull && nt == DPI_NATIVE_TYPE_BYTES) {
+            text = d->value.asBytes.ptr;
+            len  = d->value.asBytes.length;
+        }
+        co->rcIdentity = (char *)Tcl_Alloc((size_t)len + 1);
+        memcpy(co->rcIdentity, text, len);
+        co->rcIdentity[len] = '\0';
+    }
+    if (q)
+        dpiStmt_release(q);
+    CONN_GATE_LEAVE(co);
+    if (fn) {
+        if (ip)
+            Oradpi_SetErrorFromODPIInfo(ip, (OradpiBase *)s, fn, &ei);
+        return NULL;
+    }
+    return co->rcIdentity;
+}
+
+/* Called by every execute of a statement with a resultcache TTL, after
+ * the previous result was discarded.  On a hit s->rcHit is set and the
+ * execute is skipped; on a miss s->rcKey names the key the rows will be
+ * published under once orafetch has read them all. */
+int Oradpi_ResultCacheLookup(Tcl_Interp *ip, OradpiStmt *s, const char *stmtKey, int *hit) {
+    *hit = 0;
+    if (!s->resultCacheTtl || !s->sqlText || !s->stmtIsQuery || s->scrollable || !s->owner)
+        return TCL_OK;
+
+    /* A session with uncommitted changes must see them, and its rows must
+     * not reach other sessions: bypass the cache (both ways) until the
+     * transaction ends.  Unknown counts as in progress. */
+    int inTxn = 1;
+    CONN_GATE_ENTER(s->owner);
+    if (dpiConn_getTransactionInProgress(s->owner->conn, &inTxn) != DPI_SUCCESS)
+        inTxn = 1;
+    CONN_GATE_LEAVE(s->owner);
+    if (inTxn)
+        return TCL_OK;
+
+    const char *identity = ResultCacheIdentity(ip, s);
+    if (!identity)
+        return TCL_ERROR;
+
+    Tcl_DString key;
+    Tcl_DStringInit(&key);
+    Tcl_DStringAppend(&key, identity, -1);
+    Tcl_DStringAppend(&key, "\n", 1);
+    if (s->colTypes)
+        Tcl_DStringAppend(&key, Tcl_GetString(s->colTypes), -1);
+    Tcl_DStringAppend(&key, "\n", 1);
+    Tcl_DStringAppend(&key, Tcl_GetString(s->sqlText), -1);
+    if (!Oradpi_BindStoreAppendKey(ip, stmtKey, &key)) {
+        Tcl_DStringFree(&key);
+        return TCL_OK;
+    }
+
+    OradpiResultCacheEntry *e   = NULL;
+    Tcl_WideInt             now = ResultCacheNowMs();
+    Tcl_MutexLock(&gRcMutex);
+    ResultCacheInitLocked();
+    Tcl_HashEntry *he = Tcl_FindHashEntry(&gRcTable, Tcl_DStringValue(&key));
+    if (he) {
+        e = (OradpiResultCacheEntry *)Tcl_GetHashValue(he);
+        if (e->expiresMs <= now) {
+            if (ResultCacheUnlistLocked(e))
+                ResultCacheFreeEntry(e);
+            e = NULL;
+        } else if (now - e->createdMs >= (Tcl_WideInt)s->resultCacheTtl * 1000)
+            e = NULL; /* older than this statement accepts */
+        else
+            e->refCount++;
+    }
+    Tcl_MutexUnlock(&gRcMutex);
+
+    if (!e) {
+        Tcl_Size n = Tcl_DStringLength(&key);
+        s->rcKey   = (char *)Tcl_Alloc((size_t)n + 1);
+        memcpy(s->rcKey, Tcl_DStringValue(&key), (size_t)n + 1);
+        Tcl_DStringFree(&key);
+        return TCL_OK;
+    }
+    Tcl_DStringFree(&key);
+
+    /* orafetch needs the column descriptions; a statement that has never
+     * been executed gets them from a describe-only execute. */
+    if (s->fetchCacheNumCols == 0) {
+        uint32_t ncols = 0;
+        CONN_GATE_ENTER(s->owner);
+        if (dpiStmt_execute(s->stmt, DPI_MODE_EXEC_DESCRIBE_ONLY, &ncols) != DPI_SUCCESS) {
+            CONN_GATE_LEAVE(s->owner);
+            ResultCacheRelease(e);
+            return Oradpi_SetErrorFromODPI(ip, (OradpiBase *)s, "dpiStmt_execute");
+        }
+        CONN_GATE_LEAVE(s->owner);
+    }
+    s->rcHit = e;
+    *hit     = 1;
+    return TCL_OK;
+}
+
+/* Change notification callback, on an Oracle client thread.  No Tcl
+ * interp is touched; the affected entries are only unlisted. */
+static void ResultCacheNotify(void *context, dpiSubscrMessage *message) {
+    uint64_t subscrId = (uint64_t)(uintptr_t)context;
+    if (message->errorInfo)
+        return;
+    if (message->eventType == DPI_EVENT_QUERYCHANGE) {
+        for (uint32_t i = 0; i < message->numQueries; i++)
+            ResultCacheDropSubscr(subscrId, message->queries[i].id);
+    } else if (message->eventType != DPI_EVENT_NONE)
+        ResultCacheDropSubscr(subscrId, 0); /* deregistration, shutdown */
+}
+
+/* The connection's change notification subscription, created on first
+ * use.  Returns TCL_ERROR without touching any interp when it cannot be
+ * created; the entries are then TTL-only. */
+static int ResultCacheEnsureSubscr(OradpiConn *co) {
+    if (co->rcSubscr)
+        return TCL_OK;
+    dpiSubscrCreateParams params;
+    dpiContext           *ctx = Oradpi_GetDpiContext();
+    if (!ctx || dpiContext_initSubscrCreateParams(ctx, &params) != DPI_SUCCESS)
+        return TCL_ERROR;
+    Tcl_MutexLock(&gRcMutex);
+    uint64_t id = ++gRcNextSubscrId;
+    Tcl_MutexUnlock(&gRcMutex);
+    params.subscrNamespace = DPI_SUBSCR_NAMESPACE_DBCHANGE;
+    params.protocol        = DPI_SUBSCR_PROTO_CALLBACK;
+    params.qos             = DPI_SUBSCR_QOS_QUERY;
+    params.callback        = ResultCacheNotify;
+    params.callbackContext = (void *)(uintptr_t)id;
+    CONN_GATE_ENTER(co);
+    int rc = dpiConn_subscribe(co->conn, &params, &co->rcSubscr);
+    CONN_GATE_LEAVE(co);
+    if (rc != DPI_SUCCESS) {
+        co->rcSubscr = NULL;
+        return TCL_ERROR;
+    }
+    co->rcSubscrId = id;
+    return TCL_OK;
+}
+
+/* A miss on an events connection: prepare the statement through the
+ * subscription (once; re-parsing drops it) so that the execute reading
+ * the rows also registers the query, leaving no window for a change to
+ * go unnoticed.  The statement keeps its SQL text, so the fetch cache is
+ * defined on the new cursor by the next orafetch. */
+void Oradpi_ResultCacheSubscribe(OradpiStmt *s) {
+    OradpiConn *co = s->owner;
+    if (!s->rcKey || !co || !co->events || !s->sqlText || !s->stmt)
+        return;
+    Tcl_MutexLock(&gRcMutex);
+    s->rcChangeSeq = gRcChangeSeq;
+    Tcl_MutexUnlock(&gRcMutex);
+    if (s->rcSubscrStmt || ResultCacheEnsureSubscr(co) != TCL_OK)
+        return;
+
+    Tcl_Size    sqlLen = 0;
+    const char *sql    = Tcl_GetStringFromObj(s->sqlText, &sqlLen);
+    dpiStmt    *rs     = NULL;
+    uint32_t    pr     = s->prefetchRows ? s->prefetchRows : co->prefetchRows;
+    if (s->fetchAuto && pr < ORADPI_FETCHAUTO_PREFETCH)
+        pr = ORADPI_FETCHAUTO_PREFETCH;
+    CONN_GATE_ENTER(co);
+    int ok = dpiSubscr_prepareStmt(co->rcSubscr, sql, (uint32_t)sqlLen, &rs) == DPI_SUCCESS;
+    if (ok && s->fetchArray && dpiStmt_setFetchArraySize(rs, s->fetchArray) != DPI_SUCCESS)
+        ok = 0;
+    if (ok && pr && dpiStmt_setPrefetchRows(rs, pr) != DPI_SUCCESS)
+        ok = 0;
+    if (ok) {
+        dpiStmt_close(s->stmt, NULL, 0);
+        dpiStmt_release(s->stmt);
+        s->stmt = rs;
+    } else if (rs)
+        dpiStmt_release(rs);
+    CONN_GATE_LEAVE(co);
+    if (!ok)
+        return;
+    s->rcSubscrStmt = 1;
+    if (s->fetchCacheNumCols && s->fetchVars)
+        s->fetchRedefine = 1;
+    else
+        Oradpi_FreeFetchCache(s);
+}
+
+/* After the execute of a miss: the id the subscription gave the query. */
+void Oradpi_ResultCacheExecuted(OradpiStmt *s) {
+    uint64_t queryId = 0;
+    if (!s->rcKey || !s->rcSubscrStmt || !s->owner || !s->owner->rcSubscr)
+        return;
+    CONN_GATE_ENTER(s->owner);
+    int rc = dpiStmt_getSubscrQueryId(s->stmt, &queryId);
+    CONN_GATE_LEAVE(s->owner);
+    if (rc != DPI_SUCCESS)
+        return;
+    s->rcSubscrId = s->owner->rcSubscrId;
+    s->rcQueryId  = queryId;
+}
+
+/* After any successful execute.  A statement that is neither a query nor
+ * DML (ALTER SESSION, a PL/SQL block) may have changed the session's NLS
+ * or time zone settings: read the identity again before the next lookup. */
+void Oradpi_ResultCacheStmtDone(OradpiStmt *s) {
+    OradpiConn *co = s->owner;
+    if (co && co->rcIdentity && !s->stmtIsQuery && !s->stmtIsDML) {
+        Tcl_Free(co->rcIdentity);
+        co->rcIdentity = NULL;
+    }
+}
+
+/* End of data on a result being cached: list the kept rows.  A result
+ * registered for change notification is dropped when any notification
+ * arrived since its execute, since that change may not be in the rows. */
+static void ResultCachePublish(OradpiReadahead *ra) {
+    Tcl_MutexLock(&gRcMutex);
+    int stale = ra->fillSubscrId && gRcChangeSeq != ra->fillChangeSeq;
+    Tcl_MutexUnlock(&gRcMutex);
+    if (stale) {
+        ReadaheadDropFill(ra);
+        return;
+    }
+
+    OradpiResultCacheEntry *e = (OradpiResultCacheEntry *)Tcl_Alloc(sizeof(*e));
+    memset(e, 0, sizeof(*e));
+    e->refCount  = 1; /* table */
+    e->numCols   = ra->numCols;
+    e->numRows   = ra->fillRows;
+    e->cells     = ra->fillCells;
+    e->bytes     = ra->fillBytes;
+    e->subscrId  = ra->fillSubscrId;
+    e->queryId   = ra->fillQueryId;
+    e->createdMs = ResultCacheNowMs();
+    e->expiresMs = e->createdMs + (Tcl_WideInt)ra->fillTtl * 1000;
+    char *key    = ra->fillKey;
+    ra->fillCells = NULL;
+    ra->fillRows  = 0;
+    ra->fillBytes = 0;
+    ra->fillKey   = NULL;
+
+    int isNew;
+    Tcl_MutexLock(&gRcMutex);
+    ResultCacheInitLocked();
+    Tcl_HashEntry *he = Tcl_FindHashEntry(&gRcTable, key);
+    if (he) {
+        OradpiResultCacheEntry *old = (OradpiResultCacheEntry *)Tcl_GetHashValue(he);
+        if (ResultCacheUnlistLocked(old))
+            ResultCacheFreeEntry(old);
+    }
+    ResultCacheEvictLocked(e->createdMs, e->bytes);
+    he           = Tcl_CreateHashEntry(&gRcTable, key, &isNew);
+    e->hashEntry = he;
+    Tcl_SetHashValue(he, e);
+    gRcBytes += e->bytes;
+    Tcl_MutexUnlock(&gRcMutex);
+    Tcl_Free(key);
+}
+
+/* Connection teardown: its subscription stops delivering notifications,
+ * so the entries registered on it cannot be trusted past this point. */
+void Oradpi_ResultCacheConnClosed(OradpiConn *co) {
+    if (!co || !co->rcSubscr)
+        return;
+    ResultCacheDropSubscr(co->rcSubscrId, 0);
+    if (co->conn && CONN_GATE_ENTER_TIMED(co, ORADPI_TEARDOWN_TIMEOUT_MS)) {
+        (void)dpiConn_unsubscribe(co->conn, co->rcSubscr);
+        CONN_GATE_LEAVE(co);
+    } else
+        dpiSubscr_release(co->rcSubscr);
+    co->rcSubscr = NULL;
+}
+
+/* ==========================================================================
+ * Delimited text export (-channel)
+ *
+ * Rows are formatted straight from the define buffers (or fetch cells)
+ * into a byte buffer that is handed to the channel once per batch, so no
+ * Tcl_Obj is created per value.  Field text matches what orafetch would
+ * return, except that RAW/BLOB values are written as uppercase hex.
+ * ========================================================================== */
+
+enum { EXPORT_CSV = 0, EXPORT_TSV };
+static const char *const exportFormatNames[] = {"csv", "tsv", NULL};
+
+/* Flush threshold for the unbuffered (per-row) sources. */
+#define ORADPI_EXPORT_FLUSH_BYTES 65536
+
+typedef struct OradpiArrowBatch OradpiArrowBatch;
+
+typedef struct OradpiExportFmt {
+    int                  format;
+    const char          *nullText;
+    Tcl_Size             nullLen;
+    const unsigned char *dateFmt; /* [numCols] or NULL for ISO */
+    OradpiArrowBatch    *arrow;   /* -arrow: the pending record batch; replaces format */
+} OradpiExportFmt;
+
+/* Bytes that force quoting (CSV) or escaping (TSV), one table per format. */
+static const unsigned char exportSpecial[2][256] = {
+    [EXPORT_CSV] = {[','] = 1, ['"'] = 1, ['\r'] = 1, ['\n'] = 1},
+    [EXPORT_TSV] = {['\t'] = 1, ['\\'] = 1, ['\r'] = 1, ['\n'] = 1},
+};
+
+static void ExportAppendText(Tcl_DString *ds, int format, const char *p, Tcl_Size len) {
+    const unsigned char *special = exportSpecial[format];
+    Tcl_Size             i       = 0;
+    while (i < len && !special[(unsigned char)p[i]])
+        i++;
+    if (i == len) {
+        Tcl_DStringAppend(ds, p, len);
+        return;
+    }
+    if (format == EXPORT_CSV) {
+        Tcl_DStringAppend(ds, "\"", 1);
+        Tcl_Size start = 0;
+        for (Tcl_Size j = i; j < len; j++) {
+            if (p[j] == '"') {
+                Tcl_DStringAppend(ds, p + start, j - start + 1);
+                Tcl_DStringAppend(ds, "\"", 1);
+                start = j + 1;
+            }
+        }
+        Tcl_DStringAppend(ds, p + start, len - start);
+        Tcl_DStringAppend(ds, "\"", 1);
+        return;
+    }
+    Tcl_DStringAppend(ds, p, i);
+    Tcl_Size start = i;
+    for (; i < len; i++) {
+        const char *esc = NULL;
+        switch (p[i]) {
+        case '\t':
+            esc = "\\t";
+            break;
+        case '\n':
+            esc = "\\n";
+            break;
+        case '\r':
+            esc = "\\r";
+            break;
+        case '\\':
+            esc = "\\\\";
+            break;
+        default:
+            continue;
+        }
+        Tcl_DStringAppend(ds, p + start, i - start);
+        Tcl_DStringAppend(ds, esc, 2);
+        start = i + 1;
+    }
+    Tcl_DStringAppend(ds, p + start, len - start);
+}
+
+static void ExportAppendHex(Tcl_DString *ds, const char *p, Tcl_Size len) {
+    static const char hex[] = "0123456789ABCDEF";
+    Tcl_Size          base  = Tcl_DStringLength(ds);
+    Tcl_DStringSetLength(ds, base + 2 * len);
+    char *out = Tcl_DStringValue(ds) + base;
+    for (Tcl_Size i = 0; i < len; i++) {
+        out[2 * i]     = hex[((unsigned char)p[i]) >> 4];
+        out[2 * i + 1] = hex[((unsigned char)p[i]) & 0xF];
+    }
+}
+
+static void ExportAppendDouble(Tcl_DString *ds, double dv) {
+    char buf[TCL_DOUBLE_SPACE + 8];
+    /* Integral values print as integers, as DoubleToObj does. */
+    if (isfinite(dv)) {
+        double intpart;
+        if (modf(dv, &intpart) == 0.0 && intpart >= (double)LLONG_MIN && intpart <= (double)LLONG_MAX) {
+            snprintf(buf, sizeof(buf), "%lld", (long long)intpart);
+            Tcl_DStringAppend(ds, buf, -1);
+            return;
+        }
+    }
+    Tcl_PrintDouble(NULL, dv, buf);
+    Tcl_DStringAppend(ds, buf, -1);
+}
+
+/* Append one field.  cell may be a snapshot or a view over a define
+ * buffer (see ExportCellView); LOB cells must already be inlined. */
+static void ExportAppendCell(Tcl_Interp *ip, Tcl_DString *ds, const OradpiExportFmt *fmt, const OradpiFetchCell *cell, int dateFmt) {
+    char buf[64];
+    if (cell->isNull) {
+        ExportAppendText(ds, fmt->format, fmt->nullText, fmt->nullLen);
+        return;
+    }
+    switch (cell->nt) {
+    case DPI_NATIVE_TYPE_INT64:
+        snprintf(buf, sizeof(buf), "%" PRId64, cell->scalar.i64);
+        Tcl_DStringAppend(ds, buf, -1);
+        break;
+    case DPI_NATIVE_TYPE_UINT64:
+        snprintf(buf, sizeof(buf), "%" PRIu64, cell->scalar.u64);
+        Tcl_DStringAppend(ds, buf, -1);
+        break;
+    case DPI_NATIVE_TYPE_FLOAT:
+        ExportAppendDouble(ds, (double)cell->scalar.f32);
+        break;
+    case DPI_NATIVE_TYPE_DOUBLE:
+        ExportAppendDouble(ds, cell->scalar.f64);
+        break;
+    case DPI_NATIVE_TYPE_BOOLEAN:
+        Tcl_DStringAppend(ds, cell->scalar.boolean ? "1" : "0", 1);
+        break;
+    case DPI_NATIVE_TYPE_TIMESTAMP: {
+        const dpiTimestamp *ts = &cell->scalar.ts;
+        switch (dateFmt) {
+        case ORADPI_DATEFMT_EPOCH:
+            snprintf(buf, sizeof(buf), "%" PRId64, TimestampToEpochSeconds(ts));
+            break;
+        case ORADPI_DATEFMT_EPOCHMICROS:
+            snprintf(buf, sizeof(buf), "%" PRId64, TimestampToEpochMicros(ts));
+            break;
+        case ORADPI_DATEFMT_CLOCK:
+            snprintf(buf, sizeof(buf), "%" PRId64, TimestampToClockSeconds(ts));
+            break;
+        default:
+            FormatIsoTimestamp(buf, ts);
+            break;
+        }
+        Tcl_DStringAppend(ds, buf, -1);
+        break;
+    }
+    case DPI_NATIVE_TYPE_BYTES:
+    case DPI_NATIVE_TYPE_LOB:
+        if (cell->colIsChar)
+            ExportAppendText(ds, fmt->format, cell->bytes, cell->bytesLen);
+        else
+            ExportAppendHex(ds, cell->bytes, cell->bytesLen);
+        break;
+    default:
+        break;
+    }
+}
+
+/* Non-owning cell over a define buffer entry; never pass to FreeFetchCells. */
+static void ExportCellView(OradpiFetchCell *cell, dpiNativeTypeNum nt, const dpiData *d, int colIsChar) {
+    memset(cell, 0, sizeof(*cell));
+    cell->nt        = nt;
+    cell->colIsChar = colIsChar;
+    if (!d || d->isNull) {
+        cell->isNull = 1;
+        return;
+    }
+    switch (nt) {
+    case DPI_NATIVE_TYPE_INT64:
+        cell->scalar.i64 = d->value.asInt64;
+        break;
+    case DPI_NATIVE_TYPE_UINT64:
+        cell->scalar.u64 = d->value.asUint64;
+        break;
+    case DPI_NATIVE_TYPE_FLOAT:
+        cell->scalar.f32 = d->value.asFloat;
+        break;
+    case DPI_NATIVE_TYPE_DOUBLE:
+        cell->scalar.f64 = d->value.asDouble;
+        break;
+    case DPI_NATIVE_TYPE_BOOLEAN:
+        cell->scalar.boolean = d->value.asBoolean ? 1 : 0;
+        break;
+    case DPI_NATIVE_TYPE_TIMESTAMP:
+        cell->scalar.ts = d->value.asTimestamp;
+        break;
+    case DPI_NATIVE_TYPE_BYTES:
+        cell->bytes    = d->value.asBytes.ptr;
+        cell->bytesLen = (Tcl_Size)d->value.asBytes.length;
+        break;
+    default:
+        break;
+    }
+}
+
+static void ExportAppendRow(Tcl_Interp *ip, Tcl_DString *ds, const OradpiExportFmt *fmt, const OradpiFetchCell *row, uint32_t numCols) {
+    const char sep = (fmt->format == EXPORT_CSV) ? ',' : '\t';
+    for (uint32_t c = 0; c < numCols; c++) {
+        if (c > 0)
+            Tcl_DStringAppend(ds, &sep, 1);
+        ExportAppendCell(ip, ds, fmt, &row[c], DateFmtAt(fmt->dateFmt, c));
+    }
+    Tcl_DStringAppend(ds, "\n", 1);
+}
+
+/* The write may run Tcl code that frees the statement, so errors are
+ * reported without touching it.  Arrow streams are written as bytes. */
+static int ExportFlush(Tcl_Interp *ip, Tcl_Channel chan, Tcl_DString *ds, int binary) {
+    if (Tcl_DStringLength(ds) == 0)
+        return TCL_OK;
+    Tcl_Size written = binary ? Tcl_Write(chan, Tcl_DStringValue(ds), Tcl_DStringLength(ds)) : Tcl_WriteChars(chan, Tcl_DStringValue(ds), Tcl_DStringLength(ds));
+    Tcl_DStringSetLength(ds, 0);
+    if (written < 0) {
+        Tcl_SetObjResult(ip, Tcl_ObjPrintf("orafetch: error writing \"%s\": %s", Tcl_GetChannelName(chan), Tcl_PosixError(ip)));
+        return TCL_ERROR;
+    }
+    return TCL_OK;
+}
+
+/* ==========================================================================
+ * Arrow IPC stream export (-arrow)
+ *
+ * The rows go out as an Arrow IPC stream: a Schema message, one
+ * RecordBatch message per fetch batch, and the end-of-stream marker.  The
+ * flatbuffer metadata is written by hand (forward, children after their
+ * parents) so no Arrow or flatbuffers library is needed.  Columns are
+ * built straight from the define buffers, with the types of
+ * fetchNativeTypes: int64/uint64, float32/float64 (NUMBER text defines as
+ * float64, as -packed does), bool, timestamp[us] and utf8/binary.
+ * ========================================================================== */
+
+enum { ARROW_INT64 = 0, ARROW_UINT64, ARROW_FLOAT32, ARROW_FLOAT64, ARROW_BOOL, ARROW_TIMESTAMP, ARROW_UTF8, ARROW_BINARY };
+
+/* Message.fbs / Schema.fbs constants. */
+#define ARROW_METADATA_V5 4
+#define ARROW_HEADER_SCHEMA 1
+#define ARROW_HEADER_RECORDBATCH 3
+#define ARROW_TYPE_INT 2
+#define ARROW_TYPE_FLOATINGPOINT 3
+#define ARROW_TYPE_BINARY 4
+#define ARROW_TYPE_UTF8 5
+#define ARROW_TYPE_BOOL 6
+#define ARROW_TYPE_TIMESTAMP 10
+
+typedef struct OradpiArrowCol {
+    int         kind;
+    Tcl_DString valid;  /* validity bitmap, bit set = not NULL */
+    Tcl_DString values; /* fixed-width values, bool bits, or int32 offsets */
+    Tcl_DString data;   /* utf8/binary bytes */
+    int64_t     nullCount;
+} OradpiArrowCol;
+
+struct OradpiArrowBatch {
+    uint32_t        numCols;
+    int64_t         rows;
+    OradpiArrowCol *cols;
+};
+
+static void ArrowPutLE(Tcl_DString *ds, uint64_t v, int size) {
+    unsigned char b[8];
+    for (int i = 0; i < size; i++)
+        b[i] = (unsigned char)(v >> (8 * i));
+    Tcl_DStringAppend(ds, (const char *)b, size);
+}
+
+static void ArrowSetLE(Tcl_DString *ds, Tcl_Size at, uint64_t v, int size) {
+    unsigned char *p = (unsigned char *)Tcl_DStringValue(ds) + at;
+    for (int i = 0; i < size; i++)
+        p[i] = (unsigned char)(v >> (8 * i));
+}
+
+static void ArrowPad(Tcl_DString *ds, int align) {
+    static const char zeros[8] = {0};
+    Tcl_Size          rem      = Tcl_DStringLength(ds) % align;
+    if (rem)
+        Tcl_DStringAppend(ds, zeros, align - rem);
+}
+
+static void ArrowPutZeros(Tcl_DString *ds, Tcl_Size n) {
+    Tcl_Size base = Tcl_DStringLength(ds);
+    Tcl_DStringSetLength(ds, base + n);
+    memset(Tcl_DStringValue(ds) + base, 0, (size_t)n);
+}
+
+/* A uoffset at fb[at] pointing forward to fb[target]. */
+static void ArrowFbPatch(Tcl_DString *fb, Tcl_Size at, Tcl_Size target) {
+    ArrowSetLE(fb, at, (uint64_t)(target - at), 4);
+}
+
+/* One scalar or offset (size 4, patched later) field of a table. */
+typedef struct ArrowFbField {
+    int      id;
+    int      size;
+    uint64_t value;
+} ArrowFbField;
+
+/* Write a vtable and its table (at most 8 fields); pos[i] receives where
+ * field i was stored.  Returns the table position. */
+static Tcl_Size ArrowFbTable(Tcl_DString *fb, const ArrowFbField *f, int n, Tcl_Size *pos) {
+    int fieldOff[8];
+    int off = 4, slots = 0;
+    for (int i = 0; i < n; i++) {
+        off         = (off + f[i].size - 1) / f[i].size * f[i].size;
+        fieldOff[i] = off;
+        off += f[i].size;
+        if (f[i].id + 1 > slots)
+            slots = f[i].id + 1;
+    }
+    ArrowPad(fb, 2);
+    Tcl_Size vt = Tcl_DStringLength(fb);
+    ArrowPutLE(fb, (uint64_t)(4 + 2 * slots), 2);
+    ArrowPutLE(fb, (uint64_t)off, 2);
+    for (int s = 0; s < slots; s++) {
+        int o = 0;
+        for (int i = 0; i < n; i++)
+            if (f[i].id == s)
+                o = fieldOff[i];
+        ArrowPutLE(fb, (uint64_t)o, 2);
+    }
+    ArrowPad(fb, 8);
+    Tcl_Size t = Tcl_DStringLength(fb);
+    ArrowPutLE(fb, (uint64_t)(t - vt), 4);
+    ArrowPutZeros(fb, off - 4);
+    for (int i = 0; i < n; i++) {
+        ArrowSetLE(fb, t + fieldOff[i], f[i].value, f[i].size);
+        if (pos)
+            pos[i] = t + fieldOff[i];
+    }
+    return t;
+}
+
+/* Vector header for count 16-byte structs, elements 8-aligned. */
+static Tcl_Size ArrowFbStructVector(Tcl_DString *fb, uint32_t count) {
+    while ((Tcl_DStringLength(fb) + 4) % 8)
+        Tcl_DStringAppend(fb, "", 1);
+    Tcl_Size at = Tcl_DStringLength(fb);
+    ArrowPutLE(fb, count, 4);
+    return at;
+}
+
+/* Frame fb (and an optional body) as one encapsulated message. */
+static void ArrowWriteMessage(Tcl_DString *out, Tcl_DString *fb, Tcl_DString *body) {
+    ArrowPad(fb, 8);
+    ArrowPutLE(out, 0xFFFFFFFFu, 4);
+    ArrowPutLE(out, (uint64_t)Tcl_DStringLength(fb), 4);
+    Tcl_DStringAppend(out, Tcl_DStringValue(fb), Tcl_DStringLength(fb));
+    if (body)
+        Tcl_DStringAppend(out, Tcl_DStringValue(body), Tcl_DStringLength(body));
+}
+
+static int ArrowKindFor(dpiNativeTypeNum nt, int numText, int isChar) {
+    if (numText)
+        return ARROW_FLOAT64;
+    switch (nt) {
+    case DPI_NATIVE_TYPE_INT64:
+        return ARROW_INT64;
+    case DPI_NATIVE_TYPE_UINT64:
+        return ARROW_UINT64;
+    case DPI_NATIVE_TYPE_FLOAT:
+        return ARROW_FLOAT32;
+    case DPI_NATIVE_TYPE_DOUBLE:
+        return ARROW_FLOAT64;
+    case DPI_NATIVE_TYPE_BOOLEAN:
+        return ARROW_BOOL;
+    case DPI_NATIVE_TYPE_TIMESTAMP:
+        return ARROW_TIMESTAMP;
+    default:
+        return isChar ? ARROW_UTF8 : ARROW_BINARY;
+    }
+}
+
+static int ArrowIsVarWidth(int kind) {
+    return kind == ARROW_UTF8 || kind == ARROW_BINARY;
+}
+
+static void ArrowBatchReset(OradpiArrowBatch *ab) {
+    for (uint32_t c = 0; c < ab->numCols; c++) {
+        OradpiArrowCol *col = &ab->cols[c];
+        Tcl_DStringSetLength(&col->valid, 0);
+        Tcl_DStringSetLength(&col->values, 0);
+        Tcl_DStringSetLength(&col->data, 0);
+        col->nullCount = 0;
+        if (ArrowIsVarWidth(col->kind))
+            ArrowPutLE(&col->values, 0, 4);
+    }
+    ab->rows = 0;
+}
+
+static OradpiArrowBatch *ArrowBatchNew(const OradpiStmt *st, uint32_t numCols) {
+    OradpiArrowBatch *ab = (OradpiArrowBatch *)Tcl_Alloc(sizeof(*ab));
+    ab->numCols          = numCols;
+    ab->rows             = 0;
+    ab->cols             = (OradpiArrowCol *)Tcl_Alloc((numCols ? numCols : 1) * sizeof(OradpiArrowCol));
+    for (uint32_t c = 0; c < numCols; c++) {
+        OradpiArrowCol *col = &ab->cols[c];
+        col->kind           = ArrowKindFor(st->fetchNativeTypes[c], st->fetchNumText && st->fetchNumText[c], st->fetchIsChar[c]);
+        Tcl_DStringInit(&col->valid);
+        Tcl_DStringInit(&col->values);
+        Tcl_DStringInit(&col->data);
+    }
+    ArrowBatchReset(ab);
+    return ab;
+}
+
+static void ArrowBatchFree(OradpiArrowBatch *ab) {
+    for (uint32_t c = 0; c < ab->numCols; c++) {
+        Tcl_DStringFree(&ab->cols[c].valid);
+        Tcl_DStringFree(&ab->cols[c].values);
+        Tcl_DStringFree(&ab->cols[c].data);
+    }
+    Tcl_Free((char *)ab->cols);
+    Tcl_Free((char *)ab);
+}
+
+/* Set bit i of a bitmap that grows one byte per 8 rows. */
+static void ArrowPutBit(Tcl_DString *bits, int64_t i, int set) {
+    if ((i & 7) == 0)
+        Tcl_DStringAppend(bits, "", 1);
+    if (set)
+        Tcl_DStringValue(bits)[i >> 3] |= (char)(1 << (i & 7));
+}
+
+static double ArrowCellDouble(const OradpiFetchCell *cell) {
+    switch (cell->nt) {
+    case DPI_NATIVE_TYPE_INT64:
+        return (double)cell->scalar.i64;
+    case DPI_NATIVE_TYPE_UINT64:
+        return (double)cell->scalar.u64;
+    case DPI_NATIVE_TYPE_FLOAT:
+        return (double)cell->scalar.f32;
+    case DPI_NATIVE_TYPE_DOUBLE:
+        return cell->scalar.f64;
+    default:
+        return 0.0;
+    }
+}
+
+static int64_t ArrowCellInt64(const OradpiFetchCell *cell) {
+    switch (cell->nt) {
+    case DPI_NATIVE_TYPE_INT64:
+        return cell->scalar.i64;
+    case DPI_NATIVE_TYPE_UINT64:
+        return (int64_t)cell->scalar.u64;
+    case DPI_NATIVE_TYPE_BOOLEAN:
+        return cell->scalar.boolean;
+    default:
+        return (int64_t)ArrowCellDouble(cell);
+    }
+}
+
+/* Add one row (LOB cells inlined) to the pending batch. */
+static int ArrowAppendRow(Tcl_Interp *ip, OradpiArrowBatch *ab, const OradpiFetchCell *row) {
+    int64_t i = ab->rows;
+    for (uint32_t c = 0; c < ab->numCols; c++) {
+        OradpiArrowCol        *col    = &ab->cols[c];
+        const OradpiFetchCell *cell   = &row[c];
+        int                    isNull = cell->isNull;
+        if (ArrowIsVarWidth(col->kind) && !isNull && cell->nt != DPI_NATIVE_TYPE_BYTES && cell->nt != DPI_NATIVE_TYPE_LOB)
+            isNull = 1;
+        if (isNull)
+            col->nullCount++;
+        ArrowPutBit(&col->valid, i, !isNull);
+        switch (col->kind) {
+        case ARROW_INT64:
+        case ARROW_UINT64:
+            ArrowPutLE(&col->values, isNull ? 0 : (uint64_t)ArrowCellInt64(cell), 8);
+            break;
+        case ARROW_FLOAT32: {
+            float    fv = isNull ? 0.0f : (float)ArrowCellDouble(cell);
+            uint32_t bits;
+            memcpy(&bits, &fv, sizeof(bits));
+            ArrowPutLE(&col->values, bits, 4);
+            break;
+        }
+        case ARROW_FLOAT64: {
+            double   dv = isNull ? 0.0 : ArrowCellDouble(cell);
+            uint64_t bits;
+            if (!isNull && cell->nt == DPI_NATIVE_TYPE_BYTES && DecimalTextToDouble(ip, cell->bytes, cell->bytesLen, &dv) != TCL_OK)
+                return TCL_ERROR;
+            memcpy(&bits, &dv, sizeof(bits));
+            ArrowPutLE(&col->values, bits, 8);
+            break;
+        }
+        case ARROW_BOOL:
+            ArrowPutBit(&col->values, i, !isNull && ArrowCellInt64(cell) != 0);
+            break;
+        case ARROW_TIMESTAMP:
+            ArrowPutLE(&col->values, (!isNull && cell->nt == DPI_NATIVE_TYPE_TIMESTAMP) ? (uint64_t)TimestampToEpochMicros(&cell->scalar.ts) : 0, 8);
+            break;
+        default:
+            if (!isNull) {
+                if ((uint64_t)Tcl_DStringLength(&col->data) + (uint64_t)cell->bytesLen > (uint64_t)INT32_MAX)
+                    return Oradpi_SetError(ip, NULL, -1, "orafetch: -arrow batch holds more than 2 GB of column data; lower fetchrows");
+                Tcl_DStringAppend(&col->data, cell->bytes, cell->bytesLen);
+            }
+            ArrowPutLE(&col->values, (uint64_t)Tcl_DStringLength(&col->data), 4);
+            break;
+        }
+    }
+    ab->rows++;
+    return TCL_OK;
+}
+
+static void ArrowWriteSchema(Tcl_DString *out, const OradpiArrowBatch *ab, Tcl_Obj *const *names) {
+    Tcl_DString fb;
+    Tcl_Size    mpos[4], spos[2];
+    Tcl_DStringInit(&fb);
+
+    ArrowPutLE(&fb, 0, 4); /* root offset */
+    const ArrowFbField msg[] = {{0, 2, ARROW_METADATA_V5}, {1, 1, ARROW_HEADER_SCHEMA}, {2, 4, 0}, {3, 8, 0}};
+    ArrowFbPatch(&fb, 0, ArrowFbTable(&fb, msg, 4, mpos));
+    const ArrowFbField schema[] = {{0, 2, 0 /* little endian */}, {1, 4, 0}};
+    ArrowFbPatch(&fb, mpos[2], ArrowFbTable(&fb, schema, 2, spos));
+
+    ArrowPad(&fb, 4);
+    ArrowFbPatch(&fb, spos[1], Tcl_DStringLength(&fb));
+    ArrowPutLE(&fb, ab->numCols, 4);
+    Tcl_Size first = Tcl_DStringLength(&fb);
+    ArrowPutZeros(&fb, 4 * (Tcl_Size)ab->numCols);
+
+    for (uint32_t c = 0; c < ab->numCols; c++) {
+        static const int typeIds[] = {ARROW_TYPE_INT, ARROW_TYPE_INT, ARROW_TYPE_FLOATINGPOINT, ARROW_TYPE_FLOATINGPOINT, ARROW_TYPE_BOOL, ARROW_TYPE_TIMESTAMP, ARROW_TYPE_UTF8, ARROW_TYPE_BINARY};
+        int                     kind      = ab->cols[c].kind;
+        Tcl_Size                fpos[5];
+        const ArrowFbField      field[]   = {{0, 4, 0}, {1, 1, 1}, {2, 1, (uint64_t)typeIds[kind]}, {3, 4, 0}, {5, 4, 0}};
+        ArrowFbPatch(&fb, first + 4 * (Tcl_Size)c, ArrowFbTable(&fb, field, 5, fpos));
+
+        Tcl_Size    nameLen = 0;
+        const char *name    = Tcl_GetStringFromObj(names[c], &nameLen);
+        ArrowPad(&fb, 4);
+        ArrowFbPatch(&fb, fpos[0], Tcl_DStringLength(&fb));
+        ArrowPutLE(&fb, (uint64_t)nameLen, 4);
+        Tcl_DStringAppend(&fb, name, nameLen);
+        Tcl_DStringAppend(&fb, "", 1);
+
+        ArrowFbField type[2];
+        int          n = 0;
+        switch (kind) {
+        case ARROW_INT64:
+        case ARROW_UINT64:
+            type[n++] = (ArrowFbField){0, 4, 64};
+            type[n++] = (ArrowFbField){1, 1, kind == ARROW_INT64};
+            break;
+        case ARROW_FLOAT32:
+        case ARROW_FLOAT64:
+            type[n++] = (ArrowFbField){0, 2, kind == ARROW_FLOAT32 ? 1 : 2}; /* SINGLE, DOUBLE */
+            break;
+        case ARROW_TIMESTAMP:
+            type[n++] = (ArrowFbField){0, 2, 2}; /* MICROSECOND */
+            type[n++] = (ArrowFbField){1, 4, 0}; /* timezone */
+            break;
+        default:
+            break;
+        }
+        Tcl_Size tpos[2];
+        ArrowFbPatch(&fb, fpos[3], ArrowFbTable(&fb, type, n, tpos));
+        if (kind == ARROW_TIMESTAMP) {
+            /* The values are UTC instants (zoned types are normalized),
+             * so readers must not take them as local wall-clock times. */
+            ArrowPad(&fb, 4);
+            ArrowFbPatch(&fb, tpos[1], Tcl_DStringLength(&fb));
+            ArrowPutLE(&fb, 3, 4);
+            Tcl_DStringAppend(&fb, "UTC", 4);
+        }
+
+        ArrowPad(&fb, 4);
+        ArrowFbPatch(&fb, fpos[4], Tcl_DStringLength(&fb));
+        ArrowPutLE(&fb, 0, 4); /* no children */
+    }
+
+    ArrowWriteMessage(out, &fb, NULL);
+    Tcl_DStringFree(&fb);
+}
+
+/* Append the pending rows to out as a RecordBatch message and start a new
+ * batch. */
+static void ArrowWriteBatch(Tcl_DString *out, OradpiArrowBatch *ab) {
+    Tcl_DString body, fb;
+    Tcl_Size    mpos[4], rpos[3];
+    Tcl_Size    bitmapLen = (Tcl_Size)((ab->rows + 7) / 8);
+    uint32_t    numBufs   = 0;
+    Tcl_DStringInit(&body);
+    Tcl_DStringInit(&fb);
+
+    for (uint32_t c = 0; c < ab->numCols; c++)
+        numBufs += ArrowIsVarWidth(ab->cols[c].kind) ? 3 : 2;
+    int64_t *bufs = (int64_t *)Tcl_Alloc(2 * (size_t)numBufs * sizeof(int64_t));
+    uint32_t b    = 0;
+    for (uint32_t c = 0; c < ab->numCols; c++) {
+        OradpiArrowCol *col = &ab->cols[c];
+        Tcl_DString    *parts[3];
+        Tcl_Size        lens[3];
+        int             np = 0;
+        parts[np]          = &col->valid;
+        lens[np++]         = col->nullCount ? bitmapLen : 0;
+        parts[np]          = &col->values;
+        lens[np++]         = Tcl_DStringLength(&col->values);
+        if (ArrowIsVarWidth(col->kind)) {
+            parts[np]  = &col->data;
+            lens[np++] = Tcl_DStringLength(&col->data);
+        }
+        for (int p = 0; p < np; p++) {
+            bufs[2 * b]     = (int64_t)Tcl_DStringLength(&body);
+            bufs[2 * b + 1] = (int64_t)lens[p];
+            b++;
+            Tcl_DStringAppend(&body, Tcl_DStringValue(parts[p]), lens[p]);
+            ArrowPad(&body, 8);
+        }
+    }
+
+    ArrowPutLE(&fb, 0, 4); /* root offset */
+    const ArrowFbField msg[] = {{0, 2, ARROW_METADATA_V5}, {1, 1, ARROW_HEADER_RECORDBATCH}, {2, 4, 0}, {3, 8, (uint64_t)Tcl_DStringLength(&body)}};
+    ArrowFbPatch(&fb, 0, ArrowFbTable(&fb, msg, 4, mpos));
+    const ArrowFbField batch[] = {{0, 8, (uint64_t)ab->rows}, {1, 4, 0}, {2, 4, 0}};
+    ArrowFbPatch(&fb, mpos[2], ArrowFbTable(&fb, batch, 3, rpos));
+
+    ArrowFbPatch(&fb, rpos[1], ArrowFbStructVector(&fb, ab->numCols));
+    for (uint32_t c = 0; c < ab->numCols; c++) {
+        ArrowPutLE(&fb, (uint64_t)ab->rows, 8);
+        ArrowPutLE(&fb, (uint64_t)ab->cols[c].nullCount, 8);
+    }
+    ArrowFbPatch(&fb, rpos[2], ArrowFbStructVector(&fb, numBufs));
+    for (uint32_t i = 0; i < 2 * numBufs; i++)
+        ArrowPutLE(&fb, (uint64_t)bufs[i], 8);
+
+    ArrowWriteMessage(out, &fb, &body);
+    Tcl_Free((char *)bufs);
+    Tcl_DStringFree(&fb);
+    Tcl_DStringFree(&body);
+    ArrowBatchReset(ab);
+}
+
+/* End-of-stream marker. */
+static void ArrowWriteEnd(Tcl_DString *out) {
+    ArrowPutLE(out, 0xFFFFFFFFu, 4);
+    ArrowPutLE(out, 0, 4);
+}
+
+static int ExportRow(Tcl_Interp *ip, Tcl_DString *ds, const OradpiExportFmt *fmt, const OradpiFetchCell *row, uint32_t numCols) {
+    if (fmt->arrow)
+        return ArrowAppendRow(ip, fmt->arrow, row);
+    ExportAppendRow(ip, ds, fmt, row, numCols);
+    return ClockZoneCheck(ip);
+}
+
+/* Write up to maxRows rows (0 = all) to chan.  Rows come from the
+ * readahead batch when ra is set, from the define buffers when they
+ * exist, and from dpiStmt_fetch otherwise.  The channel may run Tcl code
+ * (reflected or stacked channels), so writes happen only between batches
+ * and the statement is re-validated after each one. */
+static int FetchToChannel(Tcl_Interp *ip, OradpiStmt *st, dpiStmt *fetchStmt, GlobalConnRec *shared, OradpiReadahead *ra, Tcl_Obj *stmtNameSnap, uint32_t numCols, Tcl_Channel chan,
+                          const OradpiExportFmt *fmt, int header, Tcl_WideInt maxRows, uint64_t *fetchedOut) {
+    Tcl_DString       ds;
+    OradpiFetchCell  *cells       = NULL;
+    size_t            cellBytes   = 0;
+    int               code        = TCL_OK;
+    uint64_t          fetched     = 0;
+    int               moreRows    = 1;
+    dpiData         **varData     = st->fetchVarData;
+    dpiNativeTypeNum *nativeTypes = st->fetchNativeTypes;
+    const int        *isChar      = st->fetchIsChar;
+    /* LOB columns are inlined under the gate, which the view path avoids. */
+    int               snapshotRow = !varData || st->fetchHasLobCols;
+
+    *fetchedOut                   = 0;
+    Tcl_DStringInit(&ds);
+    if (Oradpi_CheckedAllocBytes(ip, (Tcl_Size)numCols, sizeof(*cells), &cellBytes, "export row buffer") != TCL_OK)
+        return TCL_ERROR;
+    cells = (OradpiFetchCell *)Tcl_Alloc(cellBytes);
+    memset(cells, 0, cellBytes);
+
+    if (fmt->arrow)
+        ArrowWriteSchema(&ds, fmt->arrow, st->fetchColNames);
+    else if (header) {
+        const char sep = (fmt->format == EXPORT_CSV) ? ',' : '\t';
+        for (uint32_t c = 0; c < numCols; c++) {
+            Tcl_Size    len  = 0;
+            const char *name = Tcl_GetStringFromObj(st->fetchColNames[c], &len);
+            if (c > 0)
+                Tcl_DStringAppend(&ds, &sep, 1);
+            ExportAppendText(&ds, fmt->format, name, len);
+        }
+        Tcl_DStringAppend(&ds, "\n", 1);
+    }
+
+    while (maxRows == 0 || (Tcl_WideInt)fetched < maxRows) {
+        int batchDone = 0;
+        if (ra) {
+            OradpiFetchCell *raRow = NULL;
+            if (ReadaheadNextRow(ip, st, ra, &raRow) != TCL_OK) {
+                code = TCL_ERROR;
+                break;
+            }
+            if (!raRow)
+                break;
+            if (ExportRow(ip, &ds, fmt, raRow, numCols) != TCL_OK) {
+                code = TCL_ERROR;
+                break;
+            }
+            fetched++;
+            batchDone = (ra->curPos >= ra->curRows);
+        } else if (varData) {
+            uint32_t batchStart = 0, batchCount = 0;
+            uint32_t batchLimit = st->fetchArray;
+            if (!moreRows)
+                break;
+            if (maxRows > 0 && maxRows - (Tcl_WideInt)fetched < (Tcl_WideInt)batchLimit)
+                batchLimit = (uint32_t)(maxRows - (Tcl_WideInt)fetched);
+            Oradpi_SharedConnGateEnter(shared);
+            int fetchRc = FetchRowsLocked(st, fetchStmt, batchLimit, &batchStart, &batchCount, &moreRows);
+            if (fetchRc != DPI_SUCCESS) {
+                Oradpi_SharedConnGateLeave(shared);
+                code = FetchRowsError(ip, st, fetchRc);
+                break;
+            }
+            if (!snapshotRow)
+                Oradpi_SharedConnGateLeave(shared);
+            for (uint32_t r = 0; r < batchCount && code == TCL_OK; r++) {
+                for (uint32_t c = 0; c < numCols; c++) {
+                    const dpiData *d = &varData[c][batchStart + r];
+                    if (!snapshotRow) {
+                        ExportCellView(&cells[c], nativeTypes[c], d, isChar[c]);
+                        continue;
+                    }
+                    const char *where = NULL;
+                    const char *msg   = NULL;
+                    if (SnapshotCellLocked(1, nativeTypes[c], (dpiData *)d, isChar[c], &cells[c], &where, &msg) != TCL_OK) {
+                        code = where ? Oradpi_SetErrorFromODPI(ip, (OradpiBase *)st, where) : Oradpi_SetError(ip, (OradpiBase *)st, -1, msg ? msg : "failed to snapshot fetched value");
+                        break;
+                    }
+                }
+                if (code == TCL_OK)
+                    code = ExportRow(ip, &ds, fmt, cells, numCols);
+                if (snapshotRow) {
+                    FreeFetchCells(cells, (Tcl_Size)numCols, NULL);
+                    memset(cells, 0, cellBytes);
+                }
+            }
+            if (snapshotRow)
+                Oradpi_SharedConnGateLeave(shared);
+            if (code != TCL_OK)
+                break;
+            if (batchCount == 0)
+                break;
+            fetched += batchCount;
+            batchDone = 1;
+        } else {
+            int      hasRow         = 0;
+            uint32_t bufferRowIndex = 0;
+            Oradpi_SharedConnGateEnter(shared);
+            if (dpiStmt_fetch(fetchStmt, &hasRow, &bufferRowIndex) != DPI_SUCCESS) {
+                Oradpi_SharedConnGateLeave(shared);
+                code = Oradpi_SetErrorFromODPI(ip, (OradpiBase *)st, "dpiStmt_fetch");
+                break;
+            }
+            for (uint32_t c = 0; hasRow && c < numCols; c++) {
+                dpiNativeTypeNum nt;
+                dpiData         *d     = NULL;
+                const char      *where = NULL;
+                const char      *msg   = NULL;
+                if (dpiStmt_getQueryValue(fetchStmt, c + 1, &nt, &d) != DPI_SUCCESS) {
+                    code = Oradpi_SetErrorFromODPI(ip, (OradpiBase *)st, "dpiStmt_getQueryValue");
+                    break;
+                }
+                if (SnapshotCellLocked(1, nt, d, isChar[c], &cells[c], &where, &msg) != TCL_OK) {
+                    code = where ? Oradpi_SetErrorFromODPI(ip, (OradpiBase *)st, where) : Oradpi_SetError(ip, (OradpiBase *)st, -1, msg ? msg : "failed to snapshot fetched value");
+                    break;
+                }
+            }
+            Oradpi_SharedConnGateLeave(shared);
+            if (code == TCL_OK && hasRow)
+                code = ExportRow(ip, &ds, fmt, cells, numCols);
+            FreeFetchCells(cells, (Tcl_Size)numCols, NULL);
+            memset(cells, 0, cellBytes);
+            if (code != TCL_OK || !hasRow)
+                break;
+            fetched++;
+            batchDone = fmt->arrow ? (fmt->arrow->rows >= (int64_t)(st->fetchArray ? st->fetchArray : DPI_DEFAULT_FETCH_ARRAY_SIZE)) : (Tcl_DStringLength(&ds) >= ORADPI_EXPORT_FLUSH_BYTES);
+        }
+
+        if (batchDone) {
+            if (fmt->arrow && fmt->arrow->rows > 0)
+                ArrowWriteBatch(&ds, fmt->arrow);
+            if (ExportFlush(ip, chan, &ds, fmt->arrow != NULL) != TCL_OK) {
+                code = TCL_ERROR;
+                break;
+            }
+            if (!Oradpi_LookupStmt(ip, stmtNameSnap)) {
+                code = Oradpi_SetError(ip, NULL, -1, "orafetch: statement closed during channel write");
+                break;
+            }
+            if (st->fetchVarData != varData || (ra && ra->discarded)) {
+                code = Oradpi_SetError(ip, (OradpiBase *)st, -1, "orafetch: statement re-parsed or reconfigured during channel write");
+                break;
+            }
+        }
+    }
+
+    if (code == TCL_OK && fmt->arrow) {
+        if (fmt->arrow->rows > 0)
+            ArrowWriteBatch(&ds, fmt->arrow);
+        ArrowWriteEnd(&ds);
+    }
+    if (code == TCL_OK)
+        code = ExportFlush(ip, chan, &ds, fmt->arrow != NULL);
+    Tcl_DStringFree(&ds);
+    Tcl_Free((char *)cells);
+    *fetchedOut = fetched;
+    return code;
+}
+
+/* ==========================================================================
+ * Lazy row lists (orafetch -lazy)
+ *
+ * Rows are kept encoded, one tagged field after another, and are turned
+ * into Tcl_Objs only when an element of the list is asked for.  The list
+ * is a Tcl 9 abstract list: llength, lindex and foreach read it in place;
+ * any command that modifies it converts it to an ordinary list first.
+ * Encoded rows beyond the memory budget go to an anonymous temporary
+ * file.  The object, like any Tcl_Obj, stays in the creating thread.
+ * ========================================================================== */
+
+enum { LAZY_NULL, LAZY_INT64, LAZY_UINT64, LAZY_FLOAT, LAZY_DOUBLE, LAZY_BOOLEAN, LAZY_TIMESTAMP, LAZY_TEXT, LAZY_BINARY };
+
+#define ORADPI_LAZY_SPILL_BYTES 65536
+
+typedef struct OradpiLazyRows {
+    size_t         refCount; /* internal reps sharing the rows */
+    uint32_t       numCols;
+    Tcl_Size       numRows;
+    Tcl_Obj      **colNames; /* [numCols] with -asdict, else NULL */
+    unsigned char *dateFmt;  /* [numCols] or NULL (ISO) */
+    uint64_t      *rowOff;   /* [numRows + 1] offset of each encoded row */
+    Tcl_Size       rowCap;
+    size_t         budget; /* 0 = no limit */
+    char          *mem;    /* offsets [0, memLen) */
+    size_t         memLen, memCap;
+    Tcl_Channel    spill; /* offsets [memLen, ...) once the budget is reached */
+    char          *wbuf;  /* spill writes not yet flushed */
+    size_t         wbufLen, wbufCap;
+    const char    *spillMap;  /* the finished spill file, mapped read-only */
+    size_t         spillLen;
+    int            spillHeap; /* spillMap was read into memory, not mapped */
+} OradpiLazyRows;
+
+static void LazyRowsRelease(OradpiLazyRows *lr) {
+    if (--lr->refCount > 0)
+        return;
+    if (lr->colNames) {
+        for (uint32_t c = 0; c < lr->numCols; c++)
+            Tcl_DecrRefCount(lr->colNames[c]);
+        Tcl_Free((char *)lr->colNames);
+    }
+    if (lr->spill)
+        Tcl_Close(NULL, lr->spill);
+    if (lr->spillMap && lr->spillHeap)
+        Tcl_Free((char *)lr->spillMap);
+    else if (lr->spillMap) {
+#ifdef _WIN32
+        UnmapViewOfFile(lr->spillMap);
+#else
+        munmap((void *)lr->spillMap, lr->spillLen);
+#endif
+    }
+    if (lr->dateFmt)
+        Tcl_Free((char *)lr->dateFmt);
+    if (lr->rowOff)
+        Tcl_Free((char *)lr->rowOff);
+    if (lr->mem)
+        Tcl_Free(lr->mem);
+    if (lr->wbuf)
+        Tcl_Free(lr->wbuf);
+    Tcl_Free((char *)lr);
+}
+
+static OradpiLazyRows *LazyRowsNew(uint32_t numCols, Tcl_Obj *const *colNames, const unsigned char *dateFmt, size_t budget) {
+    OradpiLazyRows *lr = (OradpiLazyRows *)Tcl_Alloc(sizeof(*lr));
+    memset(lr, 0, sizeof(*lr));
+    lr->refCount = 1;
+    lr->numCols  = numCols;
+    lr->budget   = budget;
+    if (colNames) {
+        lr->colNames = (Tcl_Obj **)Tcl_Alloc(numCols * sizeof(Tcl_Obj *));
+        for (uint32_t c = 0; c < numCols; c++) {
+            lr->colNames[c] = colNames[c];
+            Tcl_IncrRefCount(lr->colNames[c]);
+        }
+    }
+    if (dateFmt) {
+        lr->dateFmt = (unsigned char *)Tcl_Alloc(numCols);
+        memcpy(lr->dateFmt, dateFmt, numCols);
+    }
+    lr->rowCap = 64;
+    lr->rowOff = (uint64_t *)Tcl_Alloc((size_t)lr->rowCap * sizeof(uint64_t));
+    lr->rowOff[0] = 0;
+    return lr;
+}
+
+static size_t LazyCellSize(const OradpiFetchCell *cell) {
+    if (cell->isNull)
+        return 1;
+    switch (cell->nt) {
+    case DPI_NATIVE_TYPE_INT64:
+    case DPI_NATIVE_TYPE_UINT64:
+    case DPI_NATIVE_TYPE_DOUBLE:
+        return 1 + 8;
+    case DPI_NATIVE_TYPE_FLOAT:
+        return 1 + sizeof(float);
+    case DPI_NATIVE_TYPE_BOOLEAN:
+        return 2;
+    case DPI_NATIVE_TYPE_TIMESTAMP:
+        return 1 + sizeof(dpiTimestamp);
+    case DPI_NATIVE_TYPE_BYTES:
+    case DPI_NATIVE_TYPE_LOB:
+        return 1 + sizeof(uint32_t) + (size_t)cell->bytesLen;
+    default:
+        return 1;
+    }
+}
+
+static char *LazyCellPut(char *p, const OradpiFetchCell *cell) {
+    if (cell->isNull) {
+        *p++ = LAZY_NULL;
+        return p;
+    }
+    switch (cell->nt) {
+    case DPI_NATIVE_TYPE_INT64:
+        *p++ = LAZY_INT64;
+        memcpy(p, &cell->scalar.i64, 8);
+        return p + 8;
+    case DPI_NATIVE_TYPE_UINT64:
+        *p++ = LAZY_UINT64;
+        memcpy(p, &cell->scalar.u64, 8);
+        return p + 8;
+    case DPI_NATIVE_TYPE_FLOAT:
+        *p++ = LAZY_FLOAT;
+        memcpy(p, &cell->scalar.f32, sizeof(float));
+        return p + sizeof(float);
+    case DPI_NATIVE_TYPE_DOUBLE:
+        *p++ = LAZY_DOUBLE;
+        memcpy(p, &cell->scalar.f64, 8);
+        return p + 8;
+    case DPI_NATIVE_TYPE_BOOLEAN:
+        *p++ = LAZY_BOOLEAN;
+        *p++ = (char)(cell->scalar.boolean ? 1 : 0);
+        return p;
+    case DPI_NATIVE_TYPE_TIMESTAMP:
+        *p++ = LAZY_TIMESTAMP;
+        memcpy(p, &cell->scalar.ts, sizeof(dpiTimestamp));
+        return p + sizeof(dpiTimestamp);
+    case DPI_NATIVE_TYPE_BYTES:
+    case DPI_NATIVE_TYPE_LOB: {
+        uint32_t len = (uint32_t)cell->bytesLen;
+        *p++         = (char)(cell->colIsChar ? LAZY_TEXT : LAZY_BINARY);
+        memcpy(p, &len, sizeof(len));
+        p += sizeof(len);
+        if (len)
+            memcpy(p, cell->bytes, len);
+        return p + len;
+    }
+    default:
+        *p++ = LAZY_NULL;
+        return p;
+    }
+}
+
+static char *LazyReserve(char **buf, size_t *len, size_t *cap, size_t n) {
+    if (*len + n > *cap) {
+        size_t want = *cap ? *cap : 4096;
+        while (want < *len + n)
+            want *= 2;
+        *buf = (char *)Tcl_Realloc(*buf, want);
+        *cap = want;
+    }
+    char *p = *buf + *len;
+    *len += n;
+    return p;
+}
+
+static int LazyFlushSpill(Tcl_Interp *ip, OradpiLazyRows *lr) {
+    if (lr->wbufLen == 0)
+        return TCL_OK;
+    Tcl_Size written = Tcl_Write(lr->spill, lr->wbuf, (Tcl_Size)lr->wbufLen);
+    lr->wbufLen      = 0;
+    if (written < 0) {
+        Tcl_SetObjResult(ip, Tcl_ObjPrintf("orafetch: error writing the -lazy spill file: %s", Tcl_PosixError(ip)));
+        return TCL_ERROR;
+    }
+    return TCL_OK;
+}
+
+/* "clock" dates are stored as the seconds value, so the zone in effect
+ * during the fetch applies however late a row is read. */
+static const OradpiFetchCell *LazyCellPrepare(const OradpiLazyRows *lr, const OradpiFetchCell *cell, uint32_t c, OradpiFetchCell *tmp) {
+    if (cell->isNull || cell->nt != DPI_NATIVE_TYPE_TIMESTAMP || DateFmtAt(lr->dateFmt, c) != ORADPI_DATEFMT_CLOCK)
+        return cell;
+    *tmp            = *cell;
+    tmp->nt         = DPI_NATIVE_TYPE_INT64;
+    tmp->scalar.i64 = TimestampToClockSeconds(&cell->scalar.ts);
+    return tmp;
+}
+
+/* Encode one row (LOB cells inlined) at the end of the list; an
+ * OradpiRowSinkProc. */
+static int LazyRowsAppend(Tcl_Interp *ip, void *sink, const OradpiFetchCell *row) {
+    OradpiLazyRows *lr   = (OradpiLazyRows *)sink;
+    size_t          need = 0;
+    OradpiFetchCell tmp;
+    for (uint32_t c = 0; c < lr->numCols; c++) {
+        if (row[c].lob)
+            return Oradpi_SetError(ip, NULL, -1, "orafetch: -lazy cannot hold LOB locators");
+        if ((uint64_t)row[c].bytesLen > UINT32_MAX)
+            return Oradpi_SetError(ip, NULL, -1, "orafetch: fetched value is too large for -lazy");
+        need += LazyCellSize(LazyCellPrepare(lr, &row[c], c, &tmp));
+    }
+    if (ClockZoneCheck(ip) != TCL_OK)
+        return TCL_ERROR;
+    if (lr->numRows + 1 >= lr->rowCap) {
+        lr->rowCap *= 2;
+        lr->rowOff = (uint64_t *)Tcl_Realloc((char *)lr->rowOff, (size_t)lr->rowCap * sizeof(uint64_t));
+    }
+
+    if (!lr->spill && lr->budget && lr->memLen + need > lr->budget) {
+        lr->spill = Tcl_OpenTemporaryFile(ip, NULL, NULL, NULL, NULL);
+        if (!lr->spill)
+            return TCL_ERROR;
+        if (Tcl_SetChannelOption(ip, lr->spill, "-translation", "binary") != TCL_OK)
+            return TCL_ERROR;
+        /* The budget is reached: the in-memory part is final. */
+        if (lr->memCap > lr->memLen) {
+            lr->mem    = (char *)Tcl_Realloc(lr->mem, lr->memLen ? lr->memLen : 1);
+            lr->memCap = lr->memLen;
+        }
+    }
+
+    char *p;
+    if (lr->spill)
+        p = LazyReserve(&lr->wbuf, &lr->wbufLen, &lr->wbufCap, need);
+    else
+        p = LazyReserve(&lr->mem, &lr->memLen, &lr->memCap, need);
+    for (uint32_t c = 0; c < lr->numCols; c++)
+        p = LazyCellPut(p, LazyCellPrepare(lr, &row[c], c, &tmp));
+
+    lr->rowOff[lr->numRows + 1] = lr->rowOff[lr->numRows] + need;
+    lr->numRows++;
+    if (lr->spill && lr->wbufLen >= ORADPI_LAZY_SPILL_BYTES)
+        return LazyFlushSpill(ip, lr);
+    return TCL_OK;
+}
+
+/* Map the flushed spill file read-only; the mapping outlives the
+ * channel.  Returns NULL when the platform will not map it. */
+static const char *LazySpillMap(Tcl_Channel chan, size_t len) {
+    ClientData handle = NULL;
+    if (Tcl_GetChannelHandle(chan, TCL_READABLE, &handle) != TCL_OK)
+        return NULL;
+#ifdef _WIN32
+    HANDLE      mh  = CreateFileMappingW((HANDLE)handle, NULL, PAGE_READONLY, 0, 0, NULL);
+    const char *map = NULL;
+    if (mh) {
+        map = (const char *)MapViewOfFile(mh, FILE_MAP_READ, 0, 0, len);
+        CloseHandle(mh);
+    }
+    return map;
+#else
+    void *map = mmap(NULL, len, PROT_READ, MAP_PRIVATE, (int)(intptr_t)handle, 0);
+    return map == MAP_FAILED ? NULL : (const char *)map;
+#endif
+}
+
+/* Done appending: flush what is left for the spill file, then map it (or,
+ * failing that, read it back into memory) and close it, so reading rows
+ * later cannot fail. */
+static int LazyRowsFinish(Tcl_Interp *ip, OradpiLazyRows *lr) {
+    if (!lr->spill)
+        return TCL_OK;
+    if (LazyFlushSpill(ip, lr) != TCL_OK)
+        return TCL_ERROR;
+    if (Tcl_Flush(lr->spill) != TCL_OK) {
+        Tcl_SetObjResult(ip, Tcl_ObjPrintf("orafetch: error writing the -lazy spill file: %s", Tcl_PosixError(ip)));
+        return TCL_ERROR;
+    }
+    if (lr->wbuf) {
+        Tcl_Free(lr->wbuf);
+        lr->wbuf    = NULL;
+        lr->wbufCap = 0;
+    }
+
+    uint64_t spilled = lr->rowOff[lr->numRows] - lr->memLen;
+    if (spilled > (uint64_t)SIZE_MAX)
+        return Oradpi_SetError(ip, NULL, -1, "orafetch: -lazy spill file is too large to map");
+    lr->spillLen = (size_t)spilled;
+    if (lr->spillLen && !(lr->spillMap = LazySpillMap(lr->spill, lr->spillLen))) {
+        char *buf = (char *)Tcl_AttemptAlloc(lr->spillLen);
+        if (!buf)
+            return Oradpi_SetError(ip, NULL, -1, "orafetch: cannot map or load the -lazy spill file");
+        if (Tcl_Seek(lr->spill, 0, SEEK_SET) < 0 || Tcl_Read(lr->spill, buf, (Tcl_Size)lr->spillLen) != (Tcl_Size)lr->spillLen) {
+            Tcl_Free(buf);
+            Tcl_SetObjResult(ip, Tcl_ObjPrintf("orafetch: error reading the -lazy spill file: %s", Tcl_PosixError(ip)));
+            return TCL_ERROR;
+        }
+        lr->spillMap  = buf;
+        lr->spillHeap = 1;
+    }
+    Tcl_Close(NULL, lr->spill);
+    lr->spill = NULL;
+    return TCL_OK;
+}
+
+/* Decode row i into a new list (refcount 0).  Rows live in memory or in
+ * the mapped spill file, so this cannot fail. */
+static Tcl_Obj *LazyRowsRow(const OradpiLazyRows *lr, Tcl_Size i) {
+    uint64_t    off = lr->rowOff[i];
+    const char *p   = off < lr->memLen ? lr->mem + off : lr->spillMap + (off - lr->memLen);
+
+    Tcl_Obj *row = Tcl_NewListObj(0, NULL);
+    for (uint32_t c = 0; c < lr->numCols; c++) {
+        Tcl_Obj *v;
+        int      tag = (unsigned char)*p++;
+        switch (tag) {
+        case LAZY_INT64: {
+            int64_t x;
+            memcpy(&x, p, 8);
+            p += 8;
+            v = Int64ToObj(x);
+            break;
+        }
+        case LAZY_UINT64: {
+            uint64_t x;
+            memcpy(&x, p, 8);
+            p += 8;
+            v = UInt64ToObj(x);
+            break;
+        }
+        case LAZY_FLOAT: {
+            float x;
+            memcpy(&x, p, sizeof(float));
+            p += sizeof(float);
+            v = DoubleToObj((double)x);
+            break;
+        }
+        case LAZY_DOUBLE: {
+            double x;
+            memcpy(&x, p, 8);
+            p += 8;
+            v = DoubleToObj(x);
+            break;
+        }
+        case LAZY_BOOLEAN:
+            v = Tcl_NewBooleanObj(*p++ ? 1 : 0);
+            break;
+        case LAZY_TIMESTAMP: {
+            dpiTimestamp ts;
+            memcpy(&ts, p, sizeof(ts));
+            p += sizeof(ts);
+            v = TimestampToObj(&ts, DateFmtAt(lr->dateFmt, c));
+            break;
+        }
+        case LAZY_TEXT:
+        case LAZY_BINARY: {
+            uint32_t n;
+            memcpy(&n, p, sizeof(n));
+            p += sizeof(n);
+            v = BytesToObj(p, (Tcl_Size)n, tag == LAZY_TEXT);
+            p += n;
+            break;
+        }
+        default:
+            v = Tcl_NewObj();
+            break;
+        }
+        if (lr->colNames)
+            Tcl_ListObjAppendElement(NULL, row, lr->colNames[c]);
+        Tcl_ListObjAppendElement(NULL, row, v);
+    }
+    return row;
+}
+
+static void LazyListFreeIntRep(Tcl_Obj *obj);
+static void LazyListDupIntRep(Tcl_Obj *src, Tcl_Obj *dup);
+static void LazyListUpdateString(Tcl_Obj *obj);
+static Tcl_Size LazyListLength(Tcl_Obj *obj);
+static int LazyListIndex(Tcl_Interp *ip, Tcl_Obj *obj, Tcl_Size index, Tcl_Obj **elemOut);
+
+static const Tcl_ObjType lazyListType = {
+    "oradpi-rows",
+    LazyListFreeIntRep,
+    LazyListDupIntRep,
+    LazyListUpdateString,
+    NULL,
+    TCL_OBJTYPE_V2(LazyListLength, LazyListIndex, NULL, NULL, NULL, NULL, NULL, NULL)};
+
+static OradpiLazyRows *LazyListRows(Tcl_Obj *obj) {
+    const Tcl_ObjInternalRep *ir = Tcl_FetchInternalRep(obj, &lazyListType);
+    return ir ? (OradpiLazyRows *)ir->twoPtrValue.ptr1 : NULL;
+}
+
+static void LazyListFreeIntRep(Tcl_Obj *obj) {
+    LazyRowsRelease(LazyListRows(obj));
+}
+
+static void LazyListDupIntRep(Tcl_Obj *src, Tcl_Obj *dup) {
+    OradpiLazyRows    *lr = LazyListRows(src);
+    Tcl_ObjInternalRep ir;
+    lr->refCount++;
+    ir.twoPtrValue.ptr1 = lr;
+    ir.twoPtrValue.ptr2 = NULL;
+    Tcl_StoreInternalRep(dup, &lazyListType, &ir);
+}
+
+/* The string of the whole list, built one row at a time. */
+static void LazyListUpdateString(Tcl_Obj *obj) {
+    OradpiLazyRows *lr = LazyListRows(obj);
+    Tcl_DString     ds;
+    Tcl_DStringInit(&ds);
+    for (Tcl_Size i = 0; i < lr->numRows; i++) {
+        Tcl_Obj *row = LazyRowsRow(lr, i);
+        Tcl_IncrRefCount(row);
+        Tcl_DStringAppendElement(&ds, Tcl_GetString(row));
+        Tcl_DecrRefCount(row);
+    }
+    Tcl_InitStringRep(obj, Tcl_DStringValue(&ds), (size_t)Tcl_DStringLength(&ds));
+    Tcl_DStringFree(&ds);
+}
+
+static Tcl_Size LazyListLength(Tcl_Obj *obj) {
+    return LazyListRows(obj)->numRows;
+}
+
+static int LazyListIndex(Tcl_Interp *ip, Tcl_Obj *obj, Tcl_Size index, Tcl_Obj **elemOut) {
+    OradpiLazyRows *lr = LazyListRows(obj);
+    if (index < 0 || index >= lr->numRows) {
+        *elemOut = NULL;
+        return TCL_OK;
+    }
+    *elemOut = LazyRowsRow(lr, index);
+    return TCL_OK;
+}
+
+/* Wrap lr (taking over its reference) in a new list object. */
+static Tcl_Obj *LazyListNewObj(OradpiLazyRows *lr) {
+    Tcl_Obj           *obj = Tcl_NewObj();
+    Tcl_ObjInternalRep ir;
+    Tcl_InvalidateStringRep(obj);
+    ir.twoPtrValue.ptr1 = lr;
+    ir.twoPtrValue.ptr2 = NULL;
+    Tcl_StoreInternalRep(obj, &lazyListType, &ir);
+    return obj;
+}
+
+/* Hand up to maxRows rows (0 = all) to sinkProc, from the same sources as
+ * FetchToChannel, with LOB columns inlined.  The cells are only valid for
+ * the call; no Tcl code may run in it. */
+static int FetchCellRows(Tcl_Interp *ip, OradpiStmt *st, dpiStmt *fetchStmt, GlobalConnRec *shared, OradpiReadahead *ra, uint32_t numCols, OradpiRowSinkProc *sinkProc, void *sink, Tcl_WideInt maxRows, uint64_t *fetchedOut) {
+    OradpiFetchCell  *cells       = NULL;
+    size_t            cellBytes   = 0;
+    int               code        = TCL_OK;
+    uint64_t          fetched     = 0;
+    int               moreRows    = 1;
+    dpiData         **varData     = st->fetchVarData;
+    dpiNativeTypeNum *nativeTypes = st->fetchNativeTypes;
+    const int        *isChar      = st->fetchIsChar;
+    int               snapshotRow = !varData || st->fetchHasLobCols;
+
+    *fetchedOut                   = 0;
+    if (Oradpi_CheckedAllocBytes(ip, (Tcl_Size)numCols, sizeof(*cells), &cellBytes, "row buffer") != TCL_OK)
+        return TCL_ERROR;
+    cells = (OradpiFetchCell *)Tcl_Alloc(cellBytes);
+    memset(cells, 0, cellBytes);
+
+    while (code == TCL_OK && (maxRows == 0 || (Tcl_WideInt)fetched < maxRows)) {
+        if (ra) {
+            OradpiFetchCell *raRow = NULL;
+            if (ReadaheadNextRow(ip, st, ra, &raRow) != TCL_OK) {
+                code = TCL_ERROR;
+                break;
+            }
+            if (!raRow)
+                break;
+            code = sinkProc(ip, sink, raRow);
+            fetched++;
+        } else if (varData) {
+            uint32_t batchStart = 0, batchCount = 0;
+            uint32_t batchLimit = st->fetchArray;
+            if (!moreRows)
+                break;
+            if (maxRows > 0 && maxRows - (Tcl_WideInt)fetched < (Tcl_WideInt)batchLimit)
+                batchLimit = (uint32_t)(maxRows - (Tcl_WideInt)fetched);
+            Oradpi_SharedConnGateEnter(shared);
+            int fetchRc = FetchRowsLocked(st, fetchStmt, batchLimit, &batchStart, &batchCount, &moreRows);
+            if (fetchRc != DPI_SUCCESS) {
+                Oradpi_SharedConnGateLeave(shared);
+                code = FetchRowsError(ip, st, fetchRc);
+                break;
+            }
+            if (!snapshotRow)
+                Oradpi_SharedConnGateLeave(shared);
+            for (uint32_t r = 0; r < batchCount && code == TCL_OK; r++) {
+                for (uint32_t c = 0; c < numCols; c++) {
+                    const dpiData *d = &varData[c][batchStart + r];
+                    if (!snapshotRow) {
+                        ExportCellView(&cells[c], nativeTypes[c], d, isChar[c]);
+                        continue;
+                    }
+                    const char *where = NULL;
+                    const char *msg   = NULL;
+                    if (SnapshotCellLocked(1, nativeTypes[c], (dpiData *)d, isChar[c], &cells[c], &where, &msg) != TCL_OK) {
+                        code = where ? Oradpi_SetErrorFromODPI(ip, (OradpiBase *)st, where) : Oradpi_SetError(ip, (OradpiBase *)st, -1, msg ? msg : "failed to snapshot fetched value");
+                        break;
+                    }
+                }
+                if (code == TCL_OK)
+                    code = sinkProc(ip, sink, cells);
+                if (snapshotRow) {
+                    FreeFetchCells(cells, (Tcl_Size)numCols, NULL);
+                    memset(cells, 0, cellBytes);
+                }
+            }
+            if (snapshotRow)
+                Oradpi_SharedConnGateLeave(shared);
+            if (batchCount == 0)
+                break;
+            fetched += batchCount;
+        } else {
+            int      hasRow         = 0;
+            uint32_t bufferRowIndex = 0;
+            Oradpi_SharedConnGateEnter(shared);
+            if (dpiStmt_fetch(fetchStmt, &hasRow, &bufferRowIndex) != DPI_SUCCESS) {
+                Oradpi_SharedConnGateLeave(shared);
+                code = Oradpi_SetErrorFromODPI(ip, (OradpiBase *)st, "dpiStmt_fetch");
+                break;
+            }
+            for (uint32_t c = 0; hasRow && c < numCols; c++) {
+                dpiNativeTypeNum nt;
+                dpiData         *d     = NULL;
+                const char      *where = NULL;
+                const char      *msg   = NULL;
+                if (dpiStmt_getQueryValue(fetchStmt, c + 1, &nt, &d) != DPI_SUCCESS) {
+                    code = Oradpi_SetErrorFromODPI(ip, (OradpiBase *)st, "dpiStmt_getQueryValue");
+                    break;
+                }
+                if (SnapshotCellLocked(1, nt, d, isChar[c], &cells[c], &where, &msg) != TCL_OK) {
+                    code = where ? Oradpi_SetErrorFromODPI(ip, (OradpiBase *)st, where) : Oradpi_SetError(ip, (OradpiBase *)st, -1, msg ? msg : "failed to snapshot fetched value");
+                    break;
+                }
+            }
+            Oradpi_SharedConnGateLeave(shared);
+            if (code == TCL_OK && hasRow)
+                code = sinkProc(ip, sink, cells);
+            FreeFetchCells(cells, (Tcl_Size)numCols, NULL);
+            memset(cells, 0, cellBytes);
+            if (!hasRow)
+                break;
+            fetched++;
+        }
+    }
+
+    Tcl_Free((char *)cells);
+    *fetchedOut = fetched;
+    return code;
+}
+
+/* ==========================================================================
+ * Column names
+ *
+ * Upper-cased column names and "-indexbynumber" keys are shared per
+ * interp, and a statement re-parsed with its own SQL text keeps its
+ * define variables (Oradpi_FetchCacheReparse).  Column descriptions are
+ * read from each cursor: dpiStmt_getQueryInfo is local once the cursor
+ * has been executed, and a description reused from another session or
+ * an earlier parse could not be trusted without reading it again.
+ * ========================================================================== */
+
+#define ORADPI_FETCHNAMES_MAX 4096
+
+/* The interp's upper-cased Tcl_Obj for a column name, with a reference
+ * for the caller.  Names beyond ORADPI_FETCHNAMES_MAX are not pooled. */
+static Tcl_Obj *FetchNameObj(Tcl_Interp *ip, const char *name, uint32_t nameLen) {
+    OradpiInterpState *is = ip ? Oradpi_GetInterpState(ip) : NULL;
+    Tcl_Obj           *o  = NULL;
+    if (!is || is->fetchNames.numEntries >= ORADPI_FETCHNAMES_MAX) {
+        o = nameLen ? upper_copy(name, nameLen) : Tcl_NewStringObj("", 0);
+        Tcl_IncrRefCount(o);
+        return o;
+    }
+    int            isNew;
+    Tcl_HashEntry *he = Tcl_CreateHashEntry(&is->fetchNames, nameLen ? name : "", &isNew);
+    if (isNew) {
+        o = nameLen ? upper_copy(name, nameLen) : Tcl_NewStringObj("", 0);
+        Tcl_IncrRefCount(o);
+        Tcl_SetHashValue(he, o);
+    }
+    o = (Tcl_Obj *)Tcl_GetHashValue(he);
+    Tcl_IncrRefCount(o);
+    return o;
+}
+
+/* The interp's "c" key object for column c, with a reference for the
+ * caller. */
+static Tcl_Obj *FetchNumberKeyObj(Tcl_Interp *ip, uint32_t c) {
+    OradpiInterpState *is = ip ? Oradpi_GetInterpState(ip) : NULL;
+    Tcl_Obj           *o;
+    if (!is) {
+        o = Tcl_ObjPrintf("%u", c);
+        Tcl_IncrRefCount(o);
+        return o;
+    }
+    if (c >= is->numFetchNumberKeys) {
+        uint32_t n          = c + 1;
+        is->fetchNumberKeys = (Tcl_Obj **)Tcl_Realloc((char *)is->fetchNumberKeys, n * sizeof(Tcl_Obj *));
+        for (uint32_t i = is->numFetchNumberKeys; i < n; i++) {
+            is->fetchNumberKeys[i] = Tcl_ObjPrintf("%u", i);
+            Tcl_IncrRefCount(is->fetchNumberKeys[i]);
+        }
+        is->numFetchNumberKeys = n;
+    }
+    o = is->fetchNumberKeys[c];
+    Tcl_IncrRefCount(o);
+    return o;
+}
+
+void Oradpi_FreeFetchNames(OradpiInterpState *is) {
+    Tcl_HashSearch search;
+    for (Tcl_HashEntry *he = Tcl_FirstHashEntry(&is->fetchNames, &search); he; he = Tcl_NextHashEntry(&search))
+        Tcl_DecrRefCount((Tcl_Obj *)Tcl_GetHashValue(he));
+    Tcl_DeleteHashTable(&is->fetchNames);
+    for (uint32_t i = 0; i < is->numFetchNumberKeys; i++)
+        Tcl_DecrRefCount(is->fetchNumberKeys[i]);
+    if (is->fetchNumberKeys)
+        Tcl_Free((char *)is->fetchNumberKeys);
+    is->fetchNumberKeys    = NULL;
+    is->numFetchNumberKeys = 0;
+}
+
+/* Re-parse: a statement prepared again with the SQL text its fetch cache
+ * was built for keeps the cache, and its define variables are defined on
+ * the new cursor by the next orafetch.  Any other text drops the cache.
+ * Same gate rule as Oradpi_ReadaheadDiscard. */
+void Oradpi_FetchCacheReparse(OradpiStmt *s, const char *sql, Tcl_Size sqlLen) {
+    Oradpi_ReadaheadDiscard(s);
+    if (s)
+        s->rcSubscrStmt = 0;
+    if (s && s->fetchCacheNumCols && s->fetchVars && s->sqlText) {
+        Tcl_Size    oldLen = 0;
+        const char *old    = Tcl_GetStringFromObj(s->sqlText, &oldLen);
+        if (oldLen == sqlLen && memcmp(old, sql, (size_t)sqlLen) == 0) {
+            s->fetchRedefine = 1;
+            return;
+        }
+    }
+    Oradpi_FreeFetchCache(s);
+}
+
+/* Describe the result columns and choose their defines: NUMBER text
+ * (exactNumbers), LOBs read as LONG (inlineLobMax) and the statement's
+ * coltypes.  *colDateFmtOut is Tcl_Alloc'd when coltypes is set. */
+static int FetchColumnPlan(Tcl_Interp *ip, OradpiStmt *st, uint32_t numCols, OradpiFetchColMeta *meta, unsigned char **colDateFmtOut) {
+    *colDateFmtOut = NULL;
+    if (SnapshotColumnMeta(ip, st, numCols, meta) != TCL_OK)
+        return TCL_ERROR;
+    if (st->owner->exactNumbers)
+        SelectNumberDefines(meta, numCols);
+    SelectLobDefines(meta, numCols, st->owner->inlineLobMax);
+    if (st->colTypes) {
+        unsigned char *colDateFmt = (unsigned char *)Tcl_Alloc(numCols);
+        memset(colDateFmt, DATEFMT_NONE, numCols);
+        if (ApplyColTypes(ip, st, numCols, meta, colDateFmt) != TCL_OK) {
+            Tcl_Free((char *)colDateFmt);
+            return TCL_ERROR;
+        }
+        *colDateFmtOut = colDateFmt;
+    }
+    return TCL_OK;
+}
+
+/* Nonzero when the planned columns would build the fetch cache st holds:
+ * same names, the same define type and size, and the same NUMBER, LOB,
+ * time zone and coltypes choices. */
+static int FetchPlanMatches(Tcl_Interp *ip, const OradpiStmt *st, uint32_t numCols, const OradpiFetchColMeta *meta, const unsigned char *colDateFmt) {
+    if (numCols != st->fetchCacheNumCols || !st->fetchVars || !colDateFmt != !st->fetchDateFmt)
+        return 0;
+    for (uint32_t c = 0; c < numCols; c++) {
+        uint32_t size = meta[c].longLob ? ORADPI_LONGLOB_DEFINE_BYTES : meta[c].clientSizeInBytes;
+        if (meta[c].oracleTypeNum != st->fetchOracleTypes[c] || meta[c].defaultNativeTypeNum != st->fetchNativeTypes[c] ||
+            size != st->fetchDefineSizes[c] || meta[c].isChar != st->fetchIsChar[c] ||
+            meta[c].numText != (st->fetchNumText ? st->fetchNumText[c] : 0) || meta[c].longLob != (st->fetchLongLob ? st->fetchLongLob[c] : 0) ||
+            IsZonedTimestampType(meta[c].oracleTypeNum) != (st->fetchDateTz ? st->fetchDateTz[c] : 0) ||
+            (colDateFmt && colDateFmt[c] != st->fetchDateFmt[c]))
+            return 0;
+        Tcl_Obj *name = FetchNameObj(ip, meta[c].name, meta[c].nameLen);
+        int      same = strcmp(Tcl_GetString(name), Tcl_GetString(st->fetchColNames[c])) == 0;
+        Tcl_DecrRefCount(name);
+        if (!same)
+            return 0;
+    }
+    return !st->fetchLongLob || st->fetchLobMax == st->owner->inlineLobMax;
+}
+
+/* Define a kept fetch cache on the re-parsed cursor once it has been
+ * executed.  The columns are described again (dpiStmt_getQueryInfo is
+ * local) and planned as BuildFetchCache would; a result of another shape,
+ * or one that connection settings now define differently, drops the
+ * cache, so the caller rebuilds it. */
+static int FetchCacheRedefine(Tcl_Interp *ip, OradpiStmt *st) {
+    uint32_t            numCols    = 0;
+    int                 ok         = 1;
+    OradpiFetchColMeta *meta       = NULL;
+    unsigned char      *colDateFmt = NULL;
+    size_t              metaBytes  = 0;
+    st->fetchRedefine              = 0;
+    CONN_GATE_ENTER(st->owner);
+    if (dpiStmt_getNumQueryColumns(st->stmt, &numCols) != DPI_SUCCESS) {
+        CONN_GATE_LEAVE(st->owner);
+        Oradpi_FreeFetchCache(st);
+        return Oradpi_SetErrorFromODPI(ip, (OradpiBase *)st, "dpiStmt_getNumQueryColumns");
+    }
+    CONN_GATE_LEAVE(st->owner);
+    if (numCols != st->fetchCacheNumCols) {
+        Oradpi_FreeFetchCache(st);
+        return TCL_OK;
+    }
+
+    if (Oradpi_CheckedAllocBytes(ip, (Tcl_Size)numCols, sizeof(*meta), &metaBytes, "column metadata snapshot") != TCL_OK) {
+        Oradpi_FreeFetchCache(st);
+        return TCL_ERROR;
+    }
+    meta = (OradpiFetchColMeta *)Tcl_Alloc(metaBytes);
+    memset(meta, 0, metaBytes);
+    if (FetchColumnPlan(ip, st, numCols, meta, &colDateFmt) != TCL_OK) {
+        FreeFetchMeta(meta, (Tcl_Size)numCols);
+        Oradpi_FreeFetchCache(st);
+        return TCL_ERROR;
+    }
+    ok = FetchPlanMatches(ip, st, numCols, meta, colDateFmt);
+    FreeFetchMeta(meta, (Tcl_Size)numCols);
+    if (colDateFmt)
+        Tcl_Free((char *)colDateFmt);
+
+    if (ok) {
+        CONN_GATE_ENTER(st->owner);
+        if (dpiStmt_setFetchArraySize(st->stmt, st->fetchArray) != DPI_SUCCESS)
+            ok = 0;
+        for (uint32_t c = 0; c < numCols && ok; c++)
+            if (dpiStmt_define(st->stmt, c + 1, st->fetchVars[c]) != DPI_SUCCESS)
+                ok = 0;
+        CONN_GATE_LEAVE(st->owner);
+    }
+    if (!ok)
+        Oradpi_FreeFetchCache(st);
+    return TCL_OK;
+}
+
+/* Invalidate and free the per-statement fetch metadata cache.
+ * Called on re-parse (oraparse / orasql / oraplexec) and at statement
+ * teardown (Oradpi_FreeStmt).  Safe to call on a statement with no cache. */
+void Oradpi_FreeFetchCache(OradpiStmt *s) {
+    Oradpi_ReadaheadDiscard(s);
+    if (!s || s->fetchCacheNumCols == 0)
+        return;
+    uint32_t n = s->fetchCacheNumCols;
+    if (s->fetchIsChar) {
+        Tcl_Free((char *)s->fetchIsChar);
+        s->fetchIsChar = NULL;
+    }
+    if (s->fetchColNames) {
+        for (uint32_t c = 0; c < n; c++)
+            if (s->fetchColNames[c])
+                Tcl_DecrRefCount(s->fetchColNames[c]);
+        Tcl_Free((char *)s->fetchColNames);
+        s->fetchColNames = NULL;
+    }
+    if (s->fetchNumberKeys) {
+        for (uint32_t c = 0; c < n; c++)
+            if (s->fetchNumberKeys[c])
+                Tcl_DecrRefCount(s->fetchNumberKeys[c]);
+        Tcl_Free((char *)s->fetchNumberKeys);
+        s->fetchNumberKeys = NULL;
+    }
+    /* Release pre-defined output variables. */
+    if (s->fetchVars) {
+        for (uint32_t c = 0; c < n; c++)
+            if (s->fetchVars[c])
+                dpiVar_release(s->fetchVars[c]);
+        Tcl_Free((char *)s->fetchVars);
+        s->fetchVars = NULL;
+        Tcl_Free((char *)s->fetchVarData);
+        s->fetchVarData = NULL;
+        Tcl_Free((char *)s->fetchNativeTypes);
+        s->fetchNativeTypes = NULL;
+        Tcl_Free((char *)s->fetchOracleTypes);
+        s->fetchOracleTypes = NULL;
+        Tcl_Free((char *)s->fetchDefineSizes);
+        s->fetchDefineSizes = NULL;
+    }
+    if (s->fetchIntern) {
+        for (uint32_t c = 0; c < n; c++) {
+            Tcl_HashTable *tbl = s->fetchIntern[c];
+            if (!tbl)
+                continue;
+            Tcl_HashSearch search;
+            for (Tcl_HashEntry *h = Tcl_FirstHashEntry(tbl, &search); h; h = Tcl_NextHashEntry(&search))
+                Tcl_DecrRefCount((Tcl_Obj *)Tcl_GetHashValue(h));
+            Tcl_DeleteHashTable(tbl);
+            Tcl_Free((char *)tbl);
+        }
+        Tcl_Free((char *)s->fetchIntern);
+        s->fetchIntern = NULL;
+    }
+    if (s->fetchDateFmt) {
+        Tcl_Free((char *)s->fetchDateFmt);
+        s->fetchDateFmt = NULL;
+    }
+    if (s->fetchNumText) {
+        Tcl_Free((char *)s->fetchNumText);
+        s->fetchNumText = NULL;
+    }
+    if (s->fetchDateTz) {
+        Tcl_Free((char *)s->fetchDateTz);
+        s->fetchDateTz = NULL;
+    }
+    if (s->fetchLongLob) {
+        Tcl_Free((char *)s->fetchLongLob);
+        s->fetchLongLob = NULL;
+    }
+    s->fetchCacheNumCols = 0;
+    s->fetchRedefine     = 0;
+}
+
+/* Snapshot the result's column metadata and build the fetch cache: column
+ * names, define selection (NUMBER text, coltypes), the define variables
+ * and the per-column tables orafetch reads.  orafetch calls this whenever
+ * the cache does not describe the current result; implicit results are
+ * prepared ahead of time through Oradpi_BuildFetchCache. */
+static int BuildFetchCache(Tcl_Interp *ip, OradpiStmt *st, uint32_t numCols) {
+    OradpiFetchColMeta *meta        = NULL;
+    unsigned char      *colDateFmt  = NULL;
+    size_t              metaBytes   = 0;
+    Tcl_Size            numColsSize = (Tcl_Size)numCols;
+
+    /* The cache is rebuilt for the same result: its result cache state
+     * (hit or pending key) outlives the old defines. */
+    OradpiResultCacheEntry *rcHit = st->rcHit;
+    char                   *rcKey = st->rcKey;
+    st->rcHit                     = NULL;
+    st->rcKey                     = NULL;
+    Oradpi_FreeFetchCache(st);
+    st->rcHit = rcHit;
+    st->rcKey = rcKey;
+
+    if (Oradpi_CheckedAllocBytes(ip, numColsSize, sizeof(*meta), &metaBytes, "column metadata snapshot") != TCL_OK)
+        goto fail;
+    meta = (OradpiFetchColMeta *)Tcl_Alloc(metaBytes);
+    memset(meta, 0, metaBytes);
+    if (FetchColumnPlan(ip, st, numCols, meta, &colDateFmt) != TCL_OK)
+        goto fail;
+
+    st->fetchIsChar     = (int *)Tcl_Alloc(numCols * sizeof(int));
+    st->fetchColNames   = (Tcl_Obj **)Tcl_Alloc(numCols * sizeof(Tcl_Obj *));
+    st->fetchNumberKeys = (Tcl_Obj **)Tcl_Alloc(numCols * sizeof(Tcl_Obj *));
+    memset(st->fetchColNames, 0, numCols * sizeof(Tcl_Obj *));
+    memset(st->fetchNumberKeys, 0, numCols * sizeof(Tcl_Obj *));
+
+    for (uint32_t c = 0; c < numCols; c++) {
+        st->fetchIsChar[c]   = meta[c].isChar;
+        st->fetchColNames[c]   = FetchNameObj(ip, meta[c].name, meta[c].nameLen);
+        st->fetchNumberKeys[c] = FetchNumberKeyObj(ip, c);
+    }
+    st->fetchCacheNumCols = numCols;
+    st->fetchDateFmt      = colDateFmt;
+    colDateFmt            = NULL;
+    int anyNumText = 0;
+    for (uint32_t c = 0; c < numCols; c++)
+        anyNumText |= meta[c].numText;
+    if (anyNumText) {
+        st->fetchNumText = (unsigned char *)Tcl_Alloc(numCols);
+        for (uint32_t c = 0; c < numCols; c++)
+            st->fetchNumText[c] = (unsigned char)meta[c].numText;
+    }
+    int anyZoned = 0;
+    for (uint32_t c = 0; c < numCols; c++)
+        anyZoned |= IsZonedTimestampType(meta[c].oracleTypeNum);
+    if (anyZoned) {
+        st->fetchDateTz = (unsigned char *)Tcl_Alloc(numCols);
+        for (uint32_t c = 0; c < numCols; c++)
+            st->fetchDateTz[c] = (unsigned char)IsZonedTimestampType(meta[c].oracleTypeNum);
+    }
+
+    /* Build per-column output variable cache to eliminate N
+     * dpiStmt_getQueryValue calls per row.  Done before FreeFetchMeta so
+     * meta[c] type fields are still valid.  Object columns need a
+     * dpiObjectType* unavailable here; any failure falls back to
+     * dpiStmt_getQueryValue for the entire statement. */
+    st->fetchVars         = (dpiVar **)Tcl_Alloc(numCols * sizeof(dpiVar *));
+    st->fetchVarData      = (dpiData **)Tcl_Alloc(numCols * sizeof(dpiData *));
+    st->fetchNativeTypes  = (dpiNativeTypeNum *)Tcl_Alloc(numCols * sizeof(dpiNativeTypeNum));
+    st->fetchOracleTypes  = (dpiOracleTypeNum *)Tcl_Alloc(numCols * sizeof(dpiOracleTypeNum));
+    st->fetchDefineSizes  = (uint32_t *)Tcl_Alloc(numCols * sizeof(uint32_t));
+    memset(st->fetchVars, 0, numCols * sizeof(dpiVar *));
+    memset(st->fetchVarData, 0, numCols * sizeof(dpiData *));
+
+    /* Auto mode sizes the define buffers from the byte budget and
+     * starts from the learned batch size, clipped to the new cap so
+     * dpiStmt_define sees an array that fits. */
+    uint32_t defineRows = st->fetchArray;
+    st->fetchAutoCap    = 0;
+    if (st->fetchAuto) {
+        defineRows = FetchAutoCap(meta, numCols, st->owner->fetchBudget);
+        if (st->fetchArray > defineRows)
+            st->fetchArray = defineRows;
+    }
+
+    int varBuildOk = 1;
+    CONN_GATE_ENTER(st->owner);
+    if (st->fetchAuto && dpiStmt_setFetchArraySize(st->stmt, st->fetchArray) != DPI_SUCCESS)
+        varBuildOk = 0;
+    for (uint32_t c = 0; c < numCols && varBuildOk; c++) {
+        dpiVar  *var  = NULL;
+        dpiData *data = NULL;
+        if (meta[c].oracleTypeNum == DPI_ORACLE_TYPE_OBJECT) {
+            varBuildOk = 0;
+            break;
+        }
+        /* clientSizeInBytes is measured in bytes; pass sizeIsBytes=1 for
+         * variable-length char/raw types.  For fixed-size types (NUMBER,
+         * DATE, LOB, etc.) size is ignored by ODPI-C so both 0 and 1 are
+         * safe — use 0 to be explicit. */
+        uint32_t size        = meta[c].longLob ? ORADPI_LONGLOB_DEFINE_BYTES : meta[c].clientSizeInBytes;
+        int      sizeIsBytes = (size > 0) ? 1 : 0;
+        if (dpiConn_newVar(st->owner->conn, meta[c].oracleTypeNum, meta[c].defaultNativeTypeNum, defineRows, size, sizeIsBytes, 0, NULL, &var, &data) != DPI_SUCCESS) {
+            varBuildOk = 0;
+            break;
+        }
+        if (dpiStmt_define(st->stmt, c + 1, var) != DPI_SUCCESS) {
+            dpiVar_release(var);
+            varBuildOk = 0;
+            break;
+        }
+        st->fetchVars[c]        = var;
+        st->fetchVarData[c]     = data;
+        st->fetchNativeTypes[c] = meta[c].defaultNativeTypeNum;
+        st->fetchOracleTypes[c] = meta[c].oracleTypeNum;
+        st->fetchDefineSizes[c] = size;
+    }
+    CONN_GATE_LEAVE(st->owner);
+
+    if (!varBuildOk) {
+        for (uint32_t c = 0; c < numCols; c++)
+            if (st->fetchVars[c])
+                dpiVar_release(st->fetchVars[c]);
+        Tcl_Free((char *)st->fetchVars);
+        st->fetchVars = NULL;
+        Tcl_Free((char *)st->fetchVarData);
+        st->fetchVarData = NULL;
+        Tcl_Free((char *)st->fetchNativeTypes);
+        st->fetchNativeTypes = NULL;
+        Tcl_Free((char *)st->fetchOracleTypes);
+        st->fetchOracleTypes = NULL;
+        Tcl_Free((char *)st->fetchDefineSizes);
+        st->fetchDefineSizes = NULL;
+    } else {
+        if (st->fetchAuto)
+            st->fetchAutoCap = defineRows;
+        int anyLongLob = 0;
+        for (uint32_t c = 0; c < numCols; c++)
+            anyLongLob |= meta[c].longLob;
+        if (anyLongLob) {
+            st->fetchLongLob = (unsigned char *)Tcl_Alloc(numCols);
+            for (uint32_t c = 0; c < numCols; c++)
+                st->fetchLongLob[c] = (unsigned char)meta[c].longLob;
+            st->fetchLobMax = st->owner->inlineLobMax;
+        }
+    }
+
+    /* Compute LOB flag from the isChar/oracle-type metadata.
+     * Checked once here; the fast path uses it to decide whether the
+     * connection gate is needed per row. */
+    int hasLob = 0;
+    for (uint32_t c = 0; c < numCols && !hasLob; c++)
+        if (meta[c].defaultNativeTypeNum == DPI_NATIVE_TYPE_LOB)
+            hasLob = 1;
+    st->fetchHasLobCols = hasLob;
+
+    /* Intern tables only pay off for character data read straight from
+     * the define buffers; other columns keep a NULL slot. */
+    if (st->internMax > 0 && st->fetchVars) {
+        st->fetchIntern = (Tcl_HashTable **)Tcl_Alloc(numCols * sizeof(Tcl_HashTable *));
+        for (uint32_t c = 0; c < numCols; c++) {
+            st->fetchIntern[c] = NULL;
+            if (!meta[c].isChar || st->fetchNativeTypes[c] != DPI_NATIVE_TYPE_BYTES)
+                continue;
+            st->fetchIntern[c] = (Tcl_HashTable *)Tcl_Alloc(sizeof(Tcl_HashTable));
+            Tcl_InitCustomHashTable(st->fetchIntern[c], TCL_CUSTOM_PTR_KEYS, &internKeyType);
+        }
+    }
+
+    /* meta name copies served only to build the cache; free them now. */
+    FreeFetchMeta(meta, numColsSize);
+    return TCL_OK;
+
+fail:
+    if (meta)
+        FreeFetchMeta(meta, numColsSize);
+    if (colDateFmt)
+        Tcl_Free((char *)colDateFmt);
+    return TCL_ERROR;
+}
+
+int Oradpi_BuildFetchCache(Tcl_Interp *ip, OradpiStmt *st) {
+    uint32_t numCols = 0;
+    CONN_GATE_ENTER(st->owner);
+    if (dpiStmt_getNumQueryColumns(st->stmt, &numCols) != DPI_SUCCESS) {
+        CONN_GATE_LEAVE(st->owner);
+        return Oradpi_SetErrorFromODPI(ip, (OradpiBase *)st, "dpiStmt_getNumQueryColumns");
+    }
+    CONN_GATE_LEAVE(st->owner);
+    if (numCols == 0 || st->fetchCacheNumCols == numCols)
+        return TCL_OK;
+    return BuildFetchCache(ip, st, numCols);
+}
+
+/* -datavariable rows are rebuilt in place when the variable and this call
+ * hold the only references to the previous row's list, so a script that
+ * looks at each row only transiently costs no list allocation per row.
+ * Whether the variable still holds the row is tracked with a write/unset
+ * trace rather than by reading it back, which would fire read traces. */
+typedef struct OradpiRowReuse {
+    Tcl_Obj *row;     /* previous row with this call's reference, or NULL */
+    int      held;    /* the variable holds row: no script write since */
+    int      setting; /* our own Tcl_ObjSetVar2 is running */
+    int      traced;
+} OradpiRowReuse;
+
+#define ROW_REUSE_TRACE_FLAGS (TCL_TRACE_WRITES | TCL_TRACE_UNSETS)
+
+static char *RowReuseTrace(void *cd, Tcl_Interp *ip, const char *name1, const char *name2, int flags) {
+    OradpiRowReuse *rr = (OradpiRowReuse *)cd;
+    (void)ip;
+    (void)name1;
+    (void)name2;
+    if (!rr->setting)
+        rr->held = 0;
+    if (flags & TCL_TRACE_DESTROYED)
+        rr->traced = 0;
+    return NULL;
+}
+
+/* Store rowObj in the -datavariable, tracking it in rr when rows are
+ * reused (rr may be NULL); returns 0 with the interp result set on
+ * failure. */
+static int FetchSetDataVar(Tcl_Interp *ip, Tcl_Obj *dataVar, Tcl_Obj *rowObj, OradpiRowReuse *rr) {
+    if (!rr)
+        return Tcl_ObjSetVar2(ip, dataVar, NULL, rowObj, TCL_LEAVE_ERR_MSG) != NULL;
+    rr->setting  = 1;
+    Tcl_Obj *set = Tcl_ObjSetVar2(ip, dataVar, NULL, rowObj, TCL_LEAVE_ERR_MSG);
+    rr->setting  = 0;
+    if (!set)
+        return 0;
+    if (!rr->traced && Tcl_TraceVar2(ip, Tcl_GetString(dataVar), NULL, ROW_REUSE_TRACE_FLAGS, RowReuseTrace, rr) == TCL_OK)
+        rr->traced = 1;
+    rr->held = rr->traced && set == rowObj;
+    return 1;
+}
+
+static void RowReuseFinish(Tcl_Interp *ip, Tcl_Obj *dataVar, OradpiRowReuse *rr) {
+    if (rr->traced)
+        Tcl_UntraceVar2(ip, Tcl_GetString(dataVar), NULL, ROW_REUSE_TRACE_FLAGS, RowReuseTrace, rr);
+    rr->traced = 0;
+    if (rr->row)
+        Tcl_DecrRefCount(rr->row);
+    rr->row = NULL;
+}
+
+/* Returns the row with the caller's reference, or NULL when the previous
+ * row was kept, replaced or reshaped (e.g. into a dict) by the script and
+ * a new list is needed. */
+static Tcl_Obj *FetchRowReuse(OradpiRowReuse *rr, uint32_t numCols, int asDict, Tcl_Obj *const *colNames, Tcl_Obj *const *colVals) {
+    static const Tcl_ObjType *listType;
+    Tcl_Obj                  *row = rr->row;
+    rr->row                       = NULL;
+    if (!row)
+        return NULL;
+    if (!listType)
+        listType = Tcl_GetObjType("list");
+    Tcl_Size want = asDict ? 2 * (Tcl_Size)numCols : (Tcl_Size)numCols;
+    Tcl_Size len  = 0;
+    if (!rr->held || row->refCount != 2 || !Tcl_FetchInternalRep(row, listType) || Tcl_ListObjLength(NULL, row, &len) != TCL_OK || len != want) {
+        Tcl_DecrRefCount(row);
+        return NULL;
+    }
+    /* The variable keeps the list alive while it is unshared. */
+    Tcl_DecrRefCount(row);
+    if (asDict) {
+        for (uint32_t c = 0; c < numCols; c++) {
+            Tcl_Obj *pair[2] = {colNames[c], colVals[c]};
+            (void)Tcl_ListObjReplace(NULL, row, 2 * (Tcl_Size)c, 2, 2, pair);
+        }
+    } else {
+        (void)Tcl_ListObjReplace(NULL, row, 0, want, want, colVals);
+    }
+    Tcl_IncrRefCount(row);
+    return row;
+}
+
+/* Drop the caller's reference to a finished row, or keep it in *reuseRow
+ * for FetchRowReuse when reuseRow is non-NULL. */
+static void FetchRowDone(Tcl_Obj **rowObj, Tcl_Obj **reuseRow) {
+    if (!*rowObj)
+        return;
+    if (reuseRow)
+        *reuseRow = *rowObj;
+    else
+        Tcl_DecrRefCount(*rowObj);
+    *rowObj = NULL;
+}
+
+/* -batchcommand: pass the rows collected so far to the script as one list
+ * argument and start a new list.  Returns the script's completion code. */
+static int FetchBatchCallback(Tcl_Interp *ip, Tcl_Obj *batchCmd, Tcl_Obj **rowsList) {
+    Tcl_Obj *cmd = Tcl_DuplicateObj(batchCmd);
+    Tcl_IncrRefCount(cmd);
+    int rc = Tcl_ListObjAppendElement(ip, cmd, *rowsList);
+    Tcl_DecrRefCount(*rowsList);
+    *rowsList = Tcl_NewListObj(0, NULL);
+    Tcl_IncrRefCount(*rowsList);
+    if (rc == TCL_OK)
+        rc = Tcl_EvalObjEx(ip, cmd, TCL_EVAL_GLOBAL);
+    Tcl_DecrRefCount(cmd);
+    return rc == TCL_CONTINUE ? TCL_OK : rc;
+}
+
+/*
+ * orafetch statement-handle ?-datavariable varName? ?-dataarray arrName?
+ *         ?-indexbyname? ?-indexbynumber? ?-command script? ?-max N?
+ *         ?-batchcommand script?
+ *         ?-resultvariable varName? ?-returnrows? ?-asdict?
+ *         ?-columns varName ?-packed?? ?-dateformat fmt?
+ *         ?-position absolute|relative N | first|last?
+ *         ?-channel chan ?-format csv|tsv? ?-header bool? ?-nullvalue str??
+ *         ?-arrow chan?
+ *
+ *   Fetches rows from a previously executed query. By default returns 0
+ *   while rows remain and 1403 at end-of-data. Use -returnrows or
+ *   -resultvariable to collect row lists. Options control variable binding,
+ *   per-row callbacks, and result format (dict, array, etc.).
+ *   -batchcommand calls script once per fetched batch with the batch's
+ *   rows (dicts with -asdict) as one extra argument.  -columns
+ *   stores a dict of column name -> list of values instead of rows;
+ *   -packed encodes numeric/date columns as little-endian bytearrays.
+ *   -channel writes the rows to a channel as CSV or TSV text; -arrow
+ *   writes them as an Arrow IPC stream, one record batch per fetch batch.
+ *   Returns: 0 (rows fetched), 1403 (no data found), a row list when
+ *   -returnrows is used, or the number of rows written with -channel
+ *   or -arrow.
+ *   Errors:  ODPI-C fetch errors; invalid handle; async busy (errors immediately).
+ *   Thread-safety: safe — per-interp state only.
+ */
+int Oradpi_Cmd_Fetch(void *cd, Tcl_Interp *ip, Tcl_Size objc, Tcl_Obj *const objv[]) {
+    Tcl_Obj            *dataVar     = NULL;
+    Tcl_Obj            *dataArray   = NULL;
+    int                 indexByName = 0, indexByNumber = 0;
+    Tcl_Obj            *cmd             = NULL;
+    Tcl_Obj            *batchCmd        = NULL;
+    int                 lazy            = 0;
+    Tcl_WideInt         lazyBudget      = 0;
+    OradpiLazyRows     *lazyRows        = NULL;
+    Tcl_Size            batchPending    = 0;
+    int                 batchStop       = 0;
+    Tcl_WideInt         maxRows         = 0;
+    Tcl_Obj            *resultVar       = NULL;
+    /* default to status-code mode (0 / 1403) as documented.
+     * Default to status-code mode (0 / 1403).  -returnrows explicitly
+     * enables list-return mode.  Plain "orafetch $S" fetches a single row
+     * and returns 0 (rows remain) or 1403 (end-of-data). */
+    int                 returnRows      = 0;
+    int                 asDict          = 0;
+    Tcl_Obj            *columnsVar      = NULL;
+    int                 packed          = 0;
+    Tcl_Channel         chan            = NULL;
+    int                 chanFormat      = -1;
+    int                 chanHeader      = 0;
+    Tcl_Obj            *nullValue       = NULL;
+    Tcl_Channel         arrowChan       = NULL;
+
+    uint32_t            numCols         = 0;
+    Tcl_Size            numColsSize     = 0;
+    unsigned char      *dateFmts        = NULL;
+    int                 dateFormat      = -1;
+    OradpiFetchCell    *cells           = NULL;
+    Tcl_Obj           **colNames        = NULL;
+    Tcl_Obj           **colVals         = NULL;
+    Tcl_Obj           **numberKeys      = NULL;
+    Tcl_Obj           **colLists        = NULL;
+    Tcl_Obj           **colNulls        = NULL;
+    unsigned char      *packKind        = NULL;
+    Tcl_Obj            *rowsList        = NULL;
+    Tcl_Obj            *rowObj          = NULL;
+    OradpiRowReuse      rowReuse        = {0};
+    int                 reuseOk         = 0;
+    int                 scrollMode      = -1;
+    Tcl_WideInt         scrollOffset    = 0;
+    Tcl_WideInt         scrollTarget    = 0;
+    int                 scrollOutside   = 0;
+    int                 winShape        = 0;
+    int                 winKeep         = 0;
+    uint64_t            fetched         = 0;
+    int                 code            = TCL_OK;
+    int                 needNames       = 0;
+    size_t              cellBytes       = 0;
+    size_t              colNameBytes    = 0;
+    size_t              colValBytes     = 0;
+
+    /* Snapshot handles for reentrancy safety, initialized to NULL
+     * so the single cleanup label can conditionally release them. */
+    dpiStmt            *fetchStmt       = NULL;
+    GlobalConnRec      *fetchShared     = NULL;
+    Tcl_Obj            *stmtNameSnap    = NULL;
+    int                 fetchInlineLobs = 0;
+    int                 fetchDead       = 0;
+    OradpiReadahead    *ra              = NULL;
+
+    (void)cd;
+    if (objc < 2) {
+        Tcl_WrongNumArgs(ip, 1, objv, "statement-handle ?options?");
+        return TCL_ERROR;
+    }
+    OradpiStmt *st = Oradpi_LookupStmt(ip, objv[1]);
+    if (!st)
+        return Oradpi_SetError(ip, NULL, -1, "invalid statement handle");
+    if (!st->stmt)
+        return Oradpi_SetError(ip, (OradpiBase *)st, -1, "statement is not prepared or connection closed");
+    if (Oradpi_StmtIsAsyncBusy(st))
+        return Oradpi_SetError(ip, (OradpiBase *)st, -1, "statement is busy (async operation in progress)");
+
+    static const char *const fetchOpts[] = {"-datavariable", "-dataarray", "-indexbyname", "-indexbynumber", "-command", "-max", "-resultvariable", "-returnrows", "-asdict", "-columns", "-packed", "-channel", "-format", "-header", "-nullvalue", "-dateformat", "-position", "-batchcommand", "-lazy", "-arrow", NULL};
+    enum FetchOptIdx { FOPT_DATAVAR, FOPT_DATAARRAY, FOPT_BYNAME, FOPT_BYNUMBER, FOPT_COMMAND, FOPT_MAX, FOPT_RESULTVAR, FOPT_RETURNROWS, FOPT_ASDICT, FOPT_COLUMNS, FOPT_PACKED, FOPT_CHANNEL, FOPT_FORMAT, FOPT_HEADER, FOPT_NULLVALUE, FOPT_DATEFORMAT, FOPT_POSITION, FOPT_BATCHCOMMAND, FOPT_LAZY, FOPT_ARROW };
+
+    for (Tcl_Size i = 2; i < objc; i++) {
+        int optIdx;
+        if (Tcl_GetIndexFromObj(ip, objv[i], fetchOpts, "option", 0, &optIdx) != TCL_OK)
+            return TCL_ERROR;
+
+        switch ((enum FetchOptIdx)optIdx) {
+        case FOPT_DATAVAR:
+            if (i + 1 >= objc) {
+                Tcl_WrongNumArgs(ip, 1, objv, "statement-handle ?options?");
+                return TCL_ERROR;
+            }
+            dataVar    = objv[++i];
+            returnRows = 0;
+            break;
+        case FOPT_DATAARRAY:
+            if (i + 1 >= objc) {
+                Tcl_WrongNumArgs(ip, 1, objv, "statement-handle ?options?");
+                return TCL_ERROR;
+            }
+            dataArray  = objv[++i];
+            returnRows = 0;
+            break;
+        case FOPT_BYNAME:
+            indexByName = 1;
+            returnRows  = 0;
+            break;
+        case FOPT_BYNUMBER:
+            indexByNumber = 1;
+            returnRows    = 0;
+            break;
+        case FOPT_COMMAND:
+            if (i + 1 >= objc) {
+                Tcl_WrongNumArgs(ip, 1, objv, "statement-handle ?options?");
+                return TCL_ERROR;
+            }
+            cmd        = objv[++i];
+            returnRows = 0;
+            break;
+        case FOPT_MAX:
+            if (i + 1 >= objc) {
+                Tcl_WrongNumArgs(ip, 1, objv, "statement-handle ?options?");
+                return TCL_ERROR;
+            }
+            if (Tcl_GetWideIntFromObj(ip, objv[++i], &maxRows) != TCL_OK)
+                return TCL_ERROR;
+            break;
+        case FOPT_RESULTVAR:
+            if (i + 1 >= objc) {
+                Tcl_WrongNumArgs(ip, 1, objv, "statement-handle ?options?");
+                return TCL_ERROR;
+            }
+            resultVar  = objv[++i];
+            returnRows = 0;
+            break;
+        case FOPT_RETURNROWS:
+            returnRows = 1;
+            break;
+        case FOPT_ASDICT:
+            asDict     = 1;
+            returnRows = 0;
+            break;
+        case FOPT_COLUMNS:
+            if (i + 1 >= objc) {
+                Tcl_WrongNumArgs(ip, 1, objv, "statement-handle ?options?");
+                return TCL_ERROR;
+            }
+            columnsVar = objv[++i];
+            break;
+        case FOPT_PACKED:
+            packed = 1;
+            break;
+        case FOPT_CHANNEL: {
+            int mode = 0;
+            if (i + 1 >= objc) {
+                Tcl_WrongNumArgs(ip, 1, objv, "statement-handle ?options?");
+                return TCL_ERROR;
+            }
+            chan = Tcl_GetChannel(ip, Tcl_GetString(objv[++i]), &mode);
+            if (!chan)
+                return TCL_ERROR;
+            if (!(mode & TCL_WRITABLE))
+                return Oradpi_SetError(ip, (OradpiBase *)st, -1, "orafetch: -channel must be open for writing");
+            break;
+        }
+        case FOPT_FORMAT:
+            if (i + 1 >= objc) {
+                Tcl_WrongNumArgs(ip, 1, objv, "statement-handle ?options?");
+                return TCL_ERROR;
+            }
+            if (Tcl_GetIndexFromObj(ip, objv[++i], exportFormatNames, "format", 0, &chanFormat) != TCL_OK)
+                return TCL_ERROR;
+            break;
+        case FOPT_HEADER:
+            if (i + 1 >= objc) {
+                Tcl_WrongNumArgs(ip, 1, objv, "statement-handle ?options?");
+                return TCL_ERROR;
+            }
+            if (Tcl_GetBooleanFromObj(ip, objv[++i], &chanHeader) != TCL_OK)
+                return TCL_ERROR;
+            break;
+        case FOPT_NULLVALUE:
+            if (i + 1 >= objc) {
+                Tcl_WrongNumArgs(ip, 1, objv, "statement-handle ?options?");
+                return TCL_ERROR;
+            }
+            nullValue = objv[++i];
+            break;
+        case FOPT_DATEFORMAT:
+            if (i + 1 >= objc) {
+                Tcl_WrongNumArgs(ip, 1, objv, "statement-handle ?options?");
+                return TCL_ERROR;
+            }
+            if (Tcl_GetIndexFromObj(ip, objv[++i], Oradpi_DateFormatNames, "date format", 0, &dateFormat) != TCL_OK)
+                return TCL_ERROR;
+            break;
+        case FOPT_POSITION:
+            if (i + 1 >= objc) {
+                Tcl_WrongNumArgs(ip, 1, objv, "statement-handle ?options?");
+                return TCL_ERROR;
+            }
+            if (Tcl_GetIndexFromObj(ip, objv[++i], scrollModeNames, "position", 0, &scrollMode) != TCL_OK)
+                return TCL_ERROR;
+            if (scrollMode == SCROLL_ABSOLUTE || scrollMode == SCROLL_RELATIVE) {
+                if (i + 1 >= objc) {
+                    Tcl_WrongNumArgs(ip, 1, objv, "statement-handle ?options?");
+                    return TCL_ERROR;
+                }
+                if (Tcl_GetWideIntFromObj(ip, objv[++i], &scrollOffset) != TCL_OK)
+                    return TCL_ERROR;
+            }
+            break;
+        case FOPT_BATCHCOMMAND:
+            if (i + 1 >= objc) {
+                Tcl_WrongNumArgs(ip, 1, objv, "statement-handle ?options?");
+                return TCL_ERROR;
+            }
+            batchCmd = objv[++i];
+            break;
+        case FOPT_LAZY:
+            if (i + 1 >= objc) {
+                Tcl_WrongNumArgs(ip, 1, objv, "statement-handle ?options?");
+                return TCL_ERROR;
+            }
+            if (Tcl_GetWideIntFromObj(ip, objv[++i], &lazyBudget) != TCL_OK)
+                return TCL_ERROR;
+            if (lazyBudget < 0)
+                return Oradpi_SetError(ip, (OradpiBase *)st, -1, "orafetch: -lazy must be >= 0");
+            lazy = 1;
+            break;
+        case FOPT_ARROW: {
+            int mode = 0;
+            if (i + 1 >= objc) {
+                Tcl_WrongNumArgs(ip, 1, objv, "statement-handle ?options?");
+                return TCL_ERROR;
+            }
+            arrowChan = Tcl_GetChannel(ip, Tcl_GetString(objv[++i]), &mode);
+            if (!arrowChan)
+                return TCL_ERROR;
+            if (!(mode & TCL_WRITABLE))
+                return Oradpi_SetError(ip, (OradpiBase *)st, -1, "orafetch: -arrow must be open for writing");
+            break;
+        }
+        }
+    }
+
+    /* -arrow is -channel with its own stream format. */
+    if (arrowChan) {
+        if (chan || chanFormat >= 0 || chanHeader || nullValue)
+            return Oradpi_SetError(ip, (OradpiBase *)st, -1, "orafetch: -arrow cannot be combined with -channel, -format, -header or -nullvalue");
+        chan = arrowChan;
+    }
+
+    if (maxRows < 0)
+        return Oradpi_SetError(ip, (OradpiBase *)st, -1, "orafetch: -max must be >= 0");
+    if (columnsVar && (dataVar || dataArray || cmd || resultVar || returnRows || asDict))
+        return Oradpi_SetError(ip, (OradpiBase *)st, -1, "orafetch: -columns cannot be combined with row-oriented options");
+    if (packed && !columnsVar)
+        return Oradpi_SetError(ip, (OradpiBase *)st, -1, "orafetch: -packed requires -columns");
+    if (batchCmd && (dataVar || dataArray || cmd || resultVar || returnRows || columnsVar || chan))
+        return Oradpi_SetError(ip, (OradpiBase *)st, -1, "orafetch: -batchcommand cannot be combined with -command, variables, -returnrows, -columns or -channel");
+    if (lazy && (!(returnRows || resultVar) || dataVar || dataArray || cmd || columnsVar || chan || batchCmd))
+        return Oradpi_SetError(ip, (OradpiBase *)st, -1, "orafetch: -lazy requires -returnrows or -resultvariable and cannot be combined with -command, variables, -columns, -channel or -batchcommand");
+    if (chan && (dataVar || dataArray || cmd || resultVar || returnRows || asDict || columnsVar))
+        return Oradpi_SetError(ip, (OradpiBase *)st, -1, "orafetch: -channel cannot be combined with row-oriented options or -columns");
+    if (!chan && (chanFormat >= 0 || chanHeader || nullValue))
+        return Oradpi_SetError(ip, (OradpiBase *)st, -1, "orafetch: -format, -header and -nullvalue require -channel");
+    if (scrollMode >= 0 && !st->scrollable)
+        return Oradpi_SetError(ip, (OradpiBase *)st, -1, "orafetch: -position requires a statement parsed with -scrollable");
+    /* Default to single-row fetch only in plain status-code mode.
+     * When -command, -resultvar, or -returnrows is active, fetch all rows
+     * unless the caller explicitly provides -max.  Note: this means
+     * "orafetch $S -command {…}" on a large result set will iterate all
+     * rows — callers should use -max to limit if the table is large.
+     * -columns, -channel and -batchcommand behave the same way. */
+    if (!returnRows && !cmd && !resultVar && !columnsVar && !chan && !batchCmd && maxRows == 0)
+        maxRows = 1;
+
+    /* Plain row lists from a scrollable statement feed its window; a
+     * positioned page that lies wholly inside it is answered from there. */
+    if (st->scrollable) {
+        winShape = ScrollShape(asDict, dateFormat >= 0 ? dateFormat : st->dateFormat);
+        winKeep  = (returnRows || resultVar) && !dataVar && !dataArray && !cmd && !lazy;
+        if (scrollMode >= 0) {
+            if (ScrollTarget(ip, st, scrollMode, scrollOffset, &scrollTarget) != TCL_OK)
+                return TCL_ERROR;
+            Tcl_Obj *page = (winKeep && maxRows > 0) ? ScrollWindowGet(st, winShape, scrollTarget, maxRows) : NULL;
+            if (page) {
+                st->scrollNext = (uint64_t)scrollTarget + (uint64_t)maxRows;
+                if (resultVar && !Tcl_ObjSetVar2(ip, resultVar, NULL, page, TCL_LEAVE_ERR_MSG))
+                    return TCL_ERROR;
+                Tcl_SetObjResult(ip, returnRows ? page : Tcl_NewIntObj(0));
+                return TCL_OK;
+            }
+        }
+    }
+
+    /* A re-parse of the same SQL kept the fetch cache; define it on the
+     * new cursor (a cached result is served without the defines). */
+    if (st->fetchRedefine && !st->rcHit && FetchCacheRedefine(ip, st) != TCL_OK)
+        return TCL_ERROR;
+
+    /* Column count is cached after the first fetch — skip the ODPI call
+     * and gate acquire/release on every subsequent invocation. */
+    if (st->fetchCacheNumCols > 0) {
+        numCols = st->fetchCacheNumCols;
+    } else {
+        CONN_GATE_ENTER(st->owner);
+        if (dpiStmt_getNumQueryColumns(st->stmt, &numCols) != DPI_SUCCESS) {
+            CONN_GATE_LEAVE(st->owner);
+            return Oradpi_SetErrorFromODPI(ip, (OradpiBase *)st, "dpiStmt_getNumQueryColumns");
+        }
+        CONN_GATE_LEAVE(st->owner);
+    }
+
+    if (numCols == 0) {
+        Tcl_SetObjResult(ip, returnRows ? Tcl_NewListObj(0, NULL) : Tcl_NewIntObj(1403));
+        return TCL_OK;
+    }
+
+    numColsSize = (Tcl_Size)numCols;
+    needNames   = (asDict || (dataArray && indexByName) || columnsVar);
+
+    /* Metadata cache check.  On the first orafetch after a parse the cache
+     * is empty (fetchCacheNumCols == 0); we snapshot column info from ODPI
+     * once and store it.  On every subsequent call we skip all ODPI
+     * round-trips, DString allocations (upper_copy), and Tcl_ObjPrintf
+     * calls and just IncrRefCount the already-built objects instead. */
+    if (st->fetchCacheNumCols != numCols && BuildFetchCache(ip, st, numCols) != TCL_OK) {
+        code = TCL_ERROR;
+        goto cleanup;
+    }
+
+    /* A cached result must still have the shape the query describes to;
+     * otherwise the objects changed under it and the entry is dropped. */
+    if (st->rcHit && (st->rcHit->numCols != numCols || !st->fetchVarData)) {
+        ResultCacheUnlist(st->rcHit);
+        ResultCacheForget(st);
+        code = Oradpi_SetError(ip, (OradpiBase *)st, -1, "orafetch: cached result no longer matches the query; execute it again");
+        goto cleanup;
+    }
+
+    dateFmts = ResolveDateFmts(st, numCols, dateFormat >= 0 ? dateFormat : st->dateFormat);
+    ClockZoneBegin();
+
+    /* Scroll once the defines exist, so the rows land in our buffers. */
+    if (scrollMode >= 0) {
+        st->scrollNext = 0;
+        if (scrollTarget < 0)
+            scrollOutside = 1;
+        else if (ScrollTo(ip, st, scrollTarget, &scrollOutside) != TCL_OK) {
+            code = TCL_ERROR;
+            goto cleanup;
+        }
+    } else if (st->scrollNext) {
+        Tcl_WideInt next = (Tcl_WideInt)st->scrollNext;
+        st->scrollNext   = 0;
+        if (ScrollTo(ip, st, next, &scrollOutside) != TCL_OK) {
+            code = TCL_ERROR;
+            goto cleanup;
+        }
+    }
+
+    if (needNames) {
+        if (Oradpi_CheckedAllocBytes(ip, numColsSize, sizeof(Tcl_Obj *), &colNameBytes, "column name array") != TCL_OK) {
+            code = TCL_ERROR;
+            goto cleanup;
+        }
+        colNames = (Tcl_Obj **)Tcl_Alloc(colNameBytes);
+        for (uint32_t c = 0; c < numCols; c++) {
+            colNames[c] = st->fetchColNames[c];
+            Tcl_IncrRefCount(colNames[c]);
+        }
+    }
+
+    if (Oradpi_CheckedAllocBytes(ip, numColsSize, sizeof(Tcl_Obj *), &colValBytes, "fetched row value array") != TCL_OK) {
+        code = TCL_ERROR;
+        goto cleanup;
+    }
+    colVals = (Tcl_Obj **)Tcl_Alloc(colValBytes);
+    memset(colVals, 0, colValBytes);
+
+    if (dataArray && indexByNumber) {
+        size_t keyBytes = 0;
+        if (Oradpi_CheckedAllocBytes(ip, numColsSize, sizeof(Tcl_Obj *), &keyBytes, "numeric column keys") != TCL_OK) {
+            code = TCL_ERROR;
+            goto cleanup;
+        }
+        numberKeys = (Tcl_Obj **)Tcl_Alloc(keyBytes);
+        for (uint32_t c = 0; c < numCols; c++) {
+            numberKeys[c] = st->fetchNumberKeys[c];
+            Tcl_IncrRefCount(numberKeys[c]);
+        }
+    }
+
+    /* -batchcommand collects each batch in rowsList and hands it over at
+     * the batch boundary. */
+    if ((returnRows || resultVar || batchCmd) && !lazy) {
+        rowsList = Tcl_NewListObj(0, NULL);
+        Tcl_IncrRefCount(rowsList);
+    }
+    /* A row also appended to rowsList stays referenced; only a bare
+     * -datavariable row can be rebuilt in place. */
+    reuseOk = dataVar && !rowsList;
+
+    /* The fetch loop holds its own reference: a callback may discard the
+     * readahead state (re-parse, reconfigure) while rows are pending. */
+    ra = ReadaheadEnsure(st);
+    if (ra) {
+        Tcl_MutexLock(&ra->lock);
+        ra->refCount++;
+        Tcl_MutexUnlock(&ra->lock);
+    }
+
+    if (columnsVar) {
+        size_t listBytes = 0;
+        if (Oradpi_CheckedAllocBytes(ip, numColsSize, sizeof(Tcl_Obj *), &listBytes, "column value lists") != TCL_OK) {
+            code = TCL_ERROR;
+            goto cleanup;
+        }
+        colLists = (Tcl_Obj **)Tcl_Alloc(listBytes);
+        for (uint32_t c = 0; c < numCols; c++) {
+            colLists[c] = Tcl_NewListObj(0, NULL);
+            Tcl_IncrRefCount(colLists[c]);
+        }
+
+        /* Packing reads the define buffers directly, so it is only
+         * available when they exist and no worker is filling them;
+         * otherwise every column stays a list. */
+        if (packed && st->fetchVarData && !ra) {
+            packKind = (unsigned char *)Tcl_Alloc(numCols);
+            colNulls = (Tcl_Obj **)Tcl_Alloc(listBytes);
             for (uint32_t c = 0; c < numCols; c++) {
-                dpiData *d = &varData[c][rowIdx];
-                if (SnapshotCellLocked(fetchInlineLobs, nativeTypes[c], d, st->fetchIsChar[c], &cells[c], &snapshotWhere, &snapshotMsg) != TCL_OK) {
-                    if (needGate)
-                        Oradpi_SharedConnGateLeave(fetchShared);
+                packKind[c] = (unsigned char)((st->fetchNumText && st->fetchNumText[c]) ? PACK_FLOAT64 : PackKindForNative(st->fetchNativeTypes[c]));
+                colNulls[c] = NULL;
+                if (packKind[c] == PACK_NONE)
+                    continue;
+                Tcl_DecrRefCount(colLists[c]);
+                colLists[c] = Tcl_NewByteArrayObj(NULL, 0);
+                Tcl_IncrRefCount(colLists[c]);
+                colNulls[c] = Tcl_NewByteArrayObj(NULL, 0);
+                Tcl_IncrRefCount(colNulls[c]);
+            }
+        }
+    }
+
+    if (Oradpi_CheckedAllocBytes(ip, numColsSize, sizeof(*cells), &cellBytes, "fetched row snapshot array") != TCL_OK) {
+        code = TCL_ERROR;
+        goto cleanup;
+    }
+    cells = (OradpiFetchCell *)Tcl_Alloc(cellBytes);
+    memset(cells, 0, cellBytes);
+
+    /* Snapshot dpiStmt* and GlobalConnRec* with addRef to hold
+     * independent lifetime references during the fetch loop.  Callbacks
+     * (-command) and variable traces (-datavariable, -dataarray,
+     * -resultvariable) are reentrancy points where Tcl can legally call
+     * oraclose or oralogoff, freeing the statement and connection wrappers
+     * while the C function is still using them.
+     *
+     * With these holds, the underlying ODPI resources survive the loop
+     * even if the Tcl-level wrappers are destroyed.  After each reentrancy
+     * point, we verify liveness by checking if the statement is still
+     * registered in the interp; if not, we break cleanly. */
+    fetchStmt       = st->stmt;
+    fetchShared     = st->owner ? st->owner->shared : NULL;
+    fetchInlineLobs = st->owner ? st->owner->inlineLobs : 0;
+    stmtNameSnap    = st->base.name;
+
+    if (dpiStmt_addRef(fetchStmt) != DPI_SUCCESS) {
+        code        = Oradpi_SetErrorFromODPI(ip, (OradpiBase *)st, "dpiStmt_addRef (fetch hold)");
+        fetchStmt   = NULL; /* prevent cleanup from releasing a ref we never took */
+        fetchShared = NULL;
+        goto cleanup;
+    }
+    if (fetchShared)
+        Oradpi_SharedConnAddRef(fetchShared);
+    Tcl_IncrRefCount(stmtNameSnap);
+
+    /* =========================================================================
+     * Fetch loop — two paths share the same reentrancy zone:
+     *
+     *   Fast path (when st->fetchVarData != NULL):
+     *     dpiStmt_fetchRows drains the ODPI buffer in one call per batch;
+     *     per-row values come from direct dpiData[] buffer access — zero
+     *     dpiStmt_getQueryValue ODPI calls in the hot inner loop.
+     *     The gate is acquired once per batch (not per row), reducing lock
+     *     contention against async workers or adopted-connection threads.
+     *
+     *   Fallback (st->fetchVarData == NULL):
+     *     Original dpiStmt_fetch + dpiStmt_getQueryValue per row.
+     *     Used when var creation failed (e.g. object-type columns).
+     * ========================================================================= */
+    if (scrollOutside) {
+        /* -position lies outside the result set: nothing to fetch. */
+        if (chan) {
+            Tcl_SetObjResult(ip, Tcl_NewWideIntObj(0));
+            goto cleanup;
+        }
+    } else if (chan) {
+        /* ------------------------------------------------------------------
+         * EXPORT PATH (-channel, -arrow): rows are formatted, not materialized
+         * ------------------------------------------------------------------ */
+        OradpiExportFmt fmt;
+        fmt.format   = chanFormat >= 0 ? chanFormat : EXPORT_CSV;
+        fmt.nullText = nullValue ? Tcl_GetStringFromObj(nullValue, &fmt.nullLen) : "";
+        if (!nullValue)
+            fmt.nullLen = 0;
+        fmt.dateFmt = dateFmts;
+        fmt.arrow   = NULL;
+        if (arrowChan) {
+            if (Tcl_SetChannelOption(ip, chan, "-translation", "binary") != TCL_OK) {
+                code = TCL_ERROR;
+                goto cleanup;
+            }
+            fmt.arrow = ArrowBatchNew(st, numCols);
+        }
+        code = FetchToChannel(ip, st, fetchStmt, fetchShared, ra, stmtNameSnap, numCols, chan, &fmt, chanHeader, maxRows, &fetched);
+        if (fmt.arrow)
+            ArrowBatchFree(fmt.arrow);
+        if (code != TCL_OK)
+            goto cleanup;
+        Tcl_SetObjResult(ip, Tcl_NewWideIntObj((Tcl_WideInt)fetched));
+        goto cleanup;
+    } else if (lazy) {
+        /* ------------------------------------------------------------------
+         * LAZY PATH (-lazy): rows are encoded, not materialized
+         * ------------------------------------------------------------------ */
+        lazyRows = LazyRowsNew(numCols, asDict ? colNames : NULL, dateFmts, (size_t)lazyBudget);
+        code     = FetchCellRows(ip, st, fetchStmt, fetchShared, ra, numCols, LazyRowsAppend, lazyRows, maxRows, &fetched);
+        if (code == TCL_OK)
+            code = LazyRowsFinish(ip, lazyRows);
+        if (code != TCL_OK)
+            goto cleanup;
+        rowsList = LazyListNewObj(lazyRows);
+        lazyRows = NULL;
+        Tcl_IncrRefCount(rowsList);
+    } else if (colLists && st->fetchVarData && !ra) {
+        /* ------------------------------------------------------------------
+         * COLUMNAR PATH (-columns): column-major walk of each batch
+         * ------------------------------------------------------------------ */
+        code = FetchColumnsBatched(ip, st, fetchStmt, fetchShared, fetchInlineLobs, numCols, maxRows, dateFmts, colLists, packKind, colNulls, &fetched);
+        if (code == TCL_OK)
+            code = ClockZoneCheck(ip);
+        if (code != TCL_OK)
+            goto cleanup;
+    } else if (st->fetchVarData) {
+        /* ------------------------------------------------------------------
+         * FAST PATH
+         * ------------------------------------------------------------------ */
+        int               moreRows   = 1;
+        uint32_t          batchStart = 0, batchCount = 0, batchPos = 0;
+        /* Snapshot cache pointers before reentrancy so callbacks that change
+         * fetch settings (orastmt -fetchrows) cannot cause UAF — fetchDead
+         * is checked at the top of every iteration. */
+        dpiData         **varData     = st->fetchVarData;
+        dpiNativeTypeNum *nativeTypes = st->fetchNativeTypes;
+        /* The -command script is the one reentrancy point that runs with a
+         * whole row pending; keep the snapshot path there and for LOBs,
+         * which need dpiLob_addRef under the gate. */
+        int               directConvert = !st->fetchHasLobCols && !cmd;
+
+        for (;;) {
+            if (fetchDead) {
+                Tcl_SetObjResult(ip, Tcl_NewStringObj("orafetch: statement closed during callback", -1));
+                code = TCL_ERROR;
+                goto cleanup;
+            }
+            if (ra && ra->discarded) {
+                Tcl_SetObjResult(ip, Tcl_NewStringObj("orafetch: statement re-parsed or reconfigured during callback", -1));
+                code = TCL_ERROR;
+                goto cleanup;
+            }
+
+            /* Drain the next batch when the current one is exhausted.
+             * Pass maxRows (when limited) rather than fetchArray so ODPI-C
+             * advances bufferRowIndex by at most the number of rows this call
+             * will consume.  Without this, a fetchArray-sized advance discards
+             * unprocessed buffered rows when the caller uses -max N < fetchArray
+             * across multiple orafetch calls. */
+            uint32_t batchLimit = (maxRows > 0 && maxRows < (Tcl_WideInt)st->fetchArray) ? (uint32_t)maxRows : st->fetchArray;
+            OradpiFetchCell *raRow = NULL;
+            if (ra) {
+                /* Readahead owns the define buffers; rows come from the
+                 * worker's snapshot instead. */
+                if (ReadaheadNextRow(ip, st, ra, &raRow) != TCL_OK) {
+                    code = TCL_ERROR;
+                    goto cleanup;
+                }
+                if (!raRow)
+                    break;
+            } else if (batchPos >= batchCount) {
+                if (!moreRows)
+                    break;
+
+                /* The gate is held only for the duration of one batch fetch
+                 * (which may trigger a network round-trip), then released
+                 * before processing any rows.  This allows async workers and
+                 * adopted-connection threads to acquire the gate between
+                 * batches. */
+                Oradpi_SharedConnGateEnter(fetchShared);
+                int fetchRc = FetchRowsLocked(st, fetchStmt, batchLimit, &batchStart, &batchCount, &moreRows);
+                if (fetchRc != DPI_SUCCESS) {
+                    Oradpi_SharedConnGateLeave(fetchShared);
+                    code = FetchRowsError(ip, st, fetchRc);
+                    goto cleanup;
+                }
+                Oradpi_SharedConnGateLeave(fetchShared);
+
+                if (batchCount == 0)
+                    break;
+                batchPos = 0;
+            }
+
+            uint32_t    rowIdx        = batchStart + batchPos++;
+            const char *snapshotWhere = NULL;
+            const char *snapshotMsg   = NULL;
+
+            memset(colVals, 0, colValBytes);
+
+            if (raRow) {
+                for (uint32_t c = 0; c < numCols; c++) {
+                    OradpiFetchCell *cell = &raRow[c];
+                    if (st->fetchIntern && st->fetchIntern[c] && cell->nt == DPI_NATIVE_TYPE_BYTES && !cell->isNull)
+                        colVals[c] = InternBytesObj(st->fetchIntern[c], st->internMax, cell->bytes, cell->bytesLen, 1);
+                    else
+                        colVals[c] = SnapshotCellToObj(ip, fetchShared, cell, DateFmtAt(dateFmts, c));
+                }
+            } else if (directConvert) {
+                /* Zero-copy conversion: with no LOB columns and no -command
+                 * callback, build each value straight from the define buffer.
+                 * Every column of the row is converted here, before any
+                 * variable trace can run, so no intermediate cell is needed. */
+                for (uint32_t c = 0; c < numCols; c++) {
+                    colVals[c] = ColumnValueObj(ip, st, c, nativeTypes[c], &varData[c][rowIdx], DateFmtAt(dateFmts, c));
+                    if (!colVals[c]) {
+                        Tcl_SetObjResult(ip, Tcl_NewStringObj("fetched byte value is too large", -1));
+                        code = TCL_ERROR;
+                        goto cleanup;
+                    }
+                }
+            } else {
+                FreeFetchCells(cells, numColsSize, fetchShared);
+                memset(cells, 0, cellBytes);
+
+                /* Snapshot directly from pre-defined var buffers without
+                 * dpiStmt_getQueryValue calls.  For scalar-only queries
+                 * (fetchHasLobCols == 0), SnapshotCellLocked does only pure
+                 * struct copies with no ODPI calls, so the connection gate is
+                 * unnecessary.  Skipping it eliminates per-row lock contention
+                 * when multiple interpreters share one session.  For LOB queries
+                 * the gate is still needed for dpiLob_addRef. */
+                int needGate = st->fetchHasLobCols;
+                if (needGate)
+                    Oradpi_SharedConnGateEnter(fetchShared);
+                for (uint32_t c = 0; c < numCols; c++) {
+                    dpiData *d = &varData[c][rowIdx];
+                    if (SnapshotCellLocked(fetchInlineLobs, nativeTypes[c], d, st->fetchIsChar[c], &cells[c], &snapshotWhere, &snapshotMsg) != TCL_OK) {
+                        if (needGate)
+                            Oradpi_SharedConnGateLeave(fetchShared);
+                        if (snapshotWhere)
+                            code = Oradpi_SetErrorFromODPI(ip, (OradpiBase *)st, snapshotWhere);
+                        else {
+                            Tcl_SetObjResult(ip, Tcl_NewStringObj(snapshotMsg ? snapshotMsg : "failed to snapshot fetched value", -1));
+                            code = TCL_ERROR;
+                        }
+                        goto cleanup;
+                    }
+                }
+                if (needGate)
+                    Oradpi_SharedConnGateLeave(fetchShared);
+
+                for (uint32_t c = 0; c < numCols; c++) {
+                    colVals[c] = SnapshotCellToObj(ip, fetchShared, &cells[c], DateFmtAt(dateFmts, c));
+                    if (!colVals[c]) {
+                        code = TCL_ERROR;
+                        goto cleanup;
+                    }
+                }
+            }
+            if (ClockZoneCheck(ip) != TCL_OK) {
+                code = TCL_ERROR;
+                goto cleanup;
+            }
+
+            if (colLists) {
+                /* -columns with readahead: rows arrive snapshotted, so
+                 * append row-major. */
+                for (uint32_t c = 0; c < numCols; c++)
+                    LAPPEND_GOTO(ip, colLists[c], colVals[c], code, cleanup);
+                memset(colVals, 0, colValBytes);
+                fetched++;
+                if (maxRows > 0 && (Tcl_WideInt)fetched >= maxRows)
+                    break;
+                continue;
+            }
+
+            /* --- Reentrancy zone --- */
+            if (dataVar || rowsList)
+                rowObj = FetchRowReuse(&rowReuse, numCols, asDict, colNames, colVals);
+            if ((dataVar || rowsList) && !rowObj) {
+                rowObj = Tcl_NewListObj(0, NULL);
+                Tcl_IncrRefCount(rowObj);
+                for (uint32_t c = 0; c < numCols; c++) {
+                    if (asDict) {
+                        LAPPEND_GOTO(ip, rowObj, colNames[c], code, cleanup);
+                        LAPPEND_GOTO(ip, rowObj, colVals[c], code, cleanup);
+                    } else {
+                        LAPPEND_GOTO(ip, rowObj, colVals[c], code, cleanup);
+                    }
+                }
+            }
+
+            if (dataArray) {
+                if (indexByNumber) {
+                    for (uint32_t c = 0; c < numCols; c++) {
+                        if (!Tcl_ObjSetVar2(ip, dataArray, numberKeys[c], colVals[c], TCL_LEAVE_ERR_MSG)) {
+                            code = TCL_ERROR;
+                            goto cleanup;
+                        }
+                    }
+                    if (!Oradpi_LookupStmt(ip, stmtNameSnap))
+                        fetchDead = 1;
+                } else if (indexByName) {
+                    for (uint32_t c = 0; c < numCols; c++) {
+                        if (!Tcl_ObjSetVar2(ip, dataArray, colNames[c], colVals[c], TCL_LEAVE_ERR_MSG)) {
+                            code = TCL_ERROR;
+                            goto cleanup;
+                        }
+                    }
+                    if (!Oradpi_LookupStmt(ip, stmtNameSnap))
+                        fetchDead = 1;
+                }
+            }
+
+            if (!fetchDead && dataVar && !FetchSetDataVar(ip, dataVar, rowObj, reuseOk ? &rowReuse : NULL)) {
+                code = TCL_ERROR;
+                goto cleanup;
+            }
+            if (!fetchDead && dataVar && !Oradpi_LookupStmt(ip, stmtNameSnap))
+                fetchDead = 1;
+
+            if (!fetchDead && cmd) {
+                int evalCode = Tcl_EvalObjEx(ip, cmd, TCL_EVAL_GLOBAL);
+                if (!Oradpi_LookupStmt(ip, stmtNameSnap))
+                    fetchDead = 1;
+                if (evalCode == TCL_BREAK) {
+                    FetchRowDone(&rowObj, reuseOk ? &rowReuse.row : NULL);
+                    memset(colVals, 0, colValBytes);
+                    fetched++;
+                    break;
+                }
+                if (evalCode == TCL_CONTINUE) {
+                    FetchRowDone(&rowObj, reuseOk ? &rowReuse.row : NULL);
+                    memset(colVals, 0, colValBytes);
+                    fetched++;
+                    if (maxRows > 0 && (Tcl_WideInt)fetched >= maxRows)
+                        break;
+                    continue;
+                }
+                if (evalCode != TCL_OK) {
+                    code = evalCode;
+                    goto cleanup;
+                }
+            }
+
+            if (rowsList) {
+                LAPPEND_GOTO(ip, rowsList, rowObj, code, cleanup);
+            }
+            FetchRowDone(&rowObj, reuseOk ? &rowReuse.row : NULL);
+            /* rowObj may have owned colVals[] elements; zero before next row. */
+            memset(colVals, 0, colValBytes);
+            fetched++;
+            if (maxRows > 0 && (Tcl_WideInt)fetched >= maxRows)
+                break;
+
+            /* The batch callback runs once the define buffers hold no
+             * unconverted rows (readahead rows are snapshots already). */
+            if (batchCmd)
+                batchPending++;
+            if (batchCmd && (ra ? batchPending >= (Tcl_Size)st->fetchArray : batchPos >= batchCount)) {
+                batchPending = 0;
+                int evalCode = FetchBatchCallback(ip, batchCmd, &rowsList);
+                if (!Oradpi_LookupStmt(ip, stmtNameSnap))
+                    fetchDead = 1;
+                if (evalCode == TCL_BREAK) {
+                    batchStop = 1;
+                    break;
+                }
+                if (evalCode != TCL_OK) {
+                    code = evalCode;
+                    goto cleanup;
+                }
+                if (!fetchDead && st->fetchVarData != varData) {
+                    code = Oradpi_SetError(ip, (OradpiBase *)st, -1, "orafetch: statement re-parsed or reconfigured during callback");
+                    goto cleanup;
+                }
+            }
+        }
+    } else {
+        /* ------------------------------------------------------------------
+         * FALLBACK PATH: dpiStmt_fetch + dpiStmt_getQueryValue per row
+         * ------------------------------------------------------------------ */
+        for (;;) {
+            int         hasRow         = 0;
+            uint32_t    bufferRowIndex = 0;
+            const char *snapshotWhere  = NULL;
+            const char *snapshotMsg    = NULL;
+
+            if (fetchDead) {
+                Tcl_SetObjResult(ip, Tcl_NewStringObj("orafetch: statement closed during callback", -1));
+                code = TCL_ERROR;
+                goto cleanup;
+            }
+
+            memset(colVals, 0, colValBytes);
+            FreeFetchCells(cells, numColsSize, fetchShared);
+            memset(cells, 0, cellBytes);
+
+            Oradpi_SharedConnGateEnter(fetchShared);
+            if (dpiStmt_fetch(fetchStmt, &hasRow, &bufferRowIndex) != DPI_SUCCESS) {
+                Oradpi_SharedConnGateLeave(fetchShared);
+                code = Oradpi_SetErrorFromODPI(ip, (OradpiBase *)st, "dpiStmt_fetch");
+                goto cleanup;
+            }
+            (void)bufferRowIndex;
+            if (!hasRow) {
+                Oradpi_SharedConnGateLeave(fetchShared);
+                break;
+            }
+
+            for (uint32_t c = 1; c <= numCols; c++) {
+                dpiNativeTypeNum nt;
+                dpiData         *d = NULL;
+                if (dpiStmt_getQueryValue(fetchStmt, c, &nt, &d) != DPI_SUCCESS) {
+                    Oradpi_SharedConnGateLeave(fetchShared);
+                    code = Oradpi_SetErrorFromODPI(ip, (OradpiBase *)st, "dpiStmt_getQueryValue");
+                    goto cleanup;
+                }
+                if (SnapshotCellLocked(fetchInlineLobs, nt, d, st->fetchIsChar[c - 1], &cells[c - 1], &snapshotWhere, &snapshotMsg) != TCL_OK) {
+                    Oradpi_SharedConnGateLeave(fetchShared);
                     if (snapshotWhere)
                         code = Oradpi_SetErrorFromODPI(ip, (OradpiBase *)st, snapshotWhere);
                     else {
@@ -801,308 +4918,1818 @@ int Oradpi_Cmd_Fetch(void *cd, Tcl_Interp *ip, Tcl_Size objc, Tcl_Obj *const obj
                     goto cleanup;
                 }
             }
-            if (needGate)
-                Oradpi_SharedConnGateLeave(fetchShared);
+            Oradpi_SharedConnGateLeave(fetchShared);
+
+            /* --- Reentrancy zone --- */
+            for (uint32_t c = 0; c < numCols; c++) {
+                colVals[c] = SnapshotCellToObj(ip, fetchShared, &cells[c], DateFmtAt(dateFmts, c));
+                if (!colVals[c]) {
+                    code = TCL_ERROR;
+                    goto cleanup;
+                }
+            }
+            if (ClockZoneCheck(ip) != TCL_OK) {
+                code = TCL_ERROR;
+                goto cleanup;
+            }
+
+            if (colLists) {
+                /* -columns on a statement without define buffers: append
+                 * row-major; there is nothing else to do for this row. */
+                for (uint32_t c = 0; c < numCols; c++)
+                    LAPPEND_GOTO(ip, colLists[c], colVals[c], code, cleanup);
+                memset(colVals, 0, colValBytes);
+                fetched++;
+                if (maxRows > 0 && (Tcl_WideInt)fetched >= maxRows)
+                    break;
+                continue;
+            }
+
+            if (dataVar || rowsList)
+                rowObj = FetchRowReuse(&rowReuse, numCols, asDict, colNames, colVals);
+            if ((dataVar || rowsList) && !rowObj) {
+                rowObj = Tcl_NewListObj(0, NULL);
+                Tcl_IncrRefCount(rowObj);
+                for (uint32_t c = 0; c < numCols; c++) {
+                    if (asDict) {
+                        LAPPEND_GOTO(ip, rowObj, colNames[c], code, cleanup);
+                        LAPPEND_GOTO(ip, rowObj, colVals[c], code, cleanup);
+                    } else {
+                        LAPPEND_GOTO(ip, rowObj, colVals[c], code, cleanup);
+                    }
+                }
+            }
+
+            if (dataArray) {
+                if (indexByNumber) {
+                    for (uint32_t c = 0; c < numCols; c++) {
+                        if (!Tcl_ObjSetVar2(ip, dataArray, numberKeys[c], colVals[c], TCL_LEAVE_ERR_MSG)) {
+                            code = TCL_ERROR;
+                            goto cleanup;
+                        }
+                    }
+                    if (!Oradpi_LookupStmt(ip, stmtNameSnap))
+                        fetchDead = 1;
+                } else if (indexByName) {
+                    for (uint32_t c = 0; c < numCols; c++) {
+                        if (!Tcl_ObjSetVar2(ip, dataArray, colNames[c], colVals[c], TCL_LEAVE_ERR_MSG)) {
+                            code = TCL_ERROR;
+                            goto cleanup;
+                        }
+                    }
+                    if (!Oradpi_LookupStmt(ip, stmtNameSnap))
+                        fetchDead = 1;
+                }
+            }
+
+            if (!fetchDead && dataVar && !FetchSetDataVar(ip, dataVar, rowObj, reuseOk ? &rowReuse : NULL)) {
+                code = TCL_ERROR;
+                goto cleanup;
+            }
+            if (!fetchDead && dataVar && !Oradpi_LookupStmt(ip, stmtNameSnap))
+                fetchDead = 1;
+
+            if (!fetchDead && cmd) {
+                int evalCode = Tcl_EvalObjEx(ip, cmd, TCL_EVAL_GLOBAL);
+                if (!Oradpi_LookupStmt(ip, stmtNameSnap))
+                    fetchDead = 1;
+                if (evalCode == TCL_BREAK) {
+                    FetchRowDone(&rowObj, reuseOk ? &rowReuse.row : NULL);
+                    memset(colVals, 0, colValBytes);
+                    fetched++;
+                    break;
+                }
+                if (evalCode == TCL_CONTINUE) {
+                    FetchRowDone(&rowObj, reuseOk ? &rowReuse.row : NULL);
+                    memset(colVals, 0, colValBytes);
+                    fetched++;
+                    if (maxRows > 0 && (Tcl_WideInt)fetched >= maxRows)
+                        break;
+                    continue;
+                }
+                if (evalCode != TCL_OK) {
+                    code = evalCode;
+                    goto cleanup;
+                }
+            }
+
+            if (rowsList) {
+                LAPPEND_GOTO(ip, rowsList, rowObj, code, cleanup);
+            }
+            FetchRowDone(&rowObj, reuseOk ? &rowReuse.row : NULL);
+            /* rowObj may have owned colVals[] elements; zero before next row. */
+            memset(colVals, 0, colValBytes);
+            fetched++;
+            if (maxRows > 0 && (Tcl_WideInt)fetched >= maxRows)
+                break;
+
+            if (batchCmd && ++batchPending >= (Tcl_Size)(st->fetchArray ? st->fetchArray : 1)) {
+                batchPending = 0;
+                int evalCode = FetchBatchCallback(ip, batchCmd, &rowsList);
+                if (!Oradpi_LookupStmt(ip, stmtNameSnap))
+                    fetchDead = 1;
+                if (evalCode == TCL_BREAK) {
+                    batchStop = 1;
+                    break;
+                }
+                if (evalCode != TCL_OK) {
+                    code = evalCode;
+                    goto cleanup;
+                }
+            }
+        }
+    }
+
+    /* The last, partial batch (or the rows up to -max). */
+    if (batchCmd && !batchStop && batchPending > 0) {
+        int evalCode = FetchBatchCallback(ip, batchCmd, &rowsList);
+        if (evalCode != TCL_OK && evalCode != TCL_BREAK) {
+            code = evalCode;
+            goto cleanup;
+        }
+    }
+
+    if (colLists) {
+        /* Keys are set once per call rather than once per row. */
+        Tcl_Obj *colsObj = Tcl_NewDictObj();
+        for (uint32_t c = 0; c < numCols; c++) {
+            Tcl_Obj *colObj = colLists[c];
+            if (packKind && packKind[c] != PACK_NONE) {
+                Tcl_Obj *triple[3] = {Tcl_NewStringObj(packKindNames[packKind[c]], -1), colLists[c], colNulls[c]};
+                colObj             = Tcl_NewListObj(3, triple);
+            }
+            if (Tcl_DictObjPut(ip, colsObj, colNames[c], colObj) != TCL_OK) {
+                Tcl_DecrRefCount(colsObj);
+                code = TCL_ERROR;
+                goto cleanup;
+            }
+        }
+        if (!Tcl_ObjSetVar2(ip, columnsVar, NULL, colsObj, TCL_LEAVE_ERR_MSG)) {
+            code = TCL_ERROR;
+            goto cleanup;
+        }
+    }
+
+    if (winKeep && rowsList && fetched > 0) {
+        uint64_t consumed = 0;
+        CONN_GATE_ENTER(st->owner);
+        if (dpiStmt_getRowCount(fetchStmt, &consumed) != DPI_SUCCESS)
+            consumed = 0;
+        CONN_GATE_LEAVE(st->owner);
+        if (consumed >= fetched)
+            ScrollWindowPut(st, winShape, consumed - fetched + 1, rowsList);
+    }
+
+    if (resultVar) {
+        Tcl_Obj *resultObj = rowsList ? rowsList : Tcl_NewListObj(0, NULL);
+        if (!Tcl_ObjSetVar2(ip, resultVar, NULL, resultObj, TCL_LEAVE_ERR_MSG)) {
+            code = TCL_ERROR;
+            goto cleanup;
+        }
+    }
+
+    if (returnRows) {
+        Tcl_SetObjResult(ip, rowsList ? rowsList : Tcl_NewListObj(0, NULL));
+        code = TCL_OK;
+        goto cleanup;
+    }
+
+    Tcl_SetObjResult(ip, Tcl_NewIntObj(fetched > 0 ? 0 : 1403));
+    code = TCL_OK;
+
+cleanup:
+    /* Release the addRef'd snapshot handles if they were acquired.
+     * Pre-loop gotos reach here with fetchStmt == NULL (never addRef'd). */
+    if (cells) {
+        FreeFetchCells(cells, numColsSize, fetchShared);
+        Tcl_Free((char *)cells);
+    }
+    if (ra)
+        ReadaheadRelease(ra);
+    if (fetchStmt)
+        dpiStmt_release(fetchStmt);
+    if (fetchShared)
+        Oradpi_SharedConnRelease(fetchShared);
+    if (stmtNameSnap)
+        Tcl_DecrRefCount(stmtNameSnap);
+    if (rowObj)
+        Tcl_DecrRefCount(rowObj);
+    if (dataVar)
+        RowReuseFinish(ip, dataVar, &rowReuse);
+    if (rowsList)
+        Tcl_DecrRefCount(rowsList);
+    if (lazyRows)
+        LazyRowsRelease(lazyRows);
+    if (colLists) {
+        for (uint32_t c = 0; c < numCols; c++)
+            Tcl_DecrRefCount(colLists[c]);
+        Tcl_Free((char *)colLists);
+    }
+    if (colNulls) {
+        for (uint32_t c = 0; c < numCols; c++)
+            if (colNulls[c])
+                Tcl_DecrRefCount(colNulls[c]);
+        Tcl_Free((char *)colNulls);
+    }
+    if (packKind)
+        Tcl_Free((char *)packKind);
+    if (numberKeys) {
+        for (uint32_t c = 0; c < numCols; c++) {
+            if (numberKeys[c])
+                Tcl_DecrRefCount(numberKeys[c]);
+        }
+        Tcl_Free((char *)numberKeys);
+    }
+    if (colVals) {
+        /* colVals[] entries are owned by rowObj or rowsList — they are
+         * released when those containers are freed above.  Any surviving
+         * non-NULL entry here still has a live owner; we must not touch
+         * its refcount.  Just free the pointer array itself. */
+        Tcl_Free((char *)colVals);
+    }
+    if (colNames) {
+        for (uint32_t c = 0; c < numCols; c++) {
+            if (colNames[c])
+                Tcl_DecrRefCount(colNames[c]);
+        }
+        Tcl_Free((char *)colNames);
+    }
+    if (dateFmts)
+        Tcl_Free((char *)dateFmts);
+    return code;
+}
+
+/* ==========================================================================
+ * oraresult create
+ *
+ * Rows of a statement go straight into the typed column vectors of an
+ * OradpiResult (cmd_result.c): numeric values stay binary, DATE and
+ * TIMESTAMP values take the -dateformat form, and decimal columns fetched
+ * as text are stored as doubles.
+ * ========================================================================== */
+
+typedef struct OradpiResultSink {
+    OradpiResult        *r;
+    uint32_t             numCols;
+    const unsigned char *dateFmts;
+    const unsigned char *numText;
+} OradpiResultSink;
+
+static int ResultSinkRow(Tcl_Interp *ip, void *sink, const OradpiFetchCell *row) {
+    OradpiResultSink *rs = (OradpiResultSink *)sink;
+    for (uint32_t c = 0; c < rs->numCols; c++) {
+        const OradpiFetchCell *cell = &row[c];
+        if (cell->lob)
+            return Oradpi_SetError(ip, NULL, -1, "oraresult: LOB locators cannot be stored");
+        if (cell->isNull) {
+            Oradpi_ResultPutNull(rs->r, c);
+            continue;
+        }
+        switch (cell->nt) {
+        case DPI_NATIVE_TYPE_INT64:
+            Oradpi_ResultPutInt(rs->r, c, cell->scalar.i64);
+            break;
+        case DPI_NATIVE_TYPE_UINT64:
+            if (cell->scalar.u64 <= (uint64_t)INT64_MAX)
+                Oradpi_ResultPutInt(rs->r, c, (int64_t)cell->scalar.u64);
+            else
+                Oradpi_ResultPutDouble(rs->r, c, (double)cell->scalar.u64);
+            break;
+        case DPI_NATIVE_TYPE_FLOAT:
+            Oradpi_ResultPutDouble(rs->r, c, (double)cell->scalar.f32);
+            break;
+        case DPI_NATIVE_TYPE_DOUBLE:
+            Oradpi_ResultPutDouble(rs->r, c, cell->scalar.f64);
+            break;
+        case DPI_NATIVE_TYPE_BOOLEAN:
+            Oradpi_ResultPutInt(rs->r, c, cell->scalar.boolean ? 1 : 0);
+            break;
+        case DPI_NATIVE_TYPE_TIMESTAMP: {
+            const dpiTimestamp *ts = &cell->scalar.ts;
+            char                buf[40];
+            switch (DateFmtAt(rs->dateFmts, c)) {
+            case ORADPI_DATEFMT_EPOCH:
+                Oradpi_ResultPutInt(rs->r, c, TimestampToEpochSeconds(ts));
+                break;
+            case ORADPI_DATEFMT_EPOCHMICROS:
+                Oradpi_ResultPutInt(rs->r, c, TimestampToEpochMicros(ts));
+                break;
+            case ORADPI_DATEFMT_CLOCK:
+                Oradpi_ResultPutInt(rs->r, c, TimestampToClockSeconds(ts));
+                break;
+            default:
+                Oradpi_ResultPutText(rs->r, c, buf, (size_t)FormatIsoTimestamp(buf, ts), 1);
+                break;
+            }
+            break;
+        }
+        case DPI_NATIVE_TYPE_BYTES:
+        case DPI_NATIVE_TYPE_LOB:
+            if (rs->numText && rs->numText[c]) {
+                /* Wide whole numbers stay exact while they fit int64. */
+                int64_t iv;
+                double  dv;
+                if (DecimalTextToInt64(cell->bytes, cell->bytesLen, &iv))
+                    Oradpi_ResultPutInt(rs->r, c, iv);
+                else if (DecimalTextToDouble(ip, cell->bytes, cell->bytesLen, &dv) != TCL_OK)
+                    return TCL_ERROR;
+                else
+                    Oradpi_ResultPutDouble(rs->r, c, dv);
+            } else
+                Oradpi_ResultPutText(rs->r, c, cell->bytes, (size_t)cell->bytesLen, cell->colIsChar);
+            break;
+        default:
+            Oradpi_ResultPutNull(rs->r, c);
+            break;
+        }
+    }
+    Oradpi_ResultEndRow(rs->r);
+    return ClockZoneCheck(ip);
+}
+
+/* Fetch up to maxRows rows (0 = all) of st into a new result.  dateFormat
+ * is an ORADPI_DATEFMT_* value or -1 for the statement's. */
+int Oradpi_FetchToResult(Tcl_Interp *ip, OradpiStmt *st, Tcl_WideInt maxRows, int dateFormat, OradpiResult **resultOut) {
+    uint32_t         numCols  = 0;
+    unsigned char   *dateFmts = NULL;
+    OradpiReadahead *ra       = NULL;
+    OradpiResultSink rs;
+    uint64_t         fetched  = 0;
+    int              code;
+
+    *resultOut = NULL;
+    if (!st->stmt)
+        return Oradpi_SetError(ip, (OradpiBase *)st, -1, "statement is not prepared or connection closed");
+    if (Oradpi_StmtIsAsyncBusy(st))
+        return Oradpi_SetError(ip, (OradpiBase *)st, -1, "statement is busy (async operation in progress)");
+    if (st->fetchRedefine && !st->rcHit && FetchCacheRedefine(ip, st) != TCL_OK)
+        return TCL_ERROR;
+    if (st->fetchCacheNumCols > 0)
+        numCols = st->fetchCacheNumCols;
+    else {
+        CONN_GATE_ENTER(st->owner);
+        if (dpiStmt_getNumQueryColumns(st->stmt, &numCols) != DPI_SUCCESS) {
+            CONN_GATE_LEAVE(st->owner);
+            return Oradpi_SetErrorFromODPI(ip, (OradpiBase *)st, "dpiStmt_getNumQueryColumns");
+        }
+        CONN_GATE_LEAVE(st->owner);
+    }
+    if (numCols == 0)
+        return Oradpi_SetError(ip, (OradpiBase *)st, -1, "oraresult: statement is not an executed query");
+    if (st->fetchCacheNumCols != numCols && BuildFetchCache(ip, st, numCols) != TCL_OK)
+        return TCL_ERROR;
+    if (st->rcHit && (st->rcHit->numCols != numCols || !st->fetchVarData)) {
+        ResultCacheUnlist(st->rcHit);
+        ResultCacheForget(st);
+        return Oradpi_SetError(ip, (OradpiBase *)st, -1, "oraresult: cached result no longer matches the query; execute it again");
+    }
 
-            /* --- Reentrancy zone --- */
-            for (uint32_t c = 0; c < numCols; c++) {
-                colVals[c] = SnapshotCellToObj(ip, fetchShared, &cells[c]);
-                if (!colVals[c]) {
-                    code = TCL_ERROR;
-                    goto cleanup;
-                }
-            }
+    dpiStmt       *fetchStmt = st->stmt;
+    GlobalConnRec *shared    = st->owner ? st->owner->shared : NULL;
+    if (dpiStmt_addRef(fetchStmt) != DPI_SUCCESS)
+        return Oradpi_SetErrorFromODPI(ip, (OradpiBase *)st, "dpiStmt_addRef (fetch hold)");
+    if (shared)
+        Oradpi_SharedConnAddRef(shared);
+    ra = ReadaheadEnsure(st);
+    if (ra) {
+        Tcl_MutexLock(&ra->lock);
+        ra->refCount++;
+        Tcl_MutexUnlock(&ra->lock);
+    }
 
-            if (dataVar || rowsList) {
-                rowObj = Tcl_NewListObj(0, NULL);
-                Tcl_IncrRefCount(rowObj);
-                for (uint32_t c = 0; c < numCols; c++) {
-                    if (asDict) {
-                        LAPPEND_GOTO(ip, rowObj, colNames[c], code, cleanup);
-                        LAPPEND_GOTO(ip, rowObj, colVals[c], code, cleanup);
-                    } else {
-                        LAPPEND_GOTO(ip, rowObj, colVals[c], code, cleanup);
-                    }
-                }
-            }
+    dateFmts    = ResolveDateFmts(st, numCols, dateFormat >= 0 ? dateFormat : st->dateFormat);
+    ClockZoneBegin();
+    rs.r        = Oradpi_ResultNew(numCols, st->fetchColNames);
+    rs.numCols  = numCols;
+    rs.dateFmts = dateFmts;
+    rs.numText  = st->fetchNumText;
+    code        = FetchCellRows(ip, st, fetchStmt, shared, ra, numCols, ResultSinkRow, &rs, maxRows, &fetched);
 
-            if (dataArray) {
-                if (indexByNumber) {
-                    for (uint32_t c = 0; c < numCols; c++) {
-                        if (!Tcl_ObjSetVar2(ip, dataArray, numberKeys[c], colVals[c], TCL_LEAVE_ERR_MSG)) {
-                            code = TCL_ERROR;
-                            goto cleanup;
-                        }
-                    }
-                    if (!Oradpi_LookupStmt(ip, stmtNameSnap))
-                        fetchDead = 1;
-                } else if (indexByName) {
-                    for (uint32_t c = 0; c < numCols; c++) {
-                        if (!Tcl_ObjSetVar2(ip, dataArray, colNames[c], colVals[c], TCL_LEAVE_ERR_MSG)) {
-                            code = TCL_ERROR;
-                            goto cleanup;
-                        }
-                    }
-                    if (!Oradpi_LookupStmt(ip, stmtNameSnap))
-                        fetchDead = 1;
-                }
-            }
+    if (ra)
+        ReadaheadRelease(ra);
+    dpiStmt_release(fetchStmt);
+    if (shared)
+        Oradpi_SharedConnRelease(shared);
+    if (dateFmts)
+        Tcl_Free((char *)dateFmts);
+    if (code != TCL_OK) {
+        Oradpi_ResultFree(rs.r);
+        return code;
+    }
+    *resultOut = rs.r;
+    return TCL_OK;
+}
 
-            if (!fetchDead && dataVar && !Tcl_ObjSetVar2(ip, dataVar, NULL, rowObj, TCL_LEAVE_ERR_MSG)) {
-                code = TCL_ERROR;
-                goto cleanup;
-            }
-            if (!fetchDead && dataVar && !Oradpi_LookupStmt(ip, stmtNameSnap))
-                fetchDead = 1;
+/* ==========================================================================
+ * orafetchasync
+ *
+ * A pool job drains the cursor in batches of -batch rows, read with
+ * dpiStmt_fetchRows from the statement's define buffers.  Each batch is
+ * snapshotted into OradpiFetchCell arrays on the worker and posted to the
+ * owning thread with Tcl_ThreadQueueEvent; the event handler builds the
+ * row lists and invokes the callback there.  At most
+ * ORADPI_FETCHASYNC_MAX_INFLIGHT batches are queued at once, so a slow
+ * callback throttles the worker instead of growing the event queue.
+ * ========================================================================== */
 
-            if (!fetchDead && cmd) {
-                int evalCode = Tcl_EvalObjEx(ip, cmd, TCL_EVAL_GLOBAL);
-                if (!Oradpi_LookupStmt(ip, stmtNameSnap))
-                    fetchDead = 1;
-                if (evalCode == TCL_BREAK) {
-                    if (rowObj) {
-                        Tcl_DecrRefCount(rowObj);
-                        rowObj = NULL;
+#define ORADPI_FETCHASYNC_MAX_INFLIGHT 2
+
+typedef struct OradpiFetchAsync {
+    Tcl_Mutex         lock;
+    Tcl_Condition     cond;
+    int               refCount;   /* statement + worker job + queued events */
+    int               canceled;
+    int               workerDone; /* job has returned (or will never run) */
+    int               inCall;     /* worker is inside an ODPI fetch */
+    int               inFlight;   /* batch events queued but not yet handled */
+
+    dpiConn          *conn;   /* addRef'd, for orabreak-style cancellation */
+    dpiStmt          *stmt;   /* addRef'd */
+    GlobalConnRec    *shared; /* SharedConnAddRef'd */
+    Tcl_ThreadId      ownerTid;
+    uint32_t          numCols;
+    uint32_t          batchRows;
+    int               inlineLobs;
+    int              *isChar;      /* [numCols] */
+    dpiData         **varData;     /* [numCols] define buffers, or NULL */
+    dpiNativeTypeNum *nativeTypes; /* [numCols] with varData */
+    unsigned char    *dateFmt;     /* [numCols] ORADPI_DATEFMT_*, fixed at submit */
+    unsigned char    *longLob;     /* [numCols] or NULL; see fetchLongLob */
+    uint32_t          lobMax;
+
+    /* Owning thread only; cleared by FetchAsyncDetach. */
+    int               detached;
+    OradpiStmt       *st;
+    Tcl_Interp       *ip;
+    Tcl_Obj          *cmd;
+} OradpiFetchAsync;
+
+typedef struct OradpiFetchAsyncEvent {
+    Tcl_Event         header;
+    OradpiFetchAsync *fa;
+    OradpiFetchCell  *cells; /* [rows * numCols] */
+    uint32_t          rows;
+    int               final;
+    uint64_t          total;
+    int               errCode;
+    char             *errMsg; /* final event only; NULL on success */
+} OradpiFetchAsyncEvent;
+
+static void FetchAsyncRelease(OradpiFetchAsync *fa) {
+    Tcl_MutexLock(&fa->lock);
+    int doFree = (--fa->refCount == 0);
+    Tcl_MutexUnlock(&fa->lock);
+    if (!doFree)
+        return;
+    Tcl_Free((char *)fa->isChar);
+    if (fa->varData) {
+        Tcl_Free((char *)fa->varData);
+        Tcl_Free((char *)fa->nativeTypes);
+    }
+    if (fa->longLob)
+        Tcl_Free((char *)fa->longLob);
+    Tcl_Free((char *)fa->dateFmt);
+    if (fa->stmt)
+        dpiStmt_release(fa->stmt);
+    if (fa->conn)
+        dpiConn_release(fa->conn);
+    if (fa->shared)
+        Oradpi_SharedConnRelease(fa->shared);
+    Tcl_ConditionFinalize(&fa->cond);
+    Tcl_MutexFinalize(&fa->lock);
+    Tcl_Free((char *)fa);
+}
+
+/* Owning thread: unhook fa from its statement and drop the Tcl_Obj
+ * state.  Events still queued see detached and only free their payload. */
+static void FetchAsyncDetach(OradpiFetchAsync *fa) {
+    if (fa->detached)
+        return;
+    fa->detached = 1;
+    if (fa->st && fa->st->fetchAsync == fa)
+        fa->st->fetchAsync = NULL;
+    fa->st = NULL;
+    fa->ip = NULL;
+    if (fa->cmd) {
+        Tcl_DecrRefCount(fa->cmd);
+        fa->cmd = NULL;
+    }
+    FetchAsyncRelease(fa);
+}
+
+static int  FetchAsyncEventProc(Tcl_Event *evPtr, int flags);
+
+/* Worker side: hand a batch (or the final status) to the owning thread. */
+static void FetchAsyncPost(OradpiFetchAsync *fa, OradpiFetchCell *cells, uint32_t rows, int final, uint64_t total, int errCode, char *errMsg) {
+    OradpiFetchAsyncEvent *ev = (OradpiFetchAsyncEvent *)Tcl_Alloc(sizeof(*ev));
+    memset(ev, 0, sizeof(*ev));
+    ev->header.proc = FetchAsyncEventProc;
+    ev->fa          = fa;
+    ev->cells       = cells;
+    ev->rows        = rows;
+    ev->final       = final;
+    ev->total       = total;
+    ev->errCode     = errCode;
+    ev->errMsg      = errMsg;
+    Tcl_MutexLock(&fa->lock);
+    fa->refCount++;
+    if (!final)
+        fa->inFlight++;
+    Tcl_MutexUnlock(&fa->lock);
+    Tcl_ThreadQueueEvent(fa->ownerTid, &ev->header, TCL_QUEUE_TAIL);
+    Tcl_ThreadAlert(fa->ownerTid);
+}
+
+static char *FetchAsyncCopyMessage(const char *msg, size_t len) {
+    char *copy = (char *)Tcl_Alloc((size_t)len + 1);
+    memcpy(copy, msg, len);
+    copy[len] = '\0';
+    return copy;
+}
+
+/* Worker body.  Follows the worker contract in cmd_int.h. */
+static void FetchAsyncJob(void *clientData, int canceled) {
+    OradpiFetchAsync *fa      = (OradpiFetchAsync *)clientData;
+    uint64_t          total   = 0;
+    int               failed  = 0;
+    int               errCode = 0;
+    char             *errMsg  = NULL;
+    int               more    = !canceled;
+    size_t            rowCells = (size_t)fa->numCols;
+
+    while (more) {
+        Tcl_MutexLock(&fa->lock);
+        while (!fa->canceled && fa->inFlight >= ORADPI_FETCHASYNC_MAX_INFLIGHT)
+            Tcl_ConditionWait(&fa->cond, &fa->lock, NULL);
+        int stop = fa->canceled;
+        if (!stop)
+            fa->inCall = 1;
+        Tcl_MutexUnlock(&fa->lock);
+        if (stop)
+            break;
+
+        size_t cellBytes = 0;
+        if (Oradpi_CheckedAllocBytes(NULL, (Tcl_Size)fa->batchRows * fa->numCols, sizeof(OradpiFetchCell), &cellBytes, NULL) != TCL_OK) {
+            failed = 1;
+            errMsg = FetchAsyncCopyMessage("orafetchasync: batch is too large", strlen("orafetchasync: batch is too large"));
+            Tcl_MutexLock(&fa->lock);
+            fa->inCall = 0;
+            Tcl_MutexUnlock(&fa->lock);
+            break;
+        }
+        OradpiFetchCell *cells = (OradpiFetchCell *)Tcl_Alloc(cellBytes);
+        memset(cells, 0, cellBytes);
+        uint32_t rows = 0;
+
+        Oradpi_SharedConnGateEnter(fa->shared);
+        /* Whole batches from the define buffers, as the readahead worker
+         * does; without defines (object columns) fall back to row by row. */
+        while (fa->varData && more && rows < fa->batchRows && !failed) {
+            uint32_t start = 0, got = 0;
+            int      moreRows = 0;
+            if (dpiStmt_fetchRows(fa->stmt, fa->batchRows - rows, &start, &got, &moreRows) != DPI_SUCCESS) {
+                failed = 1;
+                break;
+            }
+            if (fa->longLob && LongLobOverflow(fa->varData, fa->longLob, fa->numCols, fa->lobMax, start, got)) {
+                failed = 1;
+                errMsg = FetchAsyncCopyMessage(lobOverflowMsg, strlen(lobOverflowMsg));
+                break;
+            }
+            for (uint32_t r = 0; r < got && !failed; r++) {
+                for (uint32_t c = 0; c < fa->numCols; c++) {
+                    const char *where = NULL;
+                    const char *msg   = NULL;
+                    if (SnapshotCellLocked(fa->inlineLobs, fa->nativeTypes[c], &fa->varData[c][start + r], fa->isChar[c], &cells[rows * rowCells + c], &where, &msg) != TCL_OK) {
+                        failed = 1;
+                        if (msg)
+                            errMsg = FetchAsyncCopyMessage(msg, strlen(msg));
+                        break;
                     }
-                    memset(colVals, 0, colValBytes);
-                    fetched++;
-                    break;
                 }
-                if (evalCode == TCL_CONTINUE) {
-                    if (rowObj) {
-                        Tcl_DecrRefCount(rowObj);
-                        rowObj = NULL;
-                    }
-                    memset(colVals, 0, colValBytes);
-                    fetched++;
-                    if (maxRows > 0 && (Tcl_WideInt)fetched >= maxRows)
-                        break;
-                    continue;
+                if (!failed)
+                    rows++;
+            }
+            if (!moreRows)
+                more = 0;
+        }
+        while (!fa->varData && rows < fa->batchRows && !failed) {
+            int      hasRow         = 0;
+            uint32_t bufferRowIndex = 0;
+            if (dpiStmt_fetch(fa->stmt, &hasRow, &bufferRowIndex) != DPI_SUCCESS) {
+                failed = 1;
+                break;
+            }
+            if (!hasRow) {
+                more = 0;
+                break;
+            }
+            for (uint32_t c = 0; c < fa->numCols; c++) {
+                dpiNativeTypeNum nt;
+                dpiData         *d     = NULL;
+                const char      *where = NULL;
+                const char      *msg   = NULL;
+                int              bad   = dpiStmt_getQueryValue(fa->stmt, c + 1, &nt, &d) != DPI_SUCCESS;
+                if (!bad && fa->longLob && fa->longLob[c] && !d->isNull && d->value.asBytes.length > fa->lobMax) {
+                    bad = 1;
+                    msg = lobOverflowMsg;
                 }
-                if (evalCode != TCL_OK) {
-                    code = evalCode;
-                    goto cleanup;
+                if (bad || SnapshotCellLocked(fa->inlineLobs, nt, d, fa->isChar[c], &cells[rows * rowCells + c], &where, &msg) != TCL_OK) {
+                    failed = 1;
+                    if (msg)
+                        errMsg = FetchAsyncCopyMessage(msg, strlen(msg));
+                    break;
                 }
             }
+            if (!failed)
+                rows++;
+        }
+        if (failed && !errMsg) {
+            dpiErrorInfo ei;
+            memset(&ei, 0, sizeof(ei));
+            (void)Oradpi_CaptureODPIError(&ei);
+            errCode = (int)ei.code;
+            if (ei.message && ei.messageLength > 0)
+                errMsg = FetchAsyncCopyMessage(ei.message, ei.messageLength);
+        }
+        Oradpi_SharedConnGateLeave(fa->shared);
 
-            if (rowsList) {
-                LAPPEND_GOTO(ip, rowsList, rowObj, code, cleanup);
+        Tcl_MutexLock(&fa->lock);
+        fa->inCall = 0;
+        int stopNow = fa->canceled;
+        Tcl_MutexUnlock(&fa->lock);
+
+        if (failed || stopNow || rows == 0) {
+            /* A partially snapshotted row is discarded with the batch. */
+            FreeFetchCells(cells, (Tcl_Size)(rows + (failed ? 1 : 0)) * fa->numCols, fa->shared);
+            Tcl_Free((char *)cells);
+            if (failed || stopNow)
+                break;
+            continue;
+        }
+        total += rows;
+        FetchAsyncPost(fa, cells, rows, 0, 0, 0, NULL);
+    }
+
+    Tcl_MutexLock(&fa->lock);
+    int wasCanceled = fa->canceled || canceled;
+    Tcl_MutexUnlock(&fa->lock);
+    if (wasCanceled) {
+        if (errMsg)
+            Tcl_Free(errMsg);
+    } else if (failed) {
+        if (!errMsg)
+            errMsg = FetchAsyncCopyMessage("orafetchasync: fetch failed", strlen("orafetchasync: fetch failed"));
+        FetchAsyncPost(fa, NULL, 0, 1, total, errCode ? errCode : -1, errMsg);
+    } else
+        FetchAsyncPost(fa, NULL, 0, 1, total, 0, NULL);
+
+    Tcl_MutexLock(&fa->lock);
+    fa->workerDone = 1;
+    Tcl_ConditionNotify(&fa->cond);
+    Tcl_MutexUnlock(&fa->lock);
+    FetchAsyncRelease(fa);
+}
+
+static int FetchAsyncEventProc(Tcl_Event *evPtr, int flags) {
+    (void)flags;
+    OradpiFetchAsyncEvent *ev = (OradpiFetchAsyncEvent *)evPtr;
+    OradpiFetchAsync      *fa = ev->fa;
+
+    if (!fa->detached && fa->ip && !Tcl_InterpDeleted(fa->ip)) {
+        Tcl_Interp *ip     = fa->ip;
+        OradpiStmt *st     = fa->st;
+        Tcl_Obj    *status = NULL;
+        Tcl_Obj    *data   = NULL;
+        int         stop   = ev->final;
+
+        if (!ev->final) {
+            ClockZoneBegin();
+            data = Tcl_NewListObj(0, NULL);
+            for (uint32_t r = 0; r < ev->rows; r++) {
+                Tcl_Obj *row = Tcl_NewListObj(0, NULL);
+                for (uint32_t c = 0; c < fa->numCols; c++)
+                    (void)Tcl_ListObjAppendElement(NULL, row, SnapshotCellToObj(ip, fa->shared, &ev->cells[(size_t)r * fa->numCols + c], fa->dateFmt[c]));
+                (void)Tcl_ListObjAppendElement(NULL, data, row);
             }
-            if (rowObj) {
-                Tcl_DecrRefCount(rowObj);
-                rowObj = NULL;
+            if (ClockZoneCheck(ip) == TCL_OK)
+                status = Tcl_NewStringObj("rows", -1);
+            else {
+                /* A date with no local time ends the fetch like a fetch
+                 * error: this batch becomes the error callback. */
+                Tcl_IncrRefCount(data);
+                Tcl_DecrRefCount(data);
+                data = Tcl_GetObjResult(ip);
+                (void)Oradpi_SetError(NULL, (OradpiBase *)st, -1, Tcl_GetString(data));
+                status = Tcl_NewStringObj("error", -1);
+                stop   = 1;
             }
-            /* rowObj may have owned colVals[] elements; zero before next row. */
-            memset(colVals, 0, colValBytes);
-            fetched++;
-            if (maxRows > 0 && (Tcl_WideInt)fetched >= maxRows)
+        } else if (ev->errMsg) {
+            (void)Oradpi_SetError(NULL, (OradpiBase *)st, ev->errCode, ev->errMsg);
+            status = Tcl_NewStringObj("error", -1);
+            data   = Tcl_NewStringObj(ev->errMsg, -1);
+        } else {
+            Oradpi_RecordRows((OradpiBase *)st, ev->total);
+            status = Tcl_NewStringObj("done", -1);
+            data   = Tcl_NewWideIntObj((Tcl_WideInt)ev->total);
+        }
+
+        Tcl_Obj *cmd = Tcl_DuplicateObj(fa->cmd);
+        Tcl_IncrRefCount(cmd);
+        (void)Tcl_ListObjAppendElement(NULL, cmd, st->base.name);
+        (void)Tcl_ListObjAppendElement(NULL, cmd, status);
+        (void)Tcl_ListObjAppendElement(NULL, cmd, data);
+
+        /* The statement is free for other commands once the last
+         * callback runs. */
+        if (!ev->final && stop)
+            Oradpi_FetchAsyncCancel(st);
+        else if (ev->final)
+            FetchAsyncDetach(fa);
+
+        Tcl_Preserve(ip);
+        int rc = Tcl_EvalObjEx(ip, cmd, TCL_EVAL_GLOBAL);
+        if (rc == TCL_ERROR)
+            Tcl_BackgroundException(ip, rc);
+        /* An error or break from a batch callback stops the fetch; the
+         * callback may also have closed or re-parsed the statement. */
+        if ((rc == TCL_ERROR || rc == TCL_BREAK) && !fa->detached)
+            Oradpi_FetchAsyncCancel(fa->st);
+        Tcl_Release(ip);
+        Tcl_DecrRefCount(cmd);
+    }
+
+    if (ev->cells) {
+        FreeFetchCells(ev->cells, (Tcl_Size)ev->rows * fa->numCols, fa->shared);
+        Tcl_Free((char *)ev->cells);
+    }
+    if (ev->errMsg)
+        Tcl_Free(ev->errMsg);
+    if (!ev->final) {
+        Tcl_MutexLock(&fa->lock);
+        fa->inFlight--;
+        Tcl_ConditionNotify(&fa->cond);
+        Tcl_MutexUnlock(&fa->lock);
+    }
+    FetchAsyncRelease(fa);
+    /* Tcl frees the event itself once the handler returns 1. */
+    return 1;
+}
+
+void Oradpi_FetchAsyncCancel(OradpiStmt *s) {
+    OradpiFetchAsync *fa = s ? s->fetchAsync : NULL;
+    if (!fa)
+        return;
+    Tcl_MutexLock(&fa->lock);
+    fa->canceled = 1;
+    int inCall   = fa->inCall;
+    Tcl_ConditionNotify(&fa->cond);
+    Tcl_MutexUnlock(&fa->lock);
+    if (inCall)
+        Oradpi_SharedConnBreak(fa->shared, fa->conn);
+
+    Tcl_MutexLock(&fa->lock);
+    while (!fa->workerDone)
+        Tcl_ConditionWait(&fa->cond, &fa->lock, NULL);
+    Tcl_MutexUnlock(&fa->lock);
+    FetchAsyncDetach(fa);
+}
+
+/*
+ * orafetchasync statement-handle ?-batch rows? -command script
+ *
+ *   Fetches the remaining rows of an executed query on the worker pool.
+ *   script is called from the event loop as
+ *       script statement-handle rows rowList     (once per batch)
+ *       script statement-handle done rowCount    (after the last row)
+ *       script statement-handle error message    (on fetch failure)
+ *   The statement is busy until the done/error callback.
+ *   Returns: 0 on successful submission.
+ */
+int Oradpi_Cmd_FetchAsync(void *cd, Tcl_Interp *ip, Tcl_Size objc, Tcl_Obj *const objv[]) {
+    (void)cd;
+    if (objc < 4 || (objc % 2) != 0) {
+        Tcl_WrongNumArgs(ip, 1, objv, "statement-handle ?-batch rows? -command script");
+        return TCL_ERROR;
+    }
+    OradpiStmt *st = Oradpi_LookupStmt(ip, objv[1]);
+    if (!st)
+        return Oradpi_SetError(ip, NULL, -1, "invalid statement handle");
+    if (!st->stmt || !st->owner || !st->owner->conn)
+        return Oradpi_SetError(ip, (OradpiBase *)st, -1, "statement is not prepared or connection closed");
+    if (Oradpi_StmtIsAsyncBusy(st))
+        return Oradpi_SetError(ip, (OradpiBase *)st, -1, "statement is busy (async operation in progress)");
+
+    static const char *const fetchAsyncOpts[] = {"-batch", "-command", NULL};
+    enum FetchAsyncOptIdx { FAOPT_BATCH, FAOPT_COMMAND };
+    uint32_t batchRows = st->fetchArray ? st->fetchArray : 100;
+    Tcl_Obj *cmd       = NULL;
+    for (Tcl_Size i = 2; i < objc; i += 2) {
+        int optIdx;
+        if (Tcl_GetIndexFromObj(ip, objv[i], fetchAsyncOpts, "option", 0, &optIdx) != TCL_OK)
+            return TCL_ERROR;
+        switch ((enum FetchAsyncOptIdx)optIdx) {
+        case FAOPT_BATCH:
+            if (Oradpi_GetUInt32FromObj(ip, objv[i + 1], &batchRows, "-batch") != TCL_OK)
+                return TCL_ERROR;
+            if (batchRows == 0)
+                return Oradpi_SetError(ip, (OradpiBase *)st, -1, "orafetchasync: -batch must be > 0");
+            break;
+        case FAOPT_COMMAND:
+            cmd = objv[i + 1];
+            break;
+        }
+    }
+    if (!cmd)
+        return Oradpi_SetError(ip, (OradpiBase *)st, -1, "orafetchasync: -command is required");
+
+    if (st->rcHit || (st->ra && st->ra->cached))
+        return Oradpi_SetError(ip, (OradpiBase *)st, -1, "orafetchasync: the result is served from the result cache; use orafetch");
+
+    /* Rows already read ahead would be skipped by the worker. */
+    Oradpi_ReadaheadDiscard(st);
+    if (st->fetchRedefine && FetchCacheRedefine(ip, st) != TCL_OK)
+        return TCL_ERROR;
+
+    uint32_t numCols = 0;
+    CONN_GATE_ENTER(st->owner);
+    if (dpiStmt_getNumQueryColumns(st->stmt, &numCols) != DPI_SUCCESS) {
+        CONN_GATE_LEAVE(st->owner);
+        return Oradpi_SetErrorFromODPI(ip, (OradpiBase *)st, "dpiStmt_getNumQueryColumns");
+    }
+    CONN_GATE_LEAVE(st->owner);
+    if (numCols == 0)
+        return Oradpi_SetError(ip, (OradpiBase *)st, -1, "orafetchasync: statement is not an executed query");
+    /* The worker reads batches from the same define buffers as orafetch. */
+    if (st->fetchCacheNumCols != numCols && BuildFetchCache(ip, st, numCols) != TCL_OK)
+        return TCL_ERROR;
+
+    size_t isCharBytes = 0;
+    if (Oradpi_CheckedAllocBytes(ip, (Tcl_Size)numCols, sizeof(int), &isCharBytes, "column type table") != TCL_OK)
+        return TCL_ERROR;
+    int *isChar = (int *)Tcl_Alloc(isCharBytes);
+    /* Date formats are fixed now: coltypes overrides from a fetch cache
+     * that still describes this result, else the statement's dateformat. */
+    const unsigned char *colDateFmt = (st->fetchCacheNumCols == numCols) ? st->fetchDateFmt : NULL;
+    unsigned char       *dateFmt    = (unsigned char *)Tcl_Alloc(numCols);
+    CONN_GATE_ENTER(st->owner);
+    for (uint32_t c = 0; c < numCols; c++) {
+        dpiQueryInfo qi;
+        if (dpiStmt_getQueryInfo(st->stmt, c + 1, &qi) != DPI_SUCCESS) {
+            CONN_GATE_LEAVE(st->owner);
+            Tcl_Free((char *)isChar);
+            Tcl_Free((char *)dateFmt);
+            return Oradpi_SetErrorFromODPI(ip, (OradpiBase *)st, "dpiStmt_getQueryInfo");
+        }
+        isChar[c] = is_char_type(qi.typeInfo.oracleTypeNum);
+        int f     = (colDateFmt && colDateFmt[c] != DATEFMT_NONE) ? colDateFmt[c] : st->dateFormat;
+        if (f == ORADPI_DATEFMT_CLOCK && IsZonedTimestampType(qi.typeInfo.oracleTypeNum))
+            f = ORADPI_DATEFMT_EPOCH;
+        dateFmt[c] = (unsigned char)f;
+    }
+    CONN_GATE_LEAVE(st->owner);
+
+    if (dpiStmt_addRef(st->stmt) != DPI_SUCCESS) {
+        Tcl_Free((char *)isChar);
+        Tcl_Free((char *)dateFmt);
+        return Oradpi_SetErrorFromODPI(ip, (OradpiBase *)st, "dpiStmt_addRef");
+    }
+    if (dpiConn_addRef(st->owner->conn) != DPI_SUCCESS) {
+        dpiStmt_release(st->stmt);
+        Tcl_Free((char *)isChar);
+        Tcl_Free((char *)dateFmt);
+        return Oradpi_SetErrorFromODPI(ip, (OradpiBase *)st->owner, "dpiConn_addRef");
+    }
+
+    OradpiFetchAsync *fa = (OradpiFetchAsync *)Tcl_Alloc(sizeof(*fa));
+    memset(fa, 0, sizeof(*fa));
+    fa->refCount   = 2; /* statement + worker job */
+    fa->conn       = st->owner->conn;
+    fa->stmt       = st->stmt;
+    fa->shared     = st->owner->shared;
+    Oradpi_SharedConnAddRef(fa->shared);
+    fa->ownerTid   = Tcl_GetCurrentThread();
+    fa->numCols    = numCols;
+    fa->batchRows  = batchRows;
+    fa->inlineLobs = st->owner->inlineLobs;
+    if (st->fetchLongLob && st->fetchCacheNumCols == numCols) {
+        fa->longLob = (unsigned char *)Tcl_Alloc(numCols);
+        memcpy(fa->longLob, st->fetchLongLob, numCols);
+        fa->lobMax = st->fetchLobMax;
+    }
+    if (st->fetchVarData) {
+        fa->varData     = (dpiData **)Tcl_Alloc(numCols * sizeof(dpiData *));
+        fa->nativeTypes = (dpiNativeTypeNum *)Tcl_Alloc(numCols * sizeof(dpiNativeTypeNum));
+        memcpy(fa->varData, st->fetchVarData, numCols * sizeof(dpiData *));
+        memcpy(fa->nativeTypes, st->fetchNativeTypes, numCols * sizeof(dpiNativeTypeNum));
+        memcpy(isChar, st->fetchIsChar, numCols * sizeof(int));
+    }
+    fa->isChar     = isChar;
+    fa->dateFmt    = dateFmt;
+    fa->st         = st;
+    fa->ip         = ip;
+    fa->cmd        = cmd;
+    Tcl_IncrRefCount(cmd);
+    st->fetchAsync = fa;
+
+    if (Oradpi_PoolSubmit(FetchAsyncJob, fa) != TCL_OK) {
+        fa->workerDone = 1;
+        FetchAsyncDetach(fa);
+        FetchAsyncRelease(fa); /* the job's reference */
+        return Oradpi_SetError(ip, (OradpiBase *)st, -1, "failed to create async thread pool (Tcl_CreateThread failed; check system thread limits)");
+    }
+
+    Tcl_SetObjResult(ip, Tcl_NewIntObj(0));
+    return TCL_OK;
+}
+
+/* ==========================================================================
+ * oraparallelscan
+ *
+ * Splits a query into chunks and drains each chunk on its own session
+ * acquired from the logon handle's session pool.  Every chunk is one pool
+ * job; batches are read with dpiStmt_fetchRows, snapshotted with LOBs
+ * read inline (the session goes back to the pool when the chunk ends, so
+ * LOB locators cannot outlive it) and delivered through the same event
+ * path as orafetchasync.  The throttle is shared: at most
+ * ORADPI_FETCHASYNC_MAX_INFLIGHT batches per chunk are queued at once.
+ *
+ * Sessions are taken without blocking on a full pool: the logon itself
+ * may hold the last one, and a job stuck in the acquire could not be
+ * stopped.  A job polls until a session is idle or the pool may grow,
+ * for at most ORADPI_PARALLELSCAN_ACQUIRE_MS.
+ *
+ * Chunking by hash needs no planning, each chunk filters on
+ * ORA_HASH(expr, N-1).  Chunking by ROWID is planned by one more pool
+ * job on a pooled session: DBMS_PARALLEL_EXECUTE cuts the table behind
+ * the query into ROWID ranges from its extent map, which reads no rows,
+ * and the plan job groups them into N chunks of about equal size before
+ * submitting the chunk jobs.
+ * ========================================================================== */
+
+#define ORADPI_PARALLELSCAN_DEFAULT_CHUNKS 4
+#define ORADPI_PARALLELSCAN_ACQUIRE_MS     30000
+#define ORADPI_PARALLELSCAN_POLL_MS        20
+/* errChunk of a failed ROWID plan. */
+#define ORADPI_SCANCHUNK_PLAN              UINT32_MAX
+
+struct OradpiParallelScan;
+
+typedef struct OradpiScanChunk {
+    struct OradpiParallelScan *ps;
+    uint32_t                   index;
+    char                      *sql;
+    /* Set by the worker before its first batch is posted. */
+    uint32_t                   numCols;
+    int                       *isChar;  /* [numCols] */
+    unsigned char             *dateFmt; /* [numCols] */
+    /* Under ps->lock: the session while the worker is inside ODPI. */
+    dpiConn                   *conn;
+} OradpiScanChunk;
+
+typedef struct OradpiParallelScan {
+    Tcl_Mutex                  lock;
+    Tcl_Condition              cond;
+    int                        refCount; /* connection + jobs + queued events */
+    int                        stop;     /* chunks must wind down */
+    int                        canceled; /* stopped by the owner: no final event */
+    uint32_t                   jobsLeft;
+    uint32_t                   inFlight;
+    uint64_t                   total;
+    uint32_t                   errChunk; /* or ORADPI_SCANCHUNK_PLAN */
+    int                        errCode;
+    char                      *errMsg; /* first chunk failure */
+
+    dpiPool                   *pool;    /* addRef'd */
+    uint32_t                   poolMax; /* the pool's maximum session count */
+    Tcl_ThreadId               ownerTid;
+    uint32_t                   batchRows;
+    int                        dateFormat;
+    uint32_t                   wantChunks;
+    char                      *planSql;  /* -by rowid: the query to split */
+    dpiConn                   *planConn; /* under lock, like chunk->conn */
+    /* Under lock; published once, by the submitting thread. */
+    uint32_t                   nChunks;
+    OradpiScanChunk           *chunks; /* [nChunks] */
+
+    /* Owning thread only; cleared by ParallelScanDetach. */
+    int                        detached;
+    OradpiConn                *co;
+    struct OradpiParallelScan *next; /* co->scans */
+    Tcl_Interp                *ip;
+    Tcl_Obj                   *cmd;
+} OradpiParallelScan;
+
+typedef struct OradpiParallelScanEvent {
+    Tcl_Event           header;
+    OradpiParallelScan *ps;
+    OradpiScanChunk    *chunk; /* NULL for the final event */
+    OradpiFetchCell    *cells; /* [rows * chunk->numCols] */
+    uint32_t            rows;
+} OradpiParallelScanEvent;
+
+/* One DBMS_PARALLEL_EXECUTE chunk of the table behind a -by rowid scan. */
+typedef struct OradpiScanRange {
+    char     lo[32];
+    char     hi[32];
+    uint64_t blocks;
+} OradpiScanRange;
+
+static void ParallelScanFreeChunks(OradpiScanChunk *chunks, uint32_t n) {
+    for (uint32_t i = 0; i < n; i++) {
+        OradpiScanChunk *ch = &chunks[i];
+        if (ch->sql)
+            Tcl_Free(ch->sql);
+        if (ch->isChar)
+            Tcl_Free((char *)ch->isChar);
+        if (ch->dateFmt)
+            Tcl_Free((char *)ch->dateFmt);
+    }
+    if (chunks)
+        Tcl_Free((char *)chunks);
+}
+
+static void ParallelScanRelease(OradpiParallelScan *ps) {
+    Tcl_MutexLock(&ps->lock);
+    int doFree = (--ps->refCount == 0);
+    Tcl_MutexUnlock(&ps->lock);
+    if (!doFree)
+        return;
+    ParallelScanFreeChunks(ps->chunks, ps->nChunks);
+    if (ps->planSql)
+        Tcl_Free(ps->planSql);
+    if (ps->errMsg)
+        Tcl_Free(ps->errMsg);
+    if (ps->pool)
+        dpiPool_release(ps->pool);
+    Tcl_ConditionFinalize(&ps->cond);
+    Tcl_MutexFinalize(&ps->lock);
+    Tcl_Free((char *)ps);
+}
+
+/* Owning thread: unhook ps from its connection and drop the Tcl_Obj
+ * state.  Events still queued see detached and only free their payload. */
+static void ParallelScanDetach(OradpiParallelScan *ps) {
+    if (ps->detached)
+        return;
+    ps->detached = 1;
+    if (ps->co) {
+        for (OradpiParallelScan **pp = &ps->co->scans; *pp; pp = &(*pp)->next) {
+            if (*pp == ps) {
+                *pp = ps->next;
                 break;
+            }
+        }
+    }
+    ps->co   = NULL;
+    ps->next = NULL;
+    ps->ip   = NULL;
+    if (ps->cmd) {
+        Tcl_DecrRefCount(ps->cmd);
+        ps->cmd = NULL;
+    }
+    ParallelScanRelease(ps);
+}
+
+/* Caller holds ps->lock.  Breaks the calls of every running job and
+ * wakes the ones waiting for a session or for the throttle. */
+static void ParallelScanStopLocked(OradpiParallelScan *ps) {
+    ps->stop = 1;
+    if (ps->planConn)
+        (void)dpiConn_breakExecution(ps->planConn);
+    for (uint32_t i = 0; i < ps->nChunks; i++) {
+        if (ps->chunks[i].conn)
+            (void)dpiConn_breakExecution(ps->chunks[i].conn);
+    }
+    Tcl_ConditionNotify(&ps->cond);
+}
+
+/* Stop every chunk and wait for the jobs; queued batches are dropped. */
+static void ParallelScanCancel(OradpiParallelScan *ps) {
+    Tcl_MutexLock(&ps->lock);
+    ps->canceled = 1;
+    ParallelScanStopLocked(ps);
+    while (ps->jobsLeft > 0)
+        Tcl_ConditionWait(&ps->cond, &ps->lock, NULL);
+    Tcl_MutexUnlock(&ps->lock);
+    ParallelScanDetach(ps);
+}
+
+void Oradpi_ParallelScanConnClosed(OradpiConn *co) {
+    while (co && co->scans)
+        ParallelScanCancel(co->scans);
+}
+
+static int ParallelScanEventProc(Tcl_Event *evPtr, int flags);
+
+/* Either side: queue a batch (chunk != NULL) or the final event. */
+static void ParallelScanPost(OradpiParallelScan *ps, OradpiScanChunk *chunk, OradpiFetchCell *cells, uint32_t rows) {
+    OradpiParallelScanEvent *ev = (OradpiParallelScanEvent *)Tcl_Alloc(sizeof(*ev));
+    memset(ev, 0, sizeof(*ev));
+    ev->header.proc = ParallelScanEventProc;
+    ev->ps          = ps;
+    ev->chunk       = chunk;
+    ev->cells       = cells;
+    ev->rows        = rows;
+    Tcl_MutexLock(&ps->lock);
+    ps->refCount++;
+    if (chunk)
+        ps->inFlight++;
+    Tcl_MutexUnlock(&ps->lock);
+    Tcl_ThreadQueueEvent(ps->ownerTid, &ev->header, TCL_QUEUE_TAIL);
+    Tcl_ThreadAlert(ps->ownerTid);
+}
+
+/* Take a session from the scan's pool, publishing it in *slot.  The
+ * acquire is only attempted while a session is idle or the pool may
+ * grow, so it does not block on a full pool whatever its get mode;
+ * otherwise the job waits on ps->cond, which the stop flag signals.
+ * Returns 1 with *connOut set, 0 when stopped (*connOut may still need
+ * releasing), -1 on failure with *msg set on a timeout. */
+static int ParallelScanAcquire(OradpiParallelScan *ps, dpiConn **slot, dpiConn **connOut, const char **msg) {
+    Tcl_Time deadline;
+    Tcl_GetTime(&deadline);
+    deadline.sec += ORADPI_PARALLELSCAN_ACQUIRE_MS / 1000;
+    *connOut = NULL;
+    for (;;) {
+        uint32_t open = 0, busy = 0;
+        if (dpiPool_getOpenCount(ps->pool, &open) != DPI_SUCCESS || dpiPool_getBusyCount(ps->pool, &busy) != DPI_SUCCESS)
+            return -1;
+        if (busy < open || open < ps->poolMax) {
+            dpiConn *conn = NULL;
+            if (dpiPool_acquireConnection(ps->pool, NULL, 0, NULL, 0, NULL, &conn) == DPI_SUCCESS) {
+                Tcl_MutexLock(&ps->lock);
+                *slot    = conn;
+                int stop = ps->stop;
+                Tcl_MutexUnlock(&ps->lock);
+                *connOut = conn;
+                return stop ? 0 : 1;
+            }
+            /* Another thread took the session first under a nowait or
+             * timedwait pool (ORA-24418, ORA-24457): poll again. */
+            dpiErrorInfo ei;
+            memset(&ei, 0, sizeof(ei));
+            (void)Oradpi_CaptureODPIError(&ei);
+            if (ei.code != 24418 && ei.code != 24457)
+                return -1;
+        }
+        Tcl_Time now;
+        Tcl_GetTime(&now);
+        if (now.sec > deadline.sec || (now.sec == deadline.sec && now.usec >= deadline.usec)) {
+            *msg = "oraparallelscan: no pooled session became available";
+            return -1;
+        }
+        Tcl_Time wait = {0, ORADPI_PARALLELSCAN_POLL_MS * 1000};
+        Tcl_MutexLock(&ps->lock);
+        if (!ps->stop)
+            Tcl_ConditionWait(&ps->cond, &ps->lock, &wait);
+        int stop = ps->stop;
+        Tcl_MutexUnlock(&ps->lock);
+        if (stop)
+            return 0;
+    }
+}
+
+/* Unpublish and return a job's session. */
+static void ParallelScanPutConn(OradpiParallelScan *ps, dpiConn **slot, dpiStmt *stmt, dpiConn *conn) {
+    Tcl_MutexLock(&ps->lock);
+    *slot = NULL;
+    Tcl_MutexUnlock(&ps->lock);
+    if (stmt)
+        dpiStmt_release(stmt);
+    if (conn)
+        dpiConn_release(conn);
+}
+
+/* A failed job's message: msg when set, else the thread's ODPI error.
+ * Must run before the job makes any other ODPI call. */
+static char *ParallelScanFailure(const char *msg, int *errCode) {
+    if (msg)
+        return FetchAsyncCopyMessage(msg, strlen(msg));
+    dpiErrorInfo ei;
+    memset(&ei, 0, sizeof(ei));
+    (void)Oradpi_CaptureODPIError(&ei);
+    *errCode = (int)ei.code;
+    if (ei.message && ei.messageLength > 0)
+        return FetchAsyncCopyMessage(ei.message, ei.messageLength);
+    return FetchAsyncCopyMessage("oraparallelscan: fetch failed", strlen("oraparallelscan: fetch failed"));
+}
+
+/* Common tail of the plan and chunk jobs: record the first failure
+ * (errMsg is taken over), post the final event after the last job and
+ * drop the job's reference. */
+static void ParallelScanJobEnd(OradpiParallelScan *ps, uint32_t index, uint64_t total, char *errMsg, int errCode) {
+    Tcl_MutexLock(&ps->lock);
+    ps->total += total;
+    /* The first failure is the one reported; the breaks it causes in the
+     * other chunks are not. */
+    if (errMsg && !ps->stop) {
+        ps->errChunk = index;
+        ps->errCode  = errCode ? errCode : -1;
+        ps->errMsg   = errMsg;
+        errMsg       = NULL;
+        ParallelScanStopLocked(ps);
+    }
+    int last    = (--ps->jobsLeft == 0);
+    int postEnd = last && !ps->canceled;
+    Tcl_MutexUnlock(&ps->lock);
+    if (errMsg)
+        Tcl_Free(errMsg);
+    if (postEnd)
+        ParallelScanPost(ps, NULL, NULL, 0);
+    if (last) {
+        Tcl_MutexLock(&ps->lock);
+        Tcl_ConditionNotify(&ps->cond);
+        Tcl_MutexUnlock(&ps->lock);
+    }
+    ParallelScanRelease(ps);
+}
+
+/* Column types and output date formats for one chunk's result, and one
+ * define variable per column so batches come from dpiStmt_fetchRows.
+ * Object and LONG columns leave *varData NULL; the chunk then reads
+ * row by row. */
+static int ParallelScanDescribe(OradpiScanChunk *ch, dpiConn *conn, dpiStmt *stmt, dpiVar ***vars, dpiData ***varData, dpiNativeTypeNum **nativeTypes) {
+    if (dpiStmt_getNumQueryColumns(stmt, &ch->numCols) != DPI_SUCCESS)
+        return TCL_ERROR;
+    size_t isCharBytes = 0, varBytes = 0;
+    if (Oradpi_CheckedAllocBytes(NULL, (Tcl_Size)ch->numCols, sizeof(int), &isCharBytes, NULL) != TCL_OK ||
+        Oradpi_CheckedAllocBytes(NULL, (Tcl_Size)ch->numCols, sizeof(dpiQueryInfo), &varBytes, NULL) != TCL_OK)
+        return TCL_ERROR;
+    ch->isChar        = (int *)Tcl_Alloc(isCharBytes ? isCharBytes : 1);
+    ch->dateFmt       = (unsigned char *)Tcl_Alloc(ch->numCols ? ch->numCols : 1);
+    dpiQueryInfo *qis = (dpiQueryInfo *)Tcl_Alloc(varBytes ? varBytes : 1);
+    int           ok  = 1;
+    int           def = 1;
+    for (uint32_t c = 0; c < ch->numCols && ok; c++) {
+        if (dpiStmt_getQueryInfo(stmt, c + 1, &qis[c]) != DPI_SUCCESS) {
+            ok = 0;
+            break;
         }
-    } else {
-        /* ------------------------------------------------------------------
-         * FALLBACK PATH: dpiStmt_fetch + dpiStmt_getQueryValue per row
-         * ------------------------------------------------------------------ */
-        for (;;) {
-            int         hasRow         = 0;
-            uint32_t    bufferRowIndex = 0;
-            const char *snapshotWhere  = NULL;
-            const char *snapshotMsg    = NULL;
+        dpiOracleTypeNum otn = qis[c].typeInfo.oracleTypeNum;
+        ch->isChar[c]        = is_char_type(otn);
+        int f                = ch->ps->dateFormat;
+        if (f == ORADPI_DATEFMT_CLOCK && IsZonedTimestampType(otn))
+            f = ORADPI_DATEFMT_EPOCH;
+        ch->dateFmt[c] = (unsigned char)f;
+        if (otn == DPI_ORACLE_TYPE_OBJECT || otn == DPI_ORACLE_TYPE_LONG_VARCHAR || otn == DPI_ORACLE_TYPE_LONG_NVARCHAR || otn == DPI_ORACLE_TYPE_LONG_RAW)
+            def = 0;
+    }
+    if (ok && def && ch->numCols > 0) {
+        *vars        = (dpiVar **)Tcl_Alloc(ch->numCols * sizeof(dpiVar *));
+        *varData     = (dpiData **)Tcl_Alloc(ch->numCols * sizeof(dpiData *));
+        *nativeTypes = (dpiNativeTypeNum *)Tcl_Alloc(ch->numCols * sizeof(dpiNativeTypeNum));
+        memset(*vars, 0, ch->numCols * sizeof(dpiVar *));
+        for (uint32_t c = 0; c < ch->numCols && ok; c++) {
+            uint32_t size = qis[c].typeInfo.clientSizeInBytes;
+            if (dpiConn_newVar(conn, qis[c].typeInfo.oracleTypeNum, qis[c].typeInfo.defaultNativeTypeNum, ch->ps->batchRows, size, size > 0, 0, NULL, &(*vars)[c], &(*varData)[c]) !=
+                    DPI_SUCCESS ||
+                dpiStmt_define(stmt, c + 1, (*vars)[c]) != DPI_SUCCESS)
+                ok = 0;
+            (*nativeTypes)[c] = qis[c].typeInfo.defaultNativeTypeNum;
+        }
+    }
+    Tcl_Free((char *)qis);
+    return ok ? TCL_OK : TCL_ERROR;
+}
 
-            if (fetchDead) {
-                Tcl_SetObjResult(ip, Tcl_NewStringObj("orafetch: statement closed during callback", -1));
-                code = TCL_ERROR;
-                goto cleanup;
-            }
+/* Worker body for one chunk.  Follows the worker contract in cmd_int.h. */
+static void ParallelScanJob(void *clientData, int canceled) {
+    OradpiScanChunk    *ch          = (OradpiScanChunk *)clientData;
+    OradpiParallelScan *ps          = ch->ps;
+    dpiConn            *conn        = NULL;
+    dpiStmt            *stmt        = NULL;
+    dpiVar            **vars        = NULL;
+    dpiData           **varData     = NULL;
+    dpiNativeTypeNum   *nativeTypes = NULL;
+    uint64_t            total       = 0;
+    const char         *msg         = NULL;
 
-            memset(colVals, 0, colValBytes);
-            FreeFetchCells(cells, numColsSize, fetchShared);
-            memset(cells, 0, cellBytes);
+    int got    = canceled ? 0 : ParallelScanAcquire(ps, &ch->conn, &conn, &msg);
+    int failed = got < 0;
+    if (got > 0) {
+        if (dpiConn_prepareStmt(conn, 0, ch->sql, (uint32_t)strlen(ch->sql), NULL, 0, &stmt) != DPI_SUCCESS || dpiStmt_setFetchArraySize(stmt, ps->batchRows) != DPI_SUCCESS ||
+            dpiStmt_execute(stmt, DPI_MODE_EXEC_DEFAULT, NULL) != DPI_SUCCESS || ParallelScanDescribe(ch, conn, stmt, &vars, &varData, &nativeTypes) != TCL_OK)
+            failed = 1;
+    }
 
-            Oradpi_SharedConnGateEnter(fetchShared);
-            if (dpiStmt_fetch(fetchStmt, &hasRow, &bufferRowIndex) != DPI_SUCCESS) {
-                Oradpi_SharedConnGateLeave(fetchShared);
-                code = Oradpi_SetErrorFromODPI(ip, (OradpiBase *)st, "dpiStmt_fetch");
-                goto cleanup;
+    int more = got > 0 && !failed;
+    while (more) {
+        Tcl_MutexLock(&ps->lock);
+        while (!ps->stop && ps->inFlight >= ORADPI_FETCHASYNC_MAX_INFLIGHT * ps->nChunks)
+            Tcl_ConditionWait(&ps->cond, &ps->lock, NULL);
+        int stop = ps->stop;
+        Tcl_MutexUnlock(&ps->lock);
+        if (stop)
+            break;
+
+        size_t cellBytes = 0;
+        if (Oradpi_CheckedAllocBytes(NULL, (Tcl_Size)ps->batchRows * ch->numCols, sizeof(OradpiFetchCell), &cellBytes, NULL) != TCL_OK) {
+            failed = 1;
+            msg    = "oraparallelscan: batch is too large";
+            break;
+        }
+        OradpiFetchCell *cells = (OradpiFetchCell *)Tcl_Alloc(cellBytes ? cellBytes : 1);
+        memset(cells, 0, cellBytes);
+        uint32_t rows = 0;
+        while (varData && more && rows < ps->batchRows && !failed) {
+            uint32_t start = 0, n = 0;
+            int      moreRows = 0;
+            if (dpiStmt_fetchRows(stmt, ps->batchRows - rows, &start, &n, &moreRows) != DPI_SUCCESS) {
+                failed = 1;
+                break;
+            }
+            for (uint32_t r = 0; r < n && !failed; r++) {
+                for (uint32_t c = 0; c < ch->numCols; c++) {
+                    const char *where = NULL;
+                    if (SnapshotCellLocked(1, nativeTypes[c], &varData[c][start + r], ch->isChar[c], &cells[(size_t)rows * ch->numCols + c], &where, &msg) != TCL_OK) {
+                        failed = 1;
+                        break;
+                    }
+                }
+                if (!failed)
+                    rows++;
+            }
+            if (!moreRows)
+                more = 0;
+        }
+        while (!varData && rows < ps->batchRows && !failed) {
+            int      hasRow         = 0;
+            uint32_t bufferRowIndex = 0;
+            if (dpiStmt_fetch(stmt, &hasRow, &bufferRowIndex) != DPI_SUCCESS) {
+                failed = 1;
+                break;
             }
-            (void)bufferRowIndex;
             if (!hasRow) {
-                Oradpi_SharedConnGateLeave(fetchShared);
+                more = 0;
                 break;
             }
-
-            for (uint32_t c = 1; c <= numCols; c++) {
+            for (uint32_t c = 0; c < ch->numCols; c++) {
                 dpiNativeTypeNum nt;
-                dpiData         *d = NULL;
-                if (dpiStmt_getQueryValue(fetchStmt, c, &nt, &d) != DPI_SUCCESS) {
-                    Oradpi_SharedConnGateLeave(fetchShared);
-                    code = Oradpi_SetErrorFromODPI(ip, (OradpiBase *)st, "dpiStmt_getQueryValue");
-                    goto cleanup;
-                }
-                if (SnapshotCellLocked(fetchInlineLobs, nt, d, st->fetchIsChar[c - 1], &cells[c - 1], &snapshotWhere, &snapshotMsg) != TCL_OK) {
-                    Oradpi_SharedConnGateLeave(fetchShared);
-                    if (snapshotWhere)
-                        code = Oradpi_SetErrorFromODPI(ip, (OradpiBase *)st, snapshotWhere);
-                    else {
-                        Tcl_SetObjResult(ip, Tcl_NewStringObj(snapshotMsg ? snapshotMsg : "failed to snapshot fetched value", -1));
-                        code = TCL_ERROR;
-                    }
-                    goto cleanup;
+                dpiData         *d     = NULL;
+                const char      *where = NULL;
+                if (dpiStmt_getQueryValue(stmt, c + 1, &nt, &d) != DPI_SUCCESS ||
+                    SnapshotCellLocked(1, nt, d, ch->isChar[c], &cells[(size_t)rows * ch->numCols + c], &where, &msg) != TCL_OK) {
+                    failed = 1;
+                    break;
                 }
             }
-            Oradpi_SharedConnGateLeave(fetchShared);
+            if (!failed)
+                rows++;
+        }
+        Tcl_MutexLock(&ps->lock);
+        stop = ps->stop;
+        Tcl_MutexUnlock(&ps->lock);
+        if (failed || stop || rows == 0) {
+            /* A partially snapshotted row is discarded with the batch. */
+            FreeFetchCells(cells, (Tcl_Size)(rows + (failed ? 1 : 0)) * ch->numCols, NULL);
+            Tcl_Free((char *)cells);
+            if (failed || stop)
+                break;
+            continue;
+        }
+        total += rows;
+        ParallelScanPost(ps, ch, cells, rows);
+    }
 
-            /* --- Reentrancy zone --- */
-            for (uint32_t c = 0; c < numCols; c++) {
-                colVals[c] = SnapshotCellToObj(ip, fetchShared, &cells[c]);
-                if (!colVals[c]) {
-                    code = TCL_ERROR;
-                    goto cleanup;
-                }
-            }
+    int   errCode = 0;
+    char *errMsg  = failed ? ParallelScanFailure(msg, &errCode) : NULL;
+    if (vars) {
+        for (uint32_t c = 0; c < ch->numCols; c++)
+            if (vars[c])
+                dpiVar_release(vars[c]);
+        Tcl_Free((char *)vars);
+        Tcl_Free((char *)varData);
+        Tcl_Free((char *)nativeTypes);
+    }
+    ParallelScanPutConn(ps, &ch->conn, stmt, conn);
+    ParallelScanJobEnd(ps, ch->index, total, errMsg, errCode);
+}
 
-            if (dataVar || rowsList) {
-                rowObj = Tcl_NewListObj(0, NULL);
-                Tcl_IncrRefCount(rowObj);
-                for (uint32_t c = 0; c < numCols; c++) {
-                    if (asDict) {
-                        LAPPEND_GOTO(ip, rowObj, colNames[c], code, cleanup);
-                        LAPPEND_GOTO(ip, rowObj, colVals[c], code, cleanup);
-                    } else {
-                        LAPPEND_GOTO(ip, rowObj, colVals[c], code, cleanup);
-                    }
-                }
-            }
+/* Publish chunks (taken over) and queue one job per chunk.  Nothing is
+ * published once the scan is stopped.  On a submit failure the jobs
+ * never queued are written off and TCL_ERROR is returned; the caller
+ * stops the ones already running. */
+static int ParallelScanSubmitChunks(OradpiParallelScan *ps, OradpiScanChunk *chunks, uint32_t n) {
+    Tcl_MutexLock(&ps->lock);
+    if (ps->stop) {
+        Tcl_MutexUnlock(&ps->lock);
+        ParallelScanFreeChunks(chunks, n);
+        return TCL_OK;
+    }
+    ps->chunks  = chunks;
+    ps->nChunks = n;
+    ps->jobsLeft += n;
+    ps->refCount += (int)n;
+    Tcl_MutexUnlock(&ps->lock);
 
-            if (dataArray) {
-                if (indexByNumber) {
-                    for (uint32_t c = 0; c < numCols; c++) {
-                        if (!Tcl_ObjSetVar2(ip, dataArray, numberKeys[c], colVals[c], TCL_LEAVE_ERR_MSG)) {
-                            code = TCL_ERROR;
-                            goto cleanup;
-                        }
-                    }
-                    if (!Oradpi_LookupStmt(ip, stmtNameSnap))
-                        fetchDead = 1;
-                } else if (indexByName) {
-                    for (uint32_t c = 0; c < numCols; c++) {
-                        if (!Tcl_ObjSetVar2(ip, dataArray, colNames[c], colVals[c], TCL_LEAVE_ERR_MSG)) {
-                            code = TCL_ERROR;
-                            goto cleanup;
-                        }
-                    }
-                    if (!Oradpi_LookupStmt(ip, stmtNameSnap))
-                        fetchDead = 1;
-                }
-            }
+    uint32_t submitted = 0;
+    for (; submitted < n; submitted++) {
+        if (Oradpi_PoolSubmit(ParallelScanJob, &chunks[submitted]) != TCL_OK)
+            break;
+    }
+    if (submitted == n)
+        return TCL_OK;
+    /* Neither count reaches zero here: the caller still holds a job or
+     * the connection reference. */
+    uint32_t missing = n - submitted;
+    Tcl_MutexLock(&ps->lock);
+    ps->jobsLeft -= missing;
+    ps->refCount -= (int)missing;
+    Tcl_MutexUnlock(&ps->lock);
+    return TCL_ERROR;
+}
 
-            if (!fetchDead && dataVar && !Tcl_ObjSetVar2(ip, dataVar, NULL, rowObj, TCL_LEAVE_ERR_MSG)) {
-                code = TCL_ERROR;
-                goto cleanup;
-            }
-            if (!fetchDead && dataVar && !Oradpi_LookupStmt(ip, stmtNameSnap))
-                fetchDead = 1;
+static OradpiScanChunk *ParallelScanNewChunks(OradpiParallelScan *ps, uint32_t n) {
+    OradpiScanChunk *chunks = (OradpiScanChunk *)Tcl_Alloc(sizeof(OradpiScanChunk) * (n ? (size_t)n : 1));
+    memset(chunks, 0, sizeof(OradpiScanChunk) * (n ? (size_t)n : 1));
+    for (uint32_t i = 0; i < n; i++) {
+        chunks[i].ps    = ps;
+        chunks[i].index = i;
+    }
+    return chunks;
+}
 
-            if (!fetchDead && cmd) {
-                int evalCode = Tcl_EvalObjEx(ip, cmd, TCL_EVAL_GLOBAL);
-                if (!Oradpi_LookupStmt(ip, stmtNameSnap))
-                    fetchDead = 1;
-                if (evalCode == TCL_BREAK) {
-                    if (rowObj) {
-                        Tcl_DecrRefCount(rowObj);
-                        rowObj = NULL;
-                    }
-                    memset(colVals, 0, colValBytes);
-                    fetched++;
-                    break;
-                }
-                if (evalCode == TCL_CONTINUE) {
-                    if (rowObj) {
-                        Tcl_DecrRefCount(rowObj);
-                        rowObj = NULL;
-                    }
-                    memset(colVals, 0, colValBytes);
-                    fetched++;
-                    if (maxRows > 0 && (Tcl_WideInt)fetched >= maxRows)
-                        break;
-                    continue;
-                }
-                if (evalCode != TCL_OK) {
-                    code = evalCode;
-                    goto cleanup;
-                }
-            }
+/* ROWID plan, run on a pooled session.  The first row of the query names
+ * the table (a view over one table resolves to its base table);
+ * DBMS_PARALLEL_EXECUTE then chunks that table by its extents, about
+ * eight pieces per requested chunk, and the cursor returns the pieces in
+ * ROWID order with their block counts.  An empty query opens an empty
+ * cursor.  The task commits on the pooled session only. */
+static const char parallelScanPlanSql[] =
+    "DECLARE\n"
+    "  rid  ROWID;\n"
+    "  own  VARCHAR2(128);\n"
+    "  tab  VARCHAR2(128);\n"
+    "  blk  NUMBER;\n"
+    "  task VARCHAR2(128);\n"
+    "BEGIN\n"
+    "  BEGIN\n"
+    "    EXECUTE IMMEDIATE 'SELECT ROWID FROM (' || :q || ') WHERE ROWNUM = 1' INTO rid;\n"
+    "  EXCEPTION WHEN NO_DATA_FOUND THEN\n"
+    "    OPEN :rc FOR SELECT CAST(NULL AS VARCHAR2(18)), CAST(NULL AS VARCHAR2(18)), CAST(0 AS NUMBER(10)) FROM dual WHERE 1 = 0;\n"
+    "    RETURN;\n"
+    "  END;\n"
+    "  SELECT owner, object_name INTO own, tab FROM all_objects\n"
+    "   WHERE data_object_id = DBMS_ROWID.ROWID_OBJECT(rid)\n"
+    "     AND object_type IN ('TABLE', 'TABLE PARTITION', 'TABLE SUBPARTITION') AND ROWNUM = 1;\n"
+    "  SELECT NVL(MAX(blocks), 0) INTO blk FROM all_tables WHERE owner = own AND table_name = tab;\n"
+    "  task := DBMS_PARALLEL_EXECUTE.GENERATE_TASK_NAME('ORATCL$');\n"
+    "  DBMS_PARALLEL_EXECUTE.CREATE_TASK(task);\n"
+    "  BEGIN\n"
+    "    DBMS_PARALLEL_EXECUTE.CREATE_CHUNKS_BY_ROWID(task, own, tab, FALSE, GREATEST(64, CEIL(blk / (:n * 8))));\n"
+    "    OPEN :rc FOR SELECT ROWIDTOCHAR(start_rowid), ROWIDTOCHAR(end_rowid),\n"
+    "      CAST(DBMS_ROWID.ROWID_BLOCK_NUMBER(end_rowid) - DBMS_ROWID.ROWID_BLOCK_NUMBER(start_rowid) + 1 AS NUMBER(10))\n"
+    "      FROM user_parallel_execute_chunks WHERE task_name = task ORDER BY start_rowid;\n"
+    "  EXCEPTION WHEN OTHERS THEN\n"
+    "    DBMS_PARALLEL_EXECUTE.DROP_TASK(task);\n"
+    "    RAISE;\n"
+    "  END;\n"
+    "  DBMS_PARALLEL_EXECUTE.DROP_TASK(task);\n"
+    "END;";
 
-            if (rowsList) {
-                LAPPEND_GOTO(ip, rowsList, rowObj, code, cleanup);
-            }
-            if (rowObj) {
-                Tcl_DecrRefCount(rowObj);
-                rowObj = NULL;
+/* Read the plan cursor into *ranges (Tcl_Alloc'd, *n entries). */
+static int ParallelScanReadRanges(dpiStmt *cursor, OradpiScanRange **ranges, uint32_t *n, const char **msg) {
+    uint32_t cap = 0;
+    for (;;) {
+        int              hasRow = 0;
+        uint32_t         bufferRowIndex;
+        dpiNativeTypeNum nt;
+        dpiData         *lo = NULL, *hi = NULL, *blocks = NULL;
+        if (dpiStmt_fetch(cursor, &hasRow, &bufferRowIndex) != DPI_SUCCESS)
+            return TCL_ERROR;
+        if (!hasRow)
+            return TCL_OK;
+        if (dpiStmt_getQueryValue(cursor, 1, &nt, &lo) != DPI_SUCCESS || dpiStmt_getQueryValue(cursor, 2, &nt, &hi) != DPI_SUCCESS ||
+            dpiStmt_getQueryValue(cursor, 3, &nt, &blocks) != DPI_SUCCESS)
+            return TCL_ERROR;
+        if (lo->isNull || hi->isNull)
+            continue;
+        if (lo->value.asBytes.length >= sizeof((*ranges)->lo) || hi->value.asBytes.length >= sizeof((*ranges)->hi)) {
+            *msg = "oraparallelscan: unexpected ROWID in the rowid plan";
+            return TCL_ERROR;
+        }
+        if (*n == cap) {
+            size_t bytes = 0;
+            cap          = cap ? cap * 2 : 64;
+            if (Oradpi_CheckedAllocBytes(NULL, (Tcl_Size)cap, sizeof(OradpiScanRange), &bytes, NULL) != TCL_OK) {
+                *msg = "oraparallelscan: rowid plan is too large";
+                return TCL_ERROR;
             }
-            /* rowObj may have owned colVals[] elements; zero before next row. */
-            memset(colVals, 0, colValBytes);
-            fetched++;
-            if (maxRows > 0 && (Tcl_WideInt)fetched >= maxRows)
-                break;
+            *ranges = (OradpiScanRange *)Tcl_Realloc((char *)*ranges, bytes);
         }
+        OradpiScanRange *r = &(*ranges)[(*n)++];
+        memcpy(r->lo, lo->value.asBytes.ptr, lo->value.asBytes.length);
+        r->lo[lo->value.asBytes.length] = '\0';
+        memcpy(r->hi, hi->value.asBytes.ptr, hi->value.asBytes.length);
+        r->hi[hi->value.asBytes.length] = '\0';
+        int64_t b                       = blocks->isNull ? 1 : (nt == DPI_NATIVE_TYPE_DOUBLE ? (int64_t)blocks->value.asDouble : blocks->value.asInt64);
+        r->blocks                       = b > 0 ? (uint64_t)b : 1;
     }
+}
 
-    if (resultVar) {
-        Tcl_Obj *resultObj = rowsList ? rowsList : Tcl_NewListObj(0, NULL);
-        if (!Tcl_ObjSetVar2(ip, resultVar, NULL, resultObj, TCL_LEAVE_ERR_MSG)) {
-            code = TCL_ERROR;
-            goto cleanup;
-        }
+/* Group the ROWID-ordered pieces into at most want chunks of about equal
+ * block counts.  The pieces cover the table, so [first lo, last hi] of a
+ * run of them covers exactly its rows. */
+static OradpiScanChunk *ParallelScanGroupRanges(OradpiParallelScan *ps, const OradpiScanRange *ranges, uint32_t n, uint32_t want, uint32_t *nOut) {
+    uint64_t sum = 0;
+    for (uint32_t i = 0; i < n; i++)
+        sum += ranges[i].blocks;
+    OradpiScanChunk *chunks = ParallelScanNewChunks(ps, n < want ? n : want);
+    static const char fmt[] = "SELECT * FROM (%s) WHERE ROWID BETWEEN CHARTOROWID('%s') AND CHARTOROWID('%s')";
+    size_t            len   = strlen(ps->planSql) + sizeof(fmt) + 2 * sizeof(ranges->lo);
+    uint32_t          g     = 0;
+    uint64_t          acc   = 0;
+    uint32_t          first = 0;
+    for (uint32_t i = 0; i < n; i++) {
+        acc += ranges[i].blocks;
+        if (i + 1 < n && acc * want < sum * (g + 1))
+            continue;
+        /* Rowid text is base-64 digits only, safe to quote as a literal. */
+        chunks[g].sql = (char *)Tcl_Alloc(len);
+        snprintf(chunks[g].sql, len, fmt, ps->planSql, ranges[first].lo, ranges[i].hi);
+        g++;
+        first = i + 1;
     }
+    *nOut = g;
+    return chunks;
+}
 
-    if (returnRows) {
-        Tcl_SetObjResult(ip, rowsList ? rowsList : Tcl_NewListObj(0, NULL));
-        code = TCL_OK;
-        goto cleanup;
+/* Worker body for the ROWID plan of a -by rowid scan: plans on a pooled
+ * session, returns it, then submits the chunk jobs.  Counts as one job
+ * so the final event waits for the chunks it submits. */
+static void ParallelScanPlanJob(void *clientData, int canceled) {
+    OradpiParallelScan *ps      = (OradpiParallelScan *)clientData;
+    dpiConn            *conn    = NULL;
+    dpiStmt            *stmt    = NULL;
+    dpiVar             *rcVar   = NULL;
+    dpiData            *rcData  = NULL;
+    OradpiScanRange    *ranges  = NULL;
+    uint32_t            nRanges = 0;
+    const char         *msg     = NULL;
+
+    int got    = canceled ? 0 : ParallelScanAcquire(ps, &ps->planConn, &conn, &msg);
+    int failed = got < 0;
+    if (got > 0) {
+        dpiData q, n;
+        memset(&q, 0, sizeof(q));
+        memset(&n, 0, sizeof(n));
+        q.value.asBytes.ptr    = ps->planSql;
+        q.value.asBytes.length = (uint32_t)strlen(ps->planSql);
+        n.value.asInt64        = (int64_t)ps->wantChunks;
+        if (dpiConn_prepareStmt(conn, 0, parallelScanPlanSql, (uint32_t)(sizeof(parallelScanPlanSql) - 1), NULL, 0, &stmt) != DPI_SUCCESS ||
+            dpiConn_newVar(conn, DPI_ORACLE_TYPE_STMT, DPI_NATIVE_TYPE_STMT, 1, 0, 0, 0, NULL, &rcVar, &rcData) != DPI_SUCCESS ||
+            dpiStmt_bindByName(stmt, "rc", 2, rcVar) != DPI_SUCCESS || dpiStmt_bindValueByName(stmt, "q", 1, DPI_NATIVE_TYPE_BYTES, &q) != DPI_SUCCESS ||
+            dpiStmt_bindValueByName(stmt, "n", 1, DPI_NATIVE_TYPE_INT64, &n) != DPI_SUCCESS || dpiStmt_execute(stmt, DPI_MODE_EXEC_DEFAULT, NULL) != DPI_SUCCESS ||
+            ParallelScanReadRanges(rcData->value.asStmt, &ranges, &nRanges, &msg) != TCL_OK)
+            failed = 1;
     }
 
-    Tcl_SetObjResult(ip, Tcl_NewIntObj(fetched > 0 ? 0 : 1403));
-    code = TCL_OK;
+    int   errCode = 0;
+    char *errMsg  = failed ? ParallelScanFailure(msg, &errCode) : NULL;
+    if (rcVar)
+        dpiVar_release(rcVar);
+    ParallelScanPutConn(ps, &ps->planConn, stmt, conn);
 
-cleanup:
-    /* Release the addRef'd snapshot handles if they were acquired.
-     * Pre-loop gotos reach here with fetchStmt == NULL (never addRef'd). */
-    if (cells) {
-        FreeFetchCells(cells, numColsSize, fetchShared);
-        Tcl_Free((char *)cells);
+    if (got > 0 && !failed && nRanges > 0) {
+        uint32_t         nChunks = 0;
+        OradpiScanChunk *chunks  = ParallelScanGroupRanges(ps, ranges, nRanges, ps->wantChunks, &nChunks);
+        if (ParallelScanSubmitChunks(ps, chunks, nChunks) != TCL_OK)
+            errMsg = ParallelScanFailure("failed to create async thread pool (Tcl_CreateThread failed; check system thread limits)", &errCode);
     }
-    if (fetchStmt)
-        dpiStmt_release(fetchStmt);
-    if (fetchShared)
-        Oradpi_SharedConnRelease(fetchShared);
-    if (stmtNameSnap)
-        Tcl_DecrRefCount(stmtNameSnap);
-    if (rowObj)
-        Tcl_DecrRefCount(rowObj);
-    if (rowsList)
-        Tcl_DecrRefCount(rowsList);
-    if (numberKeys) {
-        for (uint32_t c = 0; c < numCols; c++) {
-            if (numberKeys[c])
-                Tcl_DecrRefCount(numberKeys[c]);
+    if (ranges)
+        Tcl_Free((char *)ranges);
+    ParallelScanJobEnd(ps, ORADPI_SCANCHUNK_PLAN, 0, errMsg, errCode);
+}
+
+static int ParallelScanEventProc(Tcl_Event *evPtr, int flags) {
+    (void)flags;
+    OradpiParallelScanEvent *ev = (OradpiParallelScanEvent *)evPtr;
+    OradpiParallelScan      *ps = ev->ps;
+    OradpiScanChunk         *ch = ev->chunk;
+
+    if (!ps->detached && ps->ip && !Tcl_InterpDeleted(ps->ip)) {
+        Tcl_Interp *ip     = ps->ip;
+        OradpiConn *co     = ps->co;
+        Tcl_Obj    *status = NULL;
+        Tcl_Obj    *chunk  = NULL;
+        Tcl_Obj    *data   = NULL;
+        int         stop   = !ch;
+
+        if (ch) {
+            ClockZoneBegin();
+            chunk = Tcl_NewWideIntObj((Tcl_WideInt)ch->index);
+            data  = Tcl_NewListObj(0, NULL);
+            for (uint32_t r = 0; r < ev->rows; r++) {
+                Tcl_Obj *row = Tcl_NewListObj(0, NULL);
+                for (uint32_t c = 0; c < ch->numCols; c++)
+                    (void)Tcl_ListObjAppendElement(NULL, row, SnapshotCellToObj(ip, NULL, &ev->cells[(size_t)r * ch->numCols + c], ch->dateFmt[c]));
+                (void)Tcl_ListObjAppendElement(NULL, data, row);
+            }
+            if (ClockZoneCheck(ip) == TCL_OK)
+                status = Tcl_NewStringObj("rows", -1);
+            else {
+                /* As for orafetchasync: the batch becomes the error
+                 * callback for its chunk and the scan stops. */
+                Tcl_IncrRefCount(data);
+                Tcl_DecrRefCount(data);
+                data = Tcl_GetObjResult(ip);
+                (void)Oradpi_SetError(NULL, (OradpiBase *)co, -1, Tcl_GetString(data));
+                status = Tcl_NewStringObj("error", -1);
+                stop   = 1;
+            }
+        } else if (ps->errMsg) {
+            (void)Oradpi_SetError(NULL, (OradpiBase *)co, ps->errCode, ps->errMsg);
+            status = Tcl_NewStringObj("error", -1);
+            chunk  = ps->errChunk == ORADPI_SCANCHUNK_PLAN ? Tcl_NewObj() : Tcl_NewWideIntObj((Tcl_WideInt)ps->errChunk);
+            data   = Tcl_NewStringObj(ps->errMsg, -1);
+        } else {
+            Oradpi_RecordRows((OradpiBase *)co, ps->total);
+            status = Tcl_NewStringObj("done", -1);
+            chunk  = Tcl_NewObj();
+            data   = Tcl_NewWideIntObj((Tcl_WideInt)ps->total);
         }
-        Tcl_Free((char *)numberKeys);
+
+        Tcl_Obj *cmd = Tcl_DuplicateObj(ps->cmd);
+        Tcl_IncrRefCount(cmd);
+        (void)Tcl_ListObjAppendElement(NULL, cmd, co->base.name);
+        (void)Tcl_ListObjAppendElement(NULL, cmd, status);
+        (void)Tcl_ListObjAppendElement(NULL, cmd, chunk);
+        (void)Tcl_ListObjAppendElement(NULL, cmd, data);
+
+        if (ch && stop)
+            ParallelScanCancel(ps);
+        else if (!ch)
+            ParallelScanDetach(ps);
+
+        Tcl_Preserve(ip);
+        int rc = Tcl_EvalObjEx(ip, cmd, TCL_EVAL_GLOBAL);
+        if (rc == TCL_ERROR)
+            Tcl_BackgroundException(ip, rc);
+        /* An error or break from a batch callback stops the scan; the
+         * callback may also have logged off. */
+        if ((rc == TCL_ERROR || rc == TCL_BREAK) && !ps->detached)
+            ParallelScanCancel(ps);
+        Tcl_Release(ip);
+        Tcl_DecrRefCount(cmd);
     }
-    if (colVals) {
-        /* colVals[] entries are owned by rowObj or rowsList — they are
-         * released when those containers are freed above.  Any surviving
-         * non-NULL entry here still has a live owner; we must not touch
-         * its refcount.  Just free the pointer array itself. */
-        Tcl_Free((char *)colVals);
+
+    if (ev->cells) {
+        FreeFetchCells(ev->cells, (Tcl_Size)ev->rows * ch->numCols, NULL);
+        Tcl_Free((char *)ev->cells);
     }
-    if (colNames) {
-        for (uint32_t c = 0; c < numCols; c++) {
-            if (colNames[c])
-                Tcl_DecrRefCount(colNames[c]);
+    if (ch) {
+        Tcl_MutexLock(&ps->lock);
+        ps->inFlight--;
+        Tcl_ConditionNotify(&ps->cond);
+        Tcl_MutexUnlock(&ps->lock);
+    }
+    ParallelScanRelease(ps);
+    return 1;
+}
+
+/* Parse "-by rowid" or "-by hash(expr)".  hashExpr and hashLen point into
+ * the option's string rep. */
+static int ParallelScanParseBy(Tcl_Interp *ip, OradpiConn *co, Tcl_Obj *obj, const char **hashExpr, Tcl_Size *hashLen) {
+    Tcl_Size    len = 0;
+    const char *s   = Tcl_GetStringFromObj(obj, &len);
+    *hashExpr       = NULL;
+    *hashLen        = 0;
+    if (len == 5 && strncasecmp(s, "rowid", 5) == 0)
+        return TCL_OK;
+    if (len > 6 && strncasecmp(s, "hash(", 5) == 0 && s[len - 1] == ')') {
+        *hashExpr = s + 5;
+        *hashLen  = len - 6;
+        return TCL_OK;
+    }
+    return Oradpi_SetError(ip, (OradpiBase *)co, -1, "oraparallelscan: -by must be rowid or hash(column)");
+}
+
+/*
+ * oraparallelscan logon-handle sql ?-chunks N? ?-by rowid|hash(expr)?
+ *                 ?-batch rows? ?-dateformat fmt? -command script
+ *
+ *   Runs sql as N chunks, each on its own session from the handle's
+ *   session pool (oralogon -pool), fetched on the worker pool.  -by rowid
+ *   (default) splits the table behind the query into at most N ROWID
+ *   ranges from its extents, which needs a query over a single table;
+ *   -by hash(expr) gives chunk i the rows with ORA_HASH(expr, N-1) = i.
+ *   script is called from the event loop as
+ *       script logon-handle rows chunk rowList   (once per batch)
+ *       script logon-handle done {} rowCount     (after the last chunk)
+ *       script logon-handle error chunk message  (first failure, chunk
+ *                                                 {} for the ROWID plan;
+ *                                                 the others are stopped)
+ *   Batches of different chunks interleave in no particular order.
+ *   Returns: N.
+ */
+int Oradpi_Cmd_ParallelScan(void *cd, Tcl_Interp *ip, Tcl_Size objc, Tcl_Obj *const objv[]) {
+    (void)cd;
+    if (objc < 5 || (objc % 2) != 1) {
+        Tcl_WrongNumArgs(ip, 1, objv, "logon-handle sql ?-chunks N? ?-by rowid|hash(expr)? ?-batch rows? ?-dateformat fmt? -command script");
+        return TCL_ERROR;
+    }
+    OradpiConn *co = Oradpi_LookupConn(ip, objv[1]);
+    if (!co)
+        return Oradpi_SetError(ip, NULL, -1, "invalid logon handle");
+    if (!co->conn)
+        return Oradpi_SetError(ip, (OradpiBase *)co, -1, "connection is closed");
+    if (!co->pool)
+        return Oradpi_SetError(ip, (OradpiBase *)co, -1, "oraparallelscan: logon handle has no session pool; use oralogon -pool");
+
+    static const char *const scanOpts[] = {"-batch", "-by", "-chunks", "-command", "-dateformat", NULL};
+    enum ScanOptIdx { PSOPT_BATCH, PSOPT_BY, PSOPT_CHUNKS, PSOPT_COMMAND, PSOPT_DATEFORMAT };
+    uint32_t    batchRows  = co->fetchArraySize ? co->fetchArraySize : 100;
+    uint32_t    nChunks    = ORADPI_PARALLELSCAN_DEFAULT_CHUNKS;
+    int         dateFormat = ORADPI_DATEFMT_ISO;
+    const char *hashExpr   = NULL;
+    Tcl_Size    hashLen    = 0;
+    Tcl_Obj    *cmd        = NULL;
+    for (Tcl_Size i = 3; i < objc; i += 2) {
+        int optIdx;
+        if (Tcl_GetIndexFromObj(ip, objv[i], scanOpts, "option", 0, &optIdx) != TCL_OK)
+            return TCL_ERROR;
+        switch ((enum ScanOptIdx)optIdx) {
+        case PSOPT_BATCH:
+            if (Oradpi_GetUInt32FromObj(ip, objv[i + 1], &batchRows, "-batch") != TCL_OK)
+                return TCL_ERROR;
+            if (batchRows == 0)
+                return Oradpi_SetError(ip, (OradpiBase *)co, -1, "oraparallelscan: -batch must be > 0");
+            break;
+        case PSOPT_BY:
+            if (ParallelScanParseBy(ip, co, objv[i + 1], &hashExpr, &hashLen) != TCL_OK)
+                return TCL_ERROR;
+            break;
+        case PSOPT_CHUNKS:
+            if (Oradpi_GetUInt32FromObj(ip, objv[i + 1], &nChunks, "-chunks") != TCL_OK)
+                return TCL_ERROR;
+            if (nChunks == 0 || nChunks > 1024)
+                return Oradpi_SetError(ip, (OradpiBase *)co, -1, "oraparallelscan: -chunks must be between 1 and 1024");
+            break;
+        case PSOPT_COMMAND:
+            cmd = objv[i + 1];
+            break;
+        case PSOPT_DATEFORMAT:
+            if (Tcl_GetIndexFromObj(ip, objv[i + 1], Oradpi_DateFormatNames, "date format", 0, &dateFormat) != TCL_OK)
+                return TCL_ERROR;
+            break;
         }
-        Tcl_Free((char *)colNames);
     }
-    if (meta)
-        FreeFetchMeta(meta, numColsSize);
-    return code;
+    if (!cmd)
+        return Oradpi_SetError(ip, (OradpiBase *)co, -1, "oraparallelscan: -command is required");
+
+    if (dpiPool_addRef(co->pool) != DPI_SUCCESS)
+        return Oradpi_SetErrorFromODPI(ip, (OradpiBase *)co, "dpiPool_addRef");
+    Tcl_Size            sqlLen = 0;
+    const char         *sql    = Tcl_GetStringFromObj(objv[2], &sqlLen);
+    OradpiParallelScan *ps     = (OradpiParallelScan *)Tcl_Alloc(sizeof(*ps));
+    memset(ps, 0, sizeof(*ps));
+    ps->refCount   = 1; /* connection */
+    ps->pool       = co->pool;
+    ps->poolMax    = co->poolMaxSessions;
+    ps->ownerTid   = Tcl_GetCurrentThread();
+    ps->batchRows  = batchRows;
+    ps->dateFormat = dateFormat;
+    ps->wantChunks = nChunks;
+    ps->co         = co;
+    ps->ip         = ip;
+    ps->cmd        = cmd;
+    Tcl_IncrRefCount(cmd);
+    ps->next  = co->scans;
+    co->scans = ps;
+
+    int rc = TCL_OK;
+    if (hashExpr) {
+        OradpiScanChunk *chunks = ParallelScanNewChunks(ps, nChunks);
+        for (uint32_t i = 0; i < nChunks; i++) {
+            Tcl_Obj *o = Tcl_ObjPrintf("SELECT * FROM (%s) WHERE ORA_HASH(%.*s, %u) = %u", sql, (int)hashLen, hashExpr, nChunks - 1, i);
+            Tcl_Size len;
+            Tcl_IncrRefCount(o);
+            const char *s = Tcl_GetStringFromObj(o, &len);
+            chunks[i].sql = FetchAsyncCopyMessage(s, (size_t)len);
+            Tcl_DecrRefCount(o);
+        }
+        rc = ParallelScanSubmitChunks(ps, chunks, nChunks);
+    } else {
+        ps->planSql = FetchAsyncCopyMessage(sql, (size_t)sqlLen);
+        Tcl_MutexLock(&ps->lock);
+        ps->jobsLeft = 1;
+        ps->refCount++;
+        Tcl_MutexUnlock(&ps->lock);
+        if (Oradpi_PoolSubmit(ParallelScanPlanJob, ps) != TCL_OK) {
+            Tcl_MutexLock(&ps->lock);
+            ps->jobsLeft = 0;
+            ps->refCount--;
+            Tcl_MutexUnlock(&ps->lock);
+            rc = TCL_ERROR;
+        }
+    }
+    if (rc != TCL_OK) {
+        /* The jobs already running wind down on the stop flag. */
+        ParallelScanCancel(ps);
+        return Oradpi_SetError(ip, (OradpiBase *)co, -1, "failed to create async thread pool (Tcl_CreateThread failed; check system thread limits)");
+    }
+
+    Tcl_SetObjResult(ip, Tcl_NewIntObj((int)nChunks));
+    return TCL_OK;
 }
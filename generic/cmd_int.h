@@ -48,8 +48,11 @@
  *                        and async workers for the same dpiConn*.
  *                        Leaf lock; never hold while acquiring gAsyncMutex
  *                        or gConnMapMutex.
+ *  10. ra->lock, fa->lock (cmd_fetch.c) — per-statement readahead and
+ *                        orafetchasync state.
+ *                        Leaf locks; never held across a gate acquire.
  *
- * Leaf locks (4-9) are independent and may be acquired in any order
+ * Leaf locks (4-10) are independent and may be acquired in any order
  * relative to each other, but never while holding a non-leaf lock (1-3)
  * if the non-leaf lock's critical section could call into those modules.
  *
@@ -84,6 +87,7 @@ int                Oradpi_Cmd_Desc(void *cd, Tcl_Interp *ip, Tcl_Size objc, Tcl_
 int                Oradpi_Cmd_Exec(void *cd, Tcl_Interp *ip, Tcl_Size objc, Tcl_Obj *const objv[]);
 int                Oradpi_Cmd_ExecAsync(void *cd, Tcl_Interp *ip, Tcl_Size objc, Tcl_Obj *const objv[]);
 int                Oradpi_Cmd_Fetch(void *cd, Tcl_Interp *ip, Tcl_Size objc, Tcl_Obj *const objv[]);
+int                Oradpi_Cmd_FetchAsync(void *cd, Tcl_Interp *ip, Tcl_Size objc, Tcl_Obj *const objv[]);
 int                Oradpi_Cmd_Info(void *cd, Tcl_Interp *ip, Tcl_Size objc, Tcl_Obj *const objv[]);
 int                Oradpi_Cmd_Lob(void *cd, Tcl_Interp *ip, Tcl_Size objc, Tcl_Obj *const objv[]);
 int                Oradpi_Cmd_Logoff(void *cd, Tcl_Interp *ip, Tcl_Size objc, Tcl_Obj *const objv[]);
@@ -92,9 +96,12 @@ int                Oradpi_Cmd_Msg(void *cd, Tcl_Interp *ip, Tcl_Size objc, Tcl_O
 int                Oradpi_Cmd_Open(void *cd, Tcl_Interp *ip, Tcl_Size objc, Tcl_Obj *const objv[]);
 int                Oradpi_Cmd_Orabind(void *cd, Tcl_Interp *ip, Tcl_Size objc, Tcl_Obj *const objv[]);
 int                Oradpi_Cmd_Orabindexec(void *cd, Tcl_Interp *ip, Tcl_Size objc, Tcl_Obj *const objv[]);
+int                Oradpi_Cmd_ParallelScan(void *cd, Tcl_Interp *ip, Tcl_Size objc, Tcl_Obj *const objv[]);
 int                Oradpi_Cmd_Parse(void *cd, Tcl_Interp *ip, Tcl_Size objc, Tcl_Obj *const objv[]);
 int                Oradpi_Cmd_Plexec(void *cd, Tcl_Interp *ip, Tcl_Size objc, Tcl_Obj *const objv[]);
+int                Oradpi_Cmd_Result(void *cd, Tcl_Interp *ip, Tcl_Size objc, Tcl_Obj *const objv[]);
 int                Oradpi_Cmd_Rollback(void *cd, Tcl_Interp *ip, Tcl_Size objc, Tcl_Obj *const objv[]);
+int                Oradpi_Cmd_Snapshot(void *cd, Tcl_Interp *ip, Tcl_Size objc, Tcl_Obj *const objv[]);
 int                Oradpi_Cmd_Stmt(void *cd, Tcl_Interp *ip, Tcl_Size objc, Tcl_Obj *const objv[]);
 int                Oradpi_Cmd_StmtSql(void *cd, Tcl_Interp *ip, Tcl_Size objc, Tcl_Obj *const objv[]);
 int                Oradpi_Cmd_WaitAsync(void *cd, Tcl_Interp *ip, Tcl_Size objc, Tcl_Obj *const objv[]);
@@ -201,6 +208,33 @@ static inline int Oradpi_CheckedAllocBytes(Tcl_Interp *ip, Tcl_Size count, size_
 #define ORADPI_TEARDOWN_TIMEOUT_MS 30000
 #endif
 
+/* Adaptive fetch sizing ("oraconfig $L fetcharraysize auto").  Define
+ * buffers are sized from the connection's fetchbudget; the rows requested
+ * per round trip then double while a full batch returns in under
+ * ORADPI_FETCHAUTO_TARGET_US and halve when one takes four times that. */
+#ifndef ORADPI_FETCHAUTO_BUDGET
+#define ORADPI_FETCHAUTO_BUDGET (1024u * 1024u)
+#endif
+#define ORADPI_FETCHAUTO_MAX_ROWS 4096u
+#define ORADPI_FETCHAUTO_MIN_ROWS 16u
+#define ORADPI_FETCHAUTO_TARGET_US 10000
+#define ORADPI_FETCHAUTO_PREFETCH 2u
+
+/* Rows of converted results kept per scrollable statement for paging. */
+#define ORADPI_SCROLL_WINDOW_ROWS 2048
+
+/* Result cache limits: larger results are not kept, and the oldest-expiring
+ * entries make room once the process-wide table is full or holds more
+ * than ORADPI_RESULTCACHE_BYTES of rows. */
+#define ORADPI_RESULTCACHE_ROWS 10000u
+#define ORADPI_RESULTCACHE_ENTRIES 256
+#define ORADPI_RESULTCACHE_BYTES ((size_t)64 << 20)
+
+/* Output forms for date/timestamp values ("-dateformat", "oraconfig $S
+ * dateformat"); names in Oradpi_DateFormatNames, same order. */
+enum { ORADPI_DATEFMT_ISO = 0, ORADPI_DATEFMT_EPOCH, ORADPI_DATEFMT_EPOCHMICROS, ORADPI_DATEFMT_CLOCK };
+extern const char *const Oradpi_DateFormatNames[];
+
 #define CONN_GATE_ENTER(co) Oradpi_ConnGateEnter((co))
 #define CONN_GATE_ENTER_TIMED(co, timeoutMs) Oradpi_ConnGateEnterTimed((co), (timeoutMs))
 #define CONN_GATE_LEAVE(co) Oradpi_ConnGateLeave((co))
@@ -236,6 +270,8 @@ OradpiLob         *Oradpi_NewLob(Tcl_Interp *ip, dpiLob *lob, GlobalConnRec *sha
 void               Oradpi_FreeConn(OradpiConn *co);
 void               Oradpi_FreeStmt(Tcl_Interp *ip, OradpiStmt *s);
 void               Oradpi_FreeFetchCache(OradpiStmt *s);
+int                Oradpi_BuildFetchCache(Tcl_Interp *ip, OradpiStmt *s);
+int                Oradpi_CheckColTypes(Tcl_Interp *ip, Tcl_Obj *spec);
 void               Oradpi_FreeLob(OradpiLob *l);
 void               Oradpi_DeleteInterpData(void *clientData, Tcl_Interp *ip);
 void               Oradpi_RemoveStmt(Tcl_Interp *ip, OradpiStmt *s);
@@ -252,6 +288,46 @@ int                Oradpi_StmtWaitForAsync(OradpiStmt *s, int doCancel, int time
 int                Oradpi_StmtIsAsyncBusy(OradpiStmt *s);
 void               Oradpi_CancelAndJoinAllForConn(Tcl_Interp *ip, OradpiConn *co);
 
+/* Generic pool jobs (async.c).  canceled is nonzero when the job is being
+ * discarded at process exit without having run. */
+typedef void       Oradpi_PoolJobProc(void *clientData, int canceled);
+int                Oradpi_PoolSubmit(Oradpi_PoolJobProc *proc, void *clientData);
+
+/* Fetch readahead (cmd_fetch.c).  Waits for any in-flight worker fetch and
+ * drops prefetched rows; must be called without the connection gate held. */
+void               Oradpi_ReadaheadDiscard(OradpiStmt *s);
+/* Stop an orafetchasync in progress and wait for its worker; queued
+ * batches are dropped.  Same gate rule as Oradpi_ReadaheadDiscard. */
+void               Oradpi_FetchAsyncCancel(OradpiStmt *s);
+/* Result cache (cmd_fetch.c).  Lookup runs before an execute: *hit means
+ * the rows are already cached and the execute must be skipped.  On a miss
+ * Subscribe (before the binds) and Executed (after a successful execute)
+ * register the query for change notification; neither reports errors.
+ * StmtDone runs after every successful execute. */
+int                Oradpi_ResultCacheLookup(Tcl_Interp *ip, OradpiStmt *s, const char *stmtKey, int *hit);
+void               Oradpi_ResultCacheSubscribe(OradpiStmt *s);
+void               Oradpi_ResultCacheExecuted(OradpiStmt *s);
+void               Oradpi_ResultCacheStmtDone(OradpiStmt *s);
+void               Oradpi_ResultCacheConnClosed(OradpiConn *co);
+/* Fetch cache reuse (cmd_fetch.c).  Reparse replaces Oradpi_FreeFetchCache
+ * when a statement is prepared again with new SQL text sql. */
+void               Oradpi_FetchCacheReparse(OradpiStmt *s, const char *sql, Tcl_Size sqlLen);
+void               Oradpi_FreeFetchNames(OradpiInterpState *is);
+/* Columnar result sets (cmd_result.c), filled by Oradpi_FetchToResult
+ * (cmd_fetch.c) one row at a time: a Put per column, then EndRow. */
+typedef struct OradpiResult OradpiResult;
+OradpiResult      *Oradpi_ResultNew(uint32_t numCols, Tcl_Obj *const *colNames);
+void               Oradpi_ResultPutNull(OradpiResult *r, uint32_t c);
+void               Oradpi_ResultPutInt(OradpiResult *r, uint32_t c, int64_t v);
+void               Oradpi_ResultPutDouble(OradpiResult *r, uint32_t c, double v);
+void               Oradpi_ResultPutText(OradpiResult *r, uint32_t c, const char *p, size_t len, int isChar);
+void               Oradpi_ResultEndRow(OradpiResult *r);
+void               Oradpi_ResultFree(OradpiResult *r);
+void               Oradpi_FreeResults(OradpiInterpState *is);
+int                Oradpi_FetchToResult(Tcl_Interp *ip, OradpiStmt *st, Tcl_WideInt maxRows, int dateFormat, OradpiResult **resultOut);
+/* Stop the connection's oraparallelscan runs and wait for their chunks. */
+void               Oradpi_ParallelScanConnClosed(OradpiConn *co);
+
 /* Shared bind infrastructure (cmd_bind.c) */
 typedef struct OradpiPendingRefs {
     Tcl_Size n, cap;
@@ -272,6 +348,9 @@ void        Oradpi_PendingsForget(Tcl_Interp *ip, const char *stmtKey);
 void        Oradpi_ClearBindStoreForStmt(Tcl_Interp *ip, const char *stmtKey);
 int         Oradpi_BindOneByValue(Tcl_Interp *ip, OradpiStmt *s, OradpiPendingRefs *pr, const char *nameNoColon, Tcl_Obj *valueObj);
 int         Oradpi_RebindAllStored(Tcl_Interp *ip, OradpiStmt *s, OradpiPendingRefs *pr, const char *stmtKey);
+void        Oradpi_CursorBindsFree(OradpiStmt *s);
+int         Oradpi_RegisterCursorBinds(Tcl_Interp *ip, OradpiStmt *s);
+int         Oradpi_BindStoreAppendKey(Tcl_Interp *ip, const char *stmtKey, Tcl_DString *ds);
 uint32_t    Oradpi_WithColon(const char *nameNoColon, char *dst, uint32_t cap);
 const char *Oradpi_StripColon(const char *raw);
 
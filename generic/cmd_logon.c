@@ -206,16 +206,16 @@ static void PoolRegistry_Release(const char *key, dpiPool *pool) {
  * not pool-identity parameters, and different callers sharing a pool may
  * use different authentication wrappers. */
 static void PoolRegistry_BuildKey(Tcl_DString *ds, const char *user, uint32_t ulen, const char *db, uint32_t dblen, Tcl_WideInt minS, Tcl_WideInt maxS, Tcl_WideInt incS, int homogeneous, int ext,
-                                  Tcl_WideInt waitTimeout, Tcl_WideInt timeout, Tcl_WideInt maxLifetime, Tcl_WideInt pingInterval, Tcl_WideInt pingTimeout, Tcl_WideInt stmtCacheSize) {
+                                  int events, Tcl_WideInt waitTimeout, Tcl_WideInt timeout, Tcl_WideInt maxLifetime, Tcl_WideInt pingInterval, Tcl_WideInt pingTimeout, Tcl_WideInt stmtCacheSize) {
     Tcl_DStringInit(ds);
     Tcl_DStringAppend(ds, user ? user : "", (Tcl_Size)ulen);
     Tcl_DStringAppend(ds, "@", 1);
     Tcl_DStringAppend(ds, db ? db : "", (Tcl_Size)dblen);
     char buf[128];
     snprintf(buf, sizeof(buf),
-             "|%" TCL_LL_MODIFIER "d:%" TCL_LL_MODIFIER "d:%" TCL_LL_MODIFIER "d:%d:%d"
+             "|%" TCL_LL_MODIFIER "d:%" TCL_LL_MODIFIER "d:%" TCL_LL_MODIFIER "d:%d:%d:%d"
              "|%" TCL_LL_MODIFIER "d:%" TCL_LL_MODIFIER "d:%" TCL_LL_MODIFIER "d:%" TCL_LL_MODIFIER "d:%" TCL_LL_MODIFIER "d:%" TCL_LL_MODIFIER "d",
-             minS, maxS, incS, homogeneous, ext, waitTimeout, timeout, maxLifetime, pingInterval, pingTimeout, stmtCacheSize);
+             minS, maxS, incS, homogeneous, ext, events, waitTimeout, timeout, maxLifetime, pingInterval, pingTimeout, stmtCacheSize);
     Tcl_DStringAppend(ds, buf, -1);
 }
 
@@ -413,11 +413,11 @@ int Oradpi_Cmd_Logon(void *cd, Tcl_Interp *ip, Tcl_Size objc, Tcl_Obj *const obj
         Tcl_WrongNumArgs(ip, 1, objv,
                          "connect-str ?-pool min max incr? ?-homogeneous bool? "
                          "?-getmode wait|nowait|forceget|timedwait? "
-                         "?-failovercallback proc?");
+                         "?-failovercallback proc? ?-events bool?");
         return TCL_ERROR;
     }
     const char              *connstr = Tcl_GetString(objv[1]);
-    int                      usePool = 0, homogeneous = 1;
+    int                      usePool = 0, homogeneous = 1, events = 0;
     Tcl_WideInt              minS = 1, maxS = 4, incS = 1;
     int                      getmode           = DPI_MODE_POOL_GET_WAIT;
     Tcl_Obj                 *failoverCb        = NULL;
@@ -430,8 +430,8 @@ int Oradpi_Cmd_Logon(void *cd, Tcl_Interp *ip, Tcl_Size objc, Tcl_Obj *const obj
     Tcl_WideInt              poolStmtCacheSize = -1; /* per-session statement cache size */
 
     static const char *const logonOpts[]       = {"-pool",        "-homogeneous",   "-getmode", "-failovercallback", "-waittimeout", "-timeout", "-maxlifetime", "-pinginterval",
-                                                  "-pingtimeout", "-stmtcachesize", NULL};
-    enum LogonOptIdx { LOPT_POOL, LOPT_HOMOGENEOUS, LOPT_GETMODE, LOPT_FAILOVERCB, LOPT_WAITTIMEOUT, LOPT_TIMEOUT, LOPT_MAXLIFETIME, LOPT_PINGINTERVAL, LOPT_PINGTIMEOUT, LOPT_STMTCACHESIZE };
+                                                  "-pingtimeout", "-stmtcachesize", "-events", NULL};
+    enum LogonOptIdx { LOPT_POOL, LOPT_HOMOGENEOUS, LOPT_GETMODE, LOPT_FAILOVERCB, LOPT_WAITTIMEOUT, LOPT_TIMEOUT, LOPT_MAXLIFETIME, LOPT_PINGINTERVAL, LOPT_PINGTIMEOUT, LOPT_STMTCACHESIZE, LOPT_EVENTS };
 
     static const char *const getmodeNames[]  = {"wait", "nowait", "forceget", "timedwait", NULL};
     static const int         getmodeValues[] = {DPI_MODE_POOL_GET_WAIT, DPI_MODE_POOL_GET_NOWAIT, DPI_MODE_POOL_GET_FORCEGET, DPI_MODE_POOL_GET_TIMEDWAIT};
@@ -524,6 +524,12 @@ int Oradpi_Cmd_Logon(void *cd, Tcl_Interp *ip, Tcl_Size objc, Tcl_Obj *const obj
             if (Tcl_GetWideIntFromObj(ip, objv[++i], &poolStmtCacheSize) != TCL_OK)
                 return TCL_ERROR;
             break;
+        case LOPT_EVENTS:
+            if (i + 1 >= objc)
+                return Oradpi_SetError(ip, NULL, -1, "-events requires a boolean");
+            if (Tcl_GetBooleanFromObj(ip, objv[++i], &events) != TCL_OK)
+                return TCL_ERROR;
+            break;
         }
     }
 
@@ -555,6 +561,9 @@ int Oradpi_Cmd_Logon(void *cd, Tcl_Interp *ip, Tcl_Size objc, Tcl_Obj *const obj
     /* Always enable threaded mode so OCI protects internal structures when
      * async worker threads operate on connections from this context. */
     cparams.createMode |= DPI_MODE_CREATE_THREADED;
+    /* Change notification for the result cache needs events mode. */
+    if (events)
+        cparams.createMode |= DPI_MODE_CREATE_EVENTS;
 
     dpiConn *conn = NULL;
     dpiPool *pool = NULL;
@@ -589,7 +598,7 @@ int Oradpi_Cmd_Logon(void *cd, Tcl_Interp *ip, Tcl_Size objc, Tcl_Obj *const obj
         /* Look up or create a shared pool for this parameter combination.
          * Multiple oralogon -pool calls with the same parameters share one dpiPool*. */
         Tcl_DString poolKey;
-        PoolRegistry_BuildKey(&poolKey, user, ulen, db, dblen, minS, maxS, incS, homogeneous, ext, poolWaitTimeout, poolTimeout, poolMaxLifetime, poolPingInterval, poolPingTimeout, poolStmtCacheSize);
+        PoolRegistry_BuildKey(&poolKey, user, ulen, db, dblen, minS, maxS, incS, homogeneous, ext, events, poolWaitTimeout, poolTimeout, poolMaxLifetime, poolPingInterval, poolPingTimeout, poolStmtCacheSize);
 
         pool = PoolRegistry_Acquire(ctx, Tcl_DStringValue(&poolKey), user, ulen, pw, plen, db, dblen, &cparams, &pp, getmode);
         Tcl_DStringFree(&poolKey);
@@ -602,7 +611,7 @@ int Oradpi_Cmd_Logon(void *cd, Tcl_Interp *ip, Tcl_Size objc, Tcl_Obj *const obj
         if (dpiPool_acquireConnection(pool, NULL, 0, NULL, 0, &ccp, &conn) != DPI_SUCCESS) {
             /* Release our registry ref; pool stays alive if other handles share it */
             Tcl_DString releaseKey;
-            PoolRegistry_BuildKey(&releaseKey, user, ulen, db, dblen, minS, maxS, incS, homogeneous, ext, poolWaitTimeout, poolTimeout, poolMaxLifetime, poolPingInterval, poolPingTimeout,
+            PoolRegistry_BuildKey(&releaseKey, user, ulen, db, dblen, minS, maxS, incS, homogeneous, ext, events, poolWaitTimeout, poolTimeout, poolMaxLifetime, poolPingInterval, poolPingTimeout,
                                   poolStmtCacheSize);
             PoolRegistry_Release(Tcl_DStringValue(&releaseKey), pool);
             Tcl_DStringFree(&releaseKey);
@@ -630,6 +639,9 @@ int Oradpi_Cmd_Logon(void *cd, Tcl_Interp *ip, Tcl_Size objc, Tcl_Obj *const obj
     co->foTimer          = NULL;
     co->foTimerScheduled = 0;
     co->foPendingMsg     = NULL;
+    co->events           = events;
+    co->poolMaxSessions  = pool ? (uint32_t)maxS : 0;
+    Oradpi_SharedConnSyncBehavior(co);
     if (failoverCb) {
         co->failoverCallback = failoverCb;
         Tcl_IncrRefCount(co->failoverCallback);
@@ -0,0 +1,1335 @@
+/*
+ *  cmd_result.c --
+ *
+ *    Columnar result sets (oraresult) and their snapshot files (orasnapshot).
+ *
+ *        - Rows of a query are stored column by column in typed vectors
+ *          (64-bit integers, doubles, or a text arena) with a null bitmap.
+ *        - Aggregates, filters and sorts run in C over those vectors; Tcl
+ *          objects are only built for the values a script asks for.
+ *        - A result can be saved to a snapshot file and mapped back read-only;
+ *          the mapped columns are used in place.
+ *
+ *  Copyright (c) 2025 Miguel Bañón.
+ *
+ *  See the file "license.terms" for information on usage and redistribution,
+ *  and for a DISCLAIMER OF ALL WARRANTIES.
+ *
+ */
+
+#include <errno.h>
+#include <inttypes.h>
+#include <limits.h>
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#include "cmd_int.h"
+#include "dpi.h"
+
+/* ==========================================================================
+ * Forward Declarations
+ * ========================================================================== */
+
+int         Oradpi_Cmd_Result(void *cd, Tcl_Interp *ip, Tcl_Size objc, Tcl_Obj *const objv[]);
+int         Oradpi_Cmd_Snapshot(void *cd, Tcl_Interp *ip, Tcl_Size objc, Tcl_Obj *const objv[]);
+static void SnapshotUnmap(void *map, size_t len);
+
+/* ------------------------------------------------------------------------- *
+ * Column storage
+ * ------------------------------------------------------------------------- */
+
+/* A column takes the kind of its first non-NULL value; an integer column
+ * becomes a double column on the first fractional value, and a numeric
+ * column becomes text on the first text value.  NULL slots hold 0 (or an
+ * empty string), so sums need no null test. */
+enum { RESCOL_NONE = 0, RESCOL_INT, RESCOL_DOUBLE, RESCOL_TEXT };
+
+typedef struct OradpiResultCol {
+    Tcl_Obj       *name;
+    int            kind;
+    int            isChar;    /* text column: string (1) or binary (0) data */
+    int64_t       *i64;       /* RESCOL_INT */
+    double        *f64;       /* RESCOL_DOUBLE */
+    uint64_t      *off;       /* RESCOL_TEXT: cell i is text[off[i], off[i+1]) */
+    char          *text;
+    size_t         textLen;
+    size_t         textCap;
+    unsigned char *nulls;     /* bit set = NULL */
+    Tcl_Size       nullCount;
+} OradpiResultCol;
+
+struct OradpiResult {
+    OradpiBase       base;
+    uint32_t         numCols;
+    Tcl_Size         numRows;
+    Tcl_Size         cap;
+    Tcl_Size         cursor; /* next row of "oraresult fetch" */
+    OradpiResultCol *cols;
+    void            *map;    /* orasnapshot open: the columns point into this mapping */
+    size_t           mapLen;
+};
+
+#define RES_ISNULL(col, i) (((col)->nulls[(size_t)(i) >> 3] >> ((size_t)(i) & 7)) & 1)
+
+static void ResultColAllocValues(OradpiResultCol *col, Tcl_Size cap) {
+    switch (col->kind) {
+    case RESCOL_INT:
+        col->i64 = (int64_t *)Tcl_Alloc((size_t)cap * sizeof(int64_t));
+        memset(col->i64, 0, (size_t)cap * sizeof(int64_t));
+        break;
+    case RESCOL_DOUBLE:
+        col->f64 = (double *)Tcl_Alloc((size_t)cap * sizeof(double));
+        memset(col->f64, 0, (size_t)cap * sizeof(double));
+        break;
+    case RESCOL_TEXT:
+        col->off = (uint64_t *)Tcl_Alloc(((size_t)cap + 1) * sizeof(uint64_t));
+        memset(col->off, 0, ((size_t)cap + 1) * sizeof(uint64_t));
+        break;
+    default:
+        break;
+    }
+}
+
+static void ResultGrow(OradpiResult *r, Tcl_Size need) {
+    if (need <= r->cap)
+        return;
+    Tcl_Size cap = r->cap ? r->cap : 64;
+    while (cap < need)
+        cap *= 2;
+    size_t oldBits = ((size_t)r->cap + 7) / 8, newBits = ((size_t)cap + 7) / 8;
+    for (uint32_t c = 0; c < r->numCols; c++) {
+        OradpiResultCol *col = &r->cols[c];
+        col->nulls           = (unsigned char *)Tcl_Realloc((char *)col->nulls, newBits);
+        memset(col->nulls + oldBits, 0, newBits - oldBits);
+        if (col->i64) {
+            col->i64 = (int64_t *)Tcl_Realloc((char *)col->i64, (size_t)cap * sizeof(int64_t));
+            memset(col->i64 + r->cap, 0, (size_t)(cap - r->cap) * sizeof(int64_t));
+        }
+        if (col->f64) {
+            col->f64 = (double *)Tcl_Realloc((char *)col->f64, (size_t)cap * sizeof(double));
+            memset(col->f64 + r->cap, 0, (size_t)(cap - r->cap) * sizeof(double));
+        }
+        if (col->off)
+            col->off = (uint64_t *)Tcl_Realloc((char *)col->off, ((size_t)cap + 1) * sizeof(uint64_t));
+    }
+    r->cap = cap;
+}
+
+static void ResultTextAppend(OradpiResultCol *col, const char *p, size_t len) {
+    if (col->textLen + len > col->textCap) {
+        size_t cap = col->textCap ? col->textCap : 256;
+        while (cap < col->textLen + len)
+            cap *= 2;
+        col->text    = Tcl_Realloc(col->text, cap);
+        col->textCap = cap;
+    }
+    if (len)
+        memcpy(col->text + col->textLen, p, len);
+    col->textLen += len;
+}
+
+/* Integer column -> double column. */
+static void ResultColToDouble(OradpiResultCol *col, Tcl_Size cap, Tcl_Size rows) {
+    col->f64 = (double *)Tcl_Alloc((size_t)cap * sizeof(double));
+    memset(col->f64, 0, (size_t)cap * sizeof(double));
+    for (Tcl_Size i = 0; i < rows; i++)
+        col->f64[i] = (double)col->i64[i];
+    Tcl_Free((char *)col->i64);
+    col->i64  = NULL;
+    col->kind = RESCOL_DOUBLE;
+}
+
+/* Numeric column -> text column, values formatted as Tcl would. */
+static void ResultColToText(OradpiResultCol *col, Tcl_Size cap, Tcl_Size rows) {
+    int64_t *i64 = col->i64;
+    double  *f64 = col->f64;
+    col->i64     = NULL;
+    col->f64     = NULL;
+    col->kind    = RESCOL_TEXT;
+    col->isChar  = 1;
+    ResultColAllocValues(col, cap);
+    for (Tcl_Size i = 0; i < rows; i++) {
+        char buf[TCL_DOUBLE_SPACE + 24];
+        int  n = 0;
+        if (!RES_ISNULL(col, i)) {
+            if (i64)
+                n = snprintf(buf, sizeof(buf), "%" PRId64, i64[i]);
+            else {
+                Tcl_PrintDouble(NULL, f64[i], buf);
+                n = (int)strlen(buf);
+            }
+        }
+        ResultTextAppend(col, buf, (size_t)n);
+        col->off[i + 1] = col->textLen;
+    }
+    if (i64)
+        Tcl_Free((char *)i64);
+    if (f64)
+        Tcl_Free((char *)f64);
+}
+
+/* Set the kind of a column that has only seen NULLs so far. */
+static void ResultColStart(OradpiResult *r, OradpiResultCol *col, int kind) {
+    col->kind = kind;
+    ResultColAllocValues(col, r->cap);
+}
+
+OradpiResult *Oradpi_ResultNew(uint32_t numCols, Tcl_Obj *const *colNames) {
+    OradpiResult *r = (OradpiResult *)Tcl_Alloc(sizeof(*r));
+    memset(r, 0, sizeof(*r));
+    r->numCols = numCols;
+    r->cols    = (OradpiResultCol *)Tcl_Alloc((numCols ? numCols : 1) * sizeof(OradpiResultCol));
+    memset(r->cols, 0, (numCols ? numCols : 1) * sizeof(OradpiResultCol));
+    for (uint32_t c = 0; c < numCols; c++) {
+        r->cols[c].name = colNames[c];
+        Tcl_IncrRefCount(r->cols[c].name);
+    }
+    ResultGrow(r, 64);
+    return r;
+}
+
+void Oradpi_ResultPutNull(OradpiResult *r, uint32_t c) {
+    OradpiResultCol *col = &r->cols[c];
+    Tcl_Size         i   = r->numRows;
+    col->nulls[(size_t)i >> 3] |= (unsigned char)(1u << ((size_t)i & 7));
+    col->nullCount++;
+    if (col->kind == RESCOL_TEXT)
+        col->off[i + 1] = col->textLen;
+}
+
+void Oradpi_ResultPutInt(OradpiResult *r, uint32_t c, int64_t v) {
+    OradpiResultCol *col = &r->cols[c];
+    Tcl_Size         i   = r->numRows;
+    if (col->kind == RESCOL_NONE)
+        ResultColStart(r, col, RESCOL_INT);
+    switch (col->kind) {
+    case RESCOL_INT:
+        col->i64[i] = v;
+        break;
+    case RESCOL_DOUBLE:
+        col->f64[i] = (double)v;
+        break;
+    default: {
+        char buf[24];
+        int  n = snprintf(buf, sizeof(buf), "%" PRId64, v);
+        ResultTextAppend(col, buf, (size_t)n);
+        col->off[i + 1] = col->textLen;
+        break;
+    }
+    }
+}
+
+void Oradpi_ResultPutDouble(OradpiResult *r, uint32_t c, double v) {
+    OradpiResultCol *col = &r->cols[c];
+    Tcl_Size         i   = r->numRows;
+    if (col->kind == RESCOL_NONE)
+        ResultColStart(r, col, RESCOL_DOUBLE);
+    else if (col->kind == RESCOL_INT)
+        ResultColToDouble(col, r->cap, i);
+    if (col->kind == RESCOL_DOUBLE) {
+        col->f64[i] = v;
+        return;
+    }
+    char buf[TCL_DOUBLE_SPACE];
+    Tcl_PrintDouble(NULL, v, buf);
+    ResultTextAppend(col, buf, strlen(buf));
+    col->off[i + 1] = col->textLen;
+}
+
+void Oradpi_ResultPutText(OradpiResult *r, uint32_t c, const char *p, size_t len, int isChar) {
+    OradpiResultCol *col = &r->cols[c];
+    Tcl_Size         i   = r->numRows;
+    if (col->kind == RESCOL_NONE) {
+        ResultColStart(r, col, RESCOL_TEXT);
+        col->isChar = isChar;
+    } else if (col->kind != RESCOL_TEXT)
+        ResultColToText(col, r->cap, i);
+    ResultTextAppend(col, p, len);
+    col->off[i + 1] = col->textLen;
+}
+
+void Oradpi_ResultEndRow(OradpiResult *r) {
+    r->numRows++;
+    ResultGrow(r, r->numRows + 1);
+}
+
+void Oradpi_ResultFree(OradpiResult *r) {
+    if (!r)
+        return;
+    for (uint32_t c = 0; c < r->numCols; c++) {
+        OradpiResultCol *col = &r->cols[c];
+        Tcl_DecrRefCount(col->name);
+        if (r->map)
+            continue;
+        if (col->i64)
+            Tcl_Free((char *)col->i64);
+        if (col->f64)
+            Tcl_Free((char *)col->f64);
+        if (col->off)
+            Tcl_Free((char *)col->off);
+        if (col->text)
+            Tcl_Free(col->text);
+        if (col->nulls)
+            Tcl_Free((char *)col->nulls);
+    }
+    Tcl_Free((char *)r->cols);
+    if (r->map)
+        SnapshotUnmap(r->map, r->mapLen);
+    if (r->base.name)
+        Tcl_DecrRefCount(r->base.name);
+    Oradpi_FreeMsg(&r->base.msg);
+    Tcl_Free((char *)r);
+}
+
+/* ------------------------------------------------------------------------- *
+ * Handle registry
+ * ------------------------------------------------------------------------- */
+
+static Tcl_Obj *ResultRegister(Tcl_Interp *ip, OradpiResult *r) {
+    OradpiInterpState *st = Oradpi_GetInterpState(ip);
+    int                newEntry;
+    r->base.name = Oradpi_NewHandleName(ip, "oraR");
+    Tcl_IncrRefCount(r->base.name);
+    Tcl_HashEntry *e = Tcl_CreateHashEntry(&st->results, Tcl_GetString(r->base.name), &newEntry);
+    Tcl_SetHashValue(e, r);
+    return r->base.name;
+}
+
+static OradpiResult *ResultLookup(Tcl_Interp *ip, Tcl_Obj *nameObj) {
+    OradpiInterpState *st = (OradpiInterpState *)Tcl_GetAssocData(ip, "oradpi", NULL);
+    if (!st)
+        return NULL;
+    Tcl_HashEntry *e = Tcl_FindHashEntry(&st->results, Tcl_GetString(nameObj));
+    return e ? (OradpiResult *)Tcl_GetHashValue(e) : NULL;
+}
+
+void Oradpi_FreeResults(OradpiInterpState *is) {
+    Tcl_HashSearch search;
+    for (Tcl_HashEntry *e = Tcl_FirstHashEntry(&is->results, &search); e; e = Tcl_NextHashEntry(&search))
+        Oradpi_ResultFree((OradpiResult *)Tcl_GetHashValue(e));
+    Tcl_DeleteHashTable(&is->results);
+}
+
+/* ------------------------------------------------------------------------- *
+ * Values and comparisons
+ * ------------------------------------------------------------------------- */
+
+static Tcl_Obj *ResultDoubleObj(double dv) {
+    if (isfinite(dv)) {
+        double intpart;
+        /* (double)LLONG_MAX rounds up to 2^63, which does not fit. */
+        if (modf(dv, &intpart) == 0.0 && intpart >= (double)LLONG_MIN && intpart < 9223372036854775808.0)
+            return Tcl_NewWideIntObj((Tcl_WideInt)((long long)intpart));
+    }
+    return Tcl_NewDoubleObj(dv);
+}
+
+static Tcl_Obj *ResultValueObj(const OradpiResultCol *col, Tcl_Size i) {
+    if (col->kind == RESCOL_NONE || RES_ISNULL(col, i))
+        return Tcl_NewObj();
+    switch (col->kind) {
+    case RESCOL_INT:
+        return Tcl_NewWideIntObj((Tcl_WideInt)col->i64[i]);
+    case RESCOL_DOUBLE:
+        return ResultDoubleObj(col->f64[i]);
+    default: {
+        const char *p   = col->text + col->off[i];
+        size_t      len = col->off[i + 1] - col->off[i];
+        return col->isChar ? Tcl_NewStringObj(p, (Tcl_Size)len) : Tcl_NewByteArrayObj((const unsigned char *)p, (Tcl_Size)len);
+    }
+    }
+}
+
+static int ResultCompareText(const char *a, size_t alen, const char *b, size_t blen) {
+    int d = memcmp(a, b, alen < blen ? alen : blen);
+    if (d)
+        return d;
+    return alen < blen ? -1 : alen > blen ? 1 : 0;
+}
+
+/* Compare two non-NULL cells of one column. */
+static int ResultCompareCells(const OradpiResultCol *col, Tcl_Size a, Tcl_Size b) {
+    switch (col->kind) {
+    case RESCOL_INT:
+        return col->i64[a] < col->i64[b] ? -1 : col->i64[a] > col->i64[b] ? 1 : 0;
+    case RESCOL_DOUBLE:
+        return col->f64[a] < col->f64[b] ? -1 : col->f64[a] > col->f64[b] ? 1 : 0;
+    case RESCOL_TEXT:
+        return ResultCompareText(col->text + col->off[a], col->off[a + 1] - col->off[a], col->text + col->off[b], col->off[b + 1] - col->off[b]);
+    default:
+        return 0;
+    }
+}
+
+/* Order for sort and distinct: NULLs last in either direction. */
+static int ResultOrder(const OradpiResultCol *col, Tcl_Size a, Tcl_Size b, int decreasing) {
+    int an = RES_ISNULL(col, a), bn = RES_ISNULL(col, b);
+    if (an || bn)
+        return an - bn;
+    int d = ResultCompareCells(col, a, b);
+    return decreasing ? -d : d;
+}
+
+/* Stable merge sort of row indices. */
+static void ResultSortIndex(const OradpiResultCol *col, Tcl_Size *idx, Tcl_Size n, int decreasing) {
+    if (n < 2 || col->kind == RESCOL_NONE)
+        return;
+    Tcl_Size *tmp = (Tcl_Size *)Tcl_Alloc((size_t)n * sizeof(Tcl_Size));
+    for (Tcl_Size width = 1; width < n; width *= 2) {
+        for (Tcl_Size lo = 0; lo < n; lo += 2 * width) {
+            Tcl_Size mid = lo + width < n ? lo + width : n;
+            Tcl_Size hi  = lo + 2 * width < n ? lo + 2 * width : n;
+            Tcl_Size i = lo, j = mid, k = lo;
+            while (i < mid && j < hi)
+                tmp[k++] = ResultOrder(col, idx[j], idx[i], decreasing) < 0 ? idx[j++] : idx[i++];
+            while (i < mid)
+                tmp[k++] = idx[i++];
+            while (j < hi)
+                tmp[k++] = idx[j++];
+        }
+        memcpy(idx, tmp, (size_t)n * sizeof(Tcl_Size));
+    }
+    Tcl_Free((char *)tmp);
+}
+
+/* New result holding rows idx[0..n-1] of r, in that order. */
+static OradpiResult *ResultGather(const OradpiResult *r, const Tcl_Size *idx, Tcl_Size n) {
+    Tcl_Obj     **names = (Tcl_Obj **)Tcl_Alloc((r->numCols ? r->numCols : 1) * sizeof(Tcl_Obj *));
+    for (uint32_t c = 0; c < r->numCols; c++)
+        names[c] = r->cols[c].name;
+    OradpiResult *out = Oradpi_ResultNew(r->numCols, names);
+    Tcl_Free((char *)names);
+    ResultGrow(out, n + 1);
+    for (uint32_t c = 0; c < r->numCols; c++) {
+        const OradpiResultCol *src = &r->cols[c];
+        OradpiResultCol       *dst = &out->cols[c];
+        dst->isChar                = src->isChar;
+        if (src->kind != RESCOL_NONE)
+            ResultColStart(out, dst, src->kind);
+        for (Tcl_Size i = 0; i < n; i++) {
+            Tcl_Size s = idx[i];
+            if (RES_ISNULL(src, s)) {
+                dst->nulls[(size_t)i >> 3] |= (unsigned char)(1u << ((size_t)i & 7));
+                dst->nullCount++;
+            }
+            switch (src->kind) {
+            case RESCOL_INT:
+                dst->i64[i] = src->i64[s];
+                break;
+            case RESCOL_DOUBLE:
+                dst->f64[i] = src->f64[s];
+                break;
+            case RESCOL_TEXT:
+                ResultTextAppend(dst, src->text + src->off[s], src->off[s + 1] - src->off[s]);
+                dst->off[i + 1] = dst->textLen;
+                break;
+            default:
+                break;
+            }
+        }
+    }
+    out->numRows = n;
+    return out;
+}
+
+/* ------------------------------------------------------------------------- *
+ * Aggregation kernels
+ *
+ * The loops run over contiguous arrays without branches on the values so
+ * that the compiler can vectorize them; NULL slots hold 0 and are skipped
+ * by the counts, not by the sums.
+ * ------------------------------------------------------------------------- */
+
+/* Sum of an integer column.  The wrapping 64-bit sum is exact unless the
+ * double shadow sum says it overflowed, in which case the double is used. */
+static Tcl_Obj *ResultSumInt(const int64_t *v, Tcl_Size n) {
+    uint64_t isum = 0;
+    double   dsum = 0.0;
+    for (Tcl_Size i = 0; i < n; i++) {
+        isum += (uint64_t)v[i];
+        dsum += (double)v[i];
+    }
+    if (fabs(dsum) < 4611686018427387904.0) /* 2^62 */
+        return Tcl_NewWideIntObj((Tcl_WideInt)(int64_t)isum);
+    return Tcl_NewDoubleObj(dsum);
+}
+
+static double ResultSumDouble(const double *v, Tcl_Size n) {
+    double sum = 0.0;
+    for (Tcl_Size i = 0; i < n; i++)
+        sum += v[i];
+    return sum;
+}
+
+/* Index of the minimum (dir < 0) or maximum (dir > 0) non-NULL cell, or
+ * -1 when every cell is NULL. */
+static Tcl_Size ResultExtremeIndex(const OradpiResultCol *col, Tcl_Size n, int dir) {
+    Tcl_Size best = -1;
+    if (col->kind == RESCOL_NONE || col->nullCount == n)
+        return -1;
+    if (col->nullCount == 0 && col->kind == RESCOL_INT) {
+        const int64_t *v = col->i64;
+        int64_t        m = v[0];
+        if (dir < 0) {
+            for (Tcl_Size i = 1; i < n; i++)
+                m = v[i] < m ? v[i] : m;
+        } else {
+            for (Tcl_Size i = 1; i < n; i++)
+                m = v[i] > m ? v[i] : m;
+        }
+        for (best = 0; v[best] != m; best++)
+            ;
+        return best;
+    }
+    for (Tcl_Size i = 0; i < n; i++) {
+        if (RES_ISNULL(col, i))
+            continue;
+        if (best < 0 || ResultCompareCells(col, i, best) * dir > 0)
+            best = i;
+    }
+    return best;
+}
+
+/* ------------------------------------------------------------------------- *
+ * Filters
+ * ------------------------------------------------------------------------- */
+
+static const char *const filterOps[] = {"==", "!=", "<", "<=", ">", ">=", NULL};
+enum FilterOpIdx { FOP_EQ, FOP_NE, FOP_LT, FOP_LE, FOP_GT, FOP_GE };
+
+static int FilterTest(int d, int op) {
+    switch (op) {
+    case FOP_EQ:
+        return d == 0;
+    case FOP_NE:
+        return d != 0;
+    case FOP_LT:
+        return d < 0;
+    case FOP_LE:
+        return d <= 0;
+    case FOP_GT:
+        return d > 0;
+    default:
+        return d >= 0;
+    }
+}
+
+/* Row indices whose cell in col satisfies "cell op value"; NULL cells
+ * never match.  Numeric columns need a numeric value. */
+static int ResultFilterIndex(Tcl_Interp *ip, const OradpiResultCol *col, Tcl_Size n, int op, Tcl_Obj *valueObj, Tcl_Size *idx, Tcl_Size *countOut) {
+    Tcl_Size    count = 0;
+    Tcl_WideInt wv    = 0;
+    double      dv    = 0.0;
+    int         isInt = 0;
+
+    *countOut         = 0;
+    if (col->kind == RESCOL_NONE)
+        return TCL_OK;
+    if (col->kind != RESCOL_TEXT) {
+        if (Tcl_GetWideIntFromObj(NULL, valueObj, &wv) == TCL_OK)
+            isInt = 1;
+        else if (Tcl_GetDoubleFromObj(ip, valueObj, &dv) != TCL_OK)
+            return TCL_ERROR;
+        if (isInt)
+            dv = (double)wv;
+    }
+
+    if (col->kind == RESCOL_INT && isInt) {
+        const int64_t *v = col->i64;
+        for (Tcl_Size i = 0; i < n; i++) {
+            int d = v[i] < wv ? -1 : v[i] > wv ? 1 : 0;
+            if (FilterTest(d, op) && !RES_ISNULL(col, i))
+                idx[count++] = i;
+        }
+    } else if (col->kind != RESCOL_TEXT) {
+        for (Tcl_Size i = 0; i < n; i++) {
+            double x = col->kind == RESCOL_INT ? (double)col->i64[i] : col->f64[i];
+            int    d = x < dv ? -1 : x > dv ? 1 : 0;
+            if (FilterTest(d, op) && !RES_ISNULL(col, i))
+                idx[count++] = i;
+        }
+    } else {
+        Tcl_Size             vlen = 0;
+        const unsigned char *vp   = col->isChar ? (const unsigned char *)Tcl_GetStringFromObj(valueObj, &vlen) : Tcl_GetByteArrayFromObj(valueObj, &vlen);
+        for (Tcl_Size i = 0; i < n; i++) {
+            if (RES_ISNULL(col, i))
+                continue;
+            int d = ResultCompareText(col->text + col->off[i], col->off[i + 1] - col->off[i], (const char *)vp, (size_t)vlen);
+            if (FilterTest(d, op))
+                idx[count++] = i;
+        }
+    }
+    *countOut = count;
+    return TCL_OK;
+}
+
+/* ------------------------------------------------------------------------- *
+ * Snapshot files (orasnapshot)
+ *
+ * A snapshot is a result set written column by column so that it can be
+ * mapped back and used in place.  All integers are in host byte order
+ * (little-endian on every supported platform) and every section starts
+ * on an 8-byte boundary:
+ *
+ *   header     32 bytes: magic "ORASNAP1", uint32 byte-order tag
+ *              0x01020304, uint32 column count, uint64 row count,
+ *              uint64 reserved (0)
+ *   directory  64 bytes per column: uint32 kind (0 all NULL, 1 int64,
+ *              2 double, 3 text), uint32 flags (bit 0: text is
+ *              character data), uint64 NULL count, uint64 name offset,
+ *              uint64 name length, uint64 NULL bitmap offset, uint64
+ *              values offset, uint64 data offset, uint64 data length
+ *   sections   column name (UTF-8); NULL bitmap, ceil(rows/8) bytes, bit
+ *              i (LSB first) set when row i is NULL; values: rows int64
+ *              or double values (0 for NULL), or rows+1 uint64 offsets
+ *              into the data bytes for text columns
+ *
+ * Opening a snapshot checks the header, that every section lies in the
+ * file and that text offsets are in order; other values are only read
+ * when they are used.  Saving writes a temporary file in the target's
+ * directory and renames it into place.
+ * ------------------------------------------------------------------------- */
+
+#define SNAPSHOT_MAGIC "ORASNAP1"
+#define SNAPSHOT_TAG 0x01020304u
+#define SNAPSHOT_HEADER_BYTES 32
+#define SNAPSHOT_DIR_BYTES 64
+
+typedef struct SnapshotDirEntry {
+    uint32_t kind;
+    uint32_t flags;
+    uint64_t nullCount;
+    uint64_t nameOff, nameLen;
+    uint64_t nullsOff;
+    uint64_t valuesOff;
+    uint64_t dataOff, dataLen;
+} SnapshotDirEntry;
+
+static uint64_t SnapshotAlign(uint64_t pos) {
+    return (pos + 7) & ~(uint64_t)7;
+}
+
+static uint64_t SnapshotValuesBytes(uint32_t kind, uint64_t rows) {
+    switch (kind) {
+    case RESCOL_INT:
+    case RESCOL_DOUBLE:
+        return rows * 8;
+    case RESCOL_TEXT:
+        return (rows + 1) * 8;
+    default:
+        return 0;
+    }
+}
+
+static int SnapshotWrite(Tcl_Channel chan, const void *p, uint64_t len, uint64_t *pos) {
+    static const char zeros[8] = {0};
+    if (len && Tcl_Write(chan, (const char *)p, (Tcl_Size)len) < 0)
+        return TCL_ERROR;
+    *pos += len;
+    uint64_t pad = SnapshotAlign(*pos) - *pos;
+    if (pad && Tcl_Write(chan, zeros, (Tcl_Size)pad) < 0)
+        return TCL_ERROR;
+    *pos += pad;
+    return TCL_OK;
+}
+
+static int SnapshotSave(Tcl_Interp *ip, const OradpiResult *r, Tcl_Obj *pathObj) {
+    uint64_t          rows      = (uint64_t)r->numRows;
+    uint64_t          nullBytes = (rows + 7) / 8;
+    uint64_t          pos       = SnapshotAlign(SNAPSHOT_HEADER_BYTES + (uint64_t)SNAPSHOT_DIR_BYTES * r->numCols);
+    SnapshotDirEntry *dir       = (SnapshotDirEntry *)Tcl_Alloc((r->numCols ? r->numCols : 1) * sizeof(SnapshotDirEntry));
+    unsigned char     header[SNAPSHOT_HEADER_BYTES];
+    uint32_t          tag       = SNAPSHOT_TAG;
+    int               code      = TCL_OK;
+
+    for (uint32_t c = 0; c < r->numCols; c++) {
+        const OradpiResultCol *col = &r->cols[c];
+        Tcl_Size               nameLen;
+        Tcl_GetStringFromObj(col->name, &nameLen);
+        dir[c].kind      = (uint32_t)col->kind;
+        dir[c].flags     = col->isChar ? 1u : 0u;
+        dir[c].nullCount = (uint64_t)col->nullCount;
+        dir[c].nameOff   = pos;
+        dir[c].nameLen   = (uint64_t)nameLen;
+        pos              = SnapshotAlign(pos + dir[c].nameLen);
+        dir[c].nullsOff  = pos;
+        pos              = SnapshotAlign(pos + nullBytes);
+        dir[c].valuesOff = pos;
+        pos              = SnapshotAlign(pos + SnapshotValuesBytes(dir[c].kind, rows));
+        dir[c].dataOff   = pos;
+        dir[c].dataLen   = col->kind == RESCOL_TEXT ? col->off[rows] : 0;
+        pos              = SnapshotAlign(pos + dir[c].dataLen);
+    }
+
+    memset(header, 0, sizeof(header));
+    memcpy(header, SNAPSHOT_MAGIC, 8);
+    memcpy(header + 8, &tag, 4);
+    memcpy(header + 12, &r->numCols, 4);
+    memcpy(header + 16, &rows, 8);
+
+    /* Write beside the target and rename over it: a snapshot that is
+     * currently open stays mapped on the old file instead of being
+     * truncated under its readers. */
+    Tcl_Size parts;
+    Tcl_Obj *split  = Tcl_FSSplitPath(pathObj, &parts);
+    Tcl_Obj *dirObj = parts > 1 ? Tcl_FSJoinPath(split, parts - 1) : Tcl_NewStringObj(".", 1);
+    Tcl_Obj *tmpObj = Tcl_NewObj();
+    Tcl_IncrRefCount(split);
+    Tcl_IncrRefCount(dirObj);
+    Tcl_IncrRefCount(tmpObj);
+    Tcl_Channel chan = Tcl_OpenTemporaryFile(ip, dirObj, NULL, NULL, tmpObj);
+    Tcl_DecrRefCount(dirObj);
+    Tcl_DecrRefCount(split);
+    if (!chan) {
+        Tcl_DecrRefCount(tmpObj);
+        Tcl_Free((char *)dir);
+        return TCL_ERROR;
+    }
+    if (Tcl_SetChannelOption(ip, chan, "-translation", "binary") != TCL_OK) {
+        Tcl_Close(NULL, chan);
+        Tcl_FSDeleteFile(tmpObj);
+        Tcl_DecrRefCount(tmpObj);
+        Tcl_Free((char *)dir);
+        return TCL_ERROR;
+    }
+
+    pos  = 0;
+    code = SnapshotWrite(chan, header, sizeof(header), &pos);
+    for (uint32_t c = 0; code == TCL_OK && c < r->numCols; c++)
+        code = SnapshotWrite(chan, &dir[c], SNAPSHOT_DIR_BYTES, &pos);
+    for (uint32_t c = 0; code == TCL_OK && c < r->numCols; c++) {
+        const OradpiResultCol *col = &r->cols[c];
+        Tcl_Size               nameLen;
+        const char            *name = Tcl_GetStringFromObj(col->name, &nameLen);
+        code                        = SnapshotWrite(chan, name, (uint64_t)nameLen, &pos);
+        if (code == TCL_OK)
+            code = SnapshotWrite(chan, col->nulls, nullBytes, &pos);
+        if (code == TCL_OK && col->kind == RESCOL_INT)
+            code = SnapshotWrite(chan, col->i64, rows * 8, &pos);
+        else if (code == TCL_OK && col->kind == RESCOL_DOUBLE)
+            code = SnapshotWrite(chan, col->f64, rows * 8, &pos);
+        else if (code == TCL_OK && col->kind == RESCOL_TEXT) {
+            code = SnapshotWrite(chan, col->off, (rows + 1) * 8, &pos);
+            if (code == TCL_OK)
+                code = SnapshotWrite(chan, col->text, dir[c].dataLen, &pos);
+        }
+    }
+    Tcl_Free((char *)dir);
+    if (code != TCL_OK) {
+        Tcl_SetObjResult(ip, Tcl_ObjPrintf("orasnapshot: error writing \"%s\": %s", Tcl_GetString(pathObj), Tcl_PosixError(ip)));
+        Tcl_Close(NULL, chan);
+    } else if (Tcl_Close(ip, chan) != TCL_OK)
+        code = TCL_ERROR;
+    else if (Tcl_FSRenameFile(tmpObj, pathObj) != 0) {
+        Tcl_SetObjResult(ip, Tcl_ObjPrintf("orasnapshot: couldn't replace \"%s\": %s", Tcl_GetString(pathObj), Tcl_PosixError(ip)));
+        code = TCL_ERROR;
+    }
+    if (code != TCL_OK)
+        Tcl_FSDeleteFile(tmpObj);
+    Tcl_DecrRefCount(tmpObj);
+    return code;
+}
+
+static void SnapshotUnmap(void *map, size_t len) {
+#ifdef _WIN32
+    (void)len;
+    UnmapViewOfFile(map);
+#else
+    munmap(map, len);
+#endif
+}
+
+/* Map the whole file read-only; the mapping outlives the descriptor. */
+static int SnapshotMap(Tcl_Interp *ip, Tcl_Obj *pathObj, void **mapOut, size_t *lenOut) {
+    const void *native = Tcl_FSGetNativePath(pathObj);
+    const char *err    = NULL;
+    *mapOut            = NULL;
+    if (!native) {
+        Tcl_SetObjResult(ip, Tcl_ObjPrintf("orasnapshot: invalid path \"%s\"", Tcl_GetString(pathObj)));
+        return TCL_ERROR;
+    }
+#ifdef _WIN32
+    HANDLE        fh = CreateFileW((const WCHAR *)native, GENERIC_READ, FILE_SHARE_READ, NULL, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL);
+    LARGE_INTEGER size;
+    if (fh == INVALID_HANDLE_VALUE)
+        err = "cannot open file";
+    else if (!GetFileSizeEx(fh, &size) || size.QuadPart < SNAPSHOT_HEADER_BYTES || (uint64_t)size.QuadPart > (uint64_t)SIZE_MAX)
+        err = "not a snapshot file";
+    else {
+        HANDLE mh = CreateFileMappingW(fh, NULL, PAGE_READONLY, 0, 0, NULL);
+        if (mh) {
+            *mapOut = MapViewOfFile(mh, FILE_MAP_READ, 0, 0, 0);
+            CloseHandle(mh);
+        }
+        if (!*mapOut)
+            err = "cannot map file";
+        *lenOut = (size_t)size.QuadPart;
+    }
+    if (fh != INVALID_HANDLE_VALUE)
+        CloseHandle(fh);
+#else
+    struct stat sb;
+    int         fd = open((const char *)native, O_RDONLY);
+    if (fd < 0)
+        err = Tcl_ErrnoMsg(errno);
+    else if (fstat(fd, &sb) != 0 || sb.st_size < SNAPSHOT_HEADER_BYTES || (uint64_t)sb.st_size > (uint64_t)SIZE_MAX)
+        err = "not a snapshot file";
+    else {
+        void *map = mmap(NULL, (size_t)sb.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+        if (map == MAP_FAILED)
+            err = Tcl_ErrnoMsg(errno);
+        else {
+            *mapOut = map;
+            *lenOut = (size_t)sb.st_size;
+        }
+    }
+    if (fd >= 0)
+        close(fd);
+#endif
+    if (err) {
+        Tcl_SetObjResult(ip, Tcl_ObjPrintf("orasnapshot: couldn't open \"%s\": %s", Tcl_GetString(pathObj), err));
+        return TCL_ERROR;
+    }
+    return TCL_OK;
+}
+
+static int SnapshotSectionOk(uint64_t off, uint64_t len, size_t fileLen) {
+    return (off & 7) == 0 && off <= fileLen && len <= fileLen - off;
+}
+
+/* Text offsets must run from 0 to dataLen without going backwards, or a
+ * cell would read outside its column's data section. */
+static int SnapshotOffsetsOk(const uint64_t *off, uint64_t rows, uint64_t dataLen) {
+    if (off[0] != 0 || off[rows] != dataLen)
+        return 0;
+    for (uint64_t i = 0; i < rows; i++)
+        if (off[i] > off[i + 1])
+            return 0;
+    return 1;
+}
+
+/* A result whose columns point into the mapped snapshot file. */
+static int SnapshotOpen(Tcl_Interp *ip, Tcl_Obj *pathObj, OradpiResult **resultOut) {
+    void          *map = NULL;
+    size_t         len = 0;
+    uint32_t       tag, numCols;
+    uint64_t       rows;
+    OradpiResult  *r;
+    const char    *bad = NULL;
+
+    *resultOut         = NULL;
+    if (SnapshotMap(ip, pathObj, &map, &len) != TCL_OK)
+        return TCL_ERROR;
+    const unsigned char *base = (const unsigned char *)map;
+    memcpy(&tag, base + 8, 4);
+    memcpy(&numCols, base + 12, 4);
+    memcpy(&rows, base + 16, 8);
+    if (memcmp(base, SNAPSHOT_MAGIC, 8) != 0)
+        bad = "not a snapshot file";
+    else if (tag != SNAPSHOT_TAG)
+        bad = "snapshot was written with a different byte order";
+    else if (rows > (uint64_t)TCL_SIZE_MAX - 1 || (uint64_t)numCols * SNAPSHOT_DIR_BYTES > len - SNAPSHOT_HEADER_BYTES)
+        bad = "snapshot file is truncated or corrupt";
+    if (bad) {
+        SnapshotUnmap(map, len);
+        Tcl_SetObjResult(ip, Tcl_ObjPrintf("orasnapshot: \"%s\": %s", Tcl_GetString(pathObj), bad));
+        return TCL_ERROR;
+    }
+
+    r = (OradpiResult *)Tcl_Alloc(sizeof(*r));
+    memset(r, 0, sizeof(*r));
+    r->numRows = r->cap = (Tcl_Size)rows;
+    r->map              = map;
+    r->mapLen           = len;
+    r->cols             = (OradpiResultCol *)Tcl_Alloc((numCols ? numCols : 1) * sizeof(OradpiResultCol));
+    memset(r->cols, 0, (numCols ? numCols : 1) * sizeof(OradpiResultCol));
+    for (uint32_t c = 0; c < numCols; c++) {
+        SnapshotDirEntry d;
+        memcpy(&d, base + SNAPSHOT_HEADER_BYTES + (size_t)c * SNAPSHOT_DIR_BYTES, sizeof(d));
+        uint64_t valuesLen = SnapshotValuesBytes(d.kind, rows);
+        if (d.kind > RESCOL_TEXT || d.nullCount > rows || !SnapshotSectionOk(d.nameOff, d.nameLen, len) || !SnapshotSectionOk(d.nullsOff, (rows + 7) / 8, len) ||
+            !SnapshotSectionOk(d.valuesOff, valuesLen, len) || !SnapshotSectionOk(d.dataOff, d.dataLen, len) ||
+            (d.kind == RESCOL_TEXT && !SnapshotOffsetsOk((const uint64_t *)(base + d.valuesOff), rows, d.dataLen))) {
+            bad = "snapshot file is truncated or corrupt";
+            break;
+        }
+        OradpiResultCol *col = &r->cols[c];
+        col->name            = Tcl_NewStringObj((const char *)base + d.nameOff, (Tcl_Size)d.nameLen);
+        Tcl_IncrRefCount(col->name);
+        r->numCols++;
+        col->kind      = (int)d.kind;
+        col->isChar    = (d.flags & 1) != 0;
+        col->nullCount = (Tcl_Size)d.nullCount;
+        col->nulls     = (unsigned char *)(base + d.nullsOff);
+        if (d.kind == RESCOL_INT)
+            col->i64 = (int64_t *)(base + d.valuesOff);
+        else if (d.kind == RESCOL_DOUBLE)
+            col->f64 = (double *)(base + d.valuesOff);
+        else if (d.kind == RESCOL_TEXT) {
+            col->off     = (uint64_t *)(base + d.valuesOff);
+            col->text    = (char *)(base + d.dataOff);
+            col->textLen = (size_t)d.dataLen;
+        }
+    }
+    if (bad) {
+        Oradpi_ResultFree(r);
+        Tcl_SetObjResult(ip, Tcl_ObjPrintf("orasnapshot: \"%s\": %s", Tcl_GetString(pathObj), bad));
+        return TCL_ERROR;
+    }
+    *resultOut = r;
+    return TCL_OK;
+}
+
+/* ------------------------------------------------------------------------- *
+ * oraresult
+ * ------------------------------------------------------------------------- */
+
+static const char *const resultSubcmds[] = {"create", "count", "sum", "avg", "min", "max", "distinct", "filter", "sort", "rows", "row", "fetch", "column", "columns", "close", NULL};
+enum ResultSubcmdIdx { RES_CREATE, RES_COUNT, RES_SUM, RES_AVG, RES_MIN, RES_MAX, RES_DISTINCT, RES_FILTER, RES_SORT, RES_ROWS, RES_ROW, RES_FETCH, RES_COLUMN, RES_COLUMNS, RES_CLOSE };
+
+static const char *const resultCreateOpts[] = {"-max", "-dateformat", NULL};
+enum ResultCreateOptIdx { RCO_MAX, RCO_DATEFORMAT };
+
+/* Column by exact name, case-insensitive name, then index. */
+static int ResultColumnIndex(Tcl_Interp *ip, const OradpiResult *r, Tcl_Obj *colObj, uint32_t *out) {
+    const char *want = Tcl_GetString(colObj);
+    for (uint32_t c = 0; c < r->numCols; c++) {
+        if (strcmp(Tcl_GetString(r->cols[c].name), want) == 0) {
+            *out = c;
+            return TCL_OK;
+        }
+    }
+    Tcl_Size wantChars = Tcl_NumUtfChars(want, -1);
+    for (uint32_t c = 0; c < r->numCols; c++) {
+        const char *name = Tcl_GetString(r->cols[c].name);
+        if (Tcl_NumUtfChars(name, -1) == wantChars && Tcl_UtfNcasecmp(name, want, (size_t)wantChars) == 0) {
+            *out = c;
+            return TCL_OK;
+        }
+    }
+    Tcl_WideInt wi;
+    if (Tcl_GetWideIntFromObj(NULL, colObj, &wi) == TCL_OK && wi >= 0 && wi < (Tcl_WideInt)r->numCols) {
+        *out = (uint32_t)wi;
+        return TCL_OK;
+    }
+    Tcl_SetObjResult(ip, Tcl_ObjPrintf("oraresult: unknown column \"%s\"", want));
+    return TCL_ERROR;
+}
+
+static Tcl_Obj *ResultRowObj(const OradpiResult *r, Tcl_Size i, int asDict) {
+    Tcl_Obj *row = asDict ? Tcl_NewDictObj() : Tcl_NewListObj(0, NULL);
+    for (uint32_t k = 0; k < r->numCols; k++) {
+        if (asDict)
+            Tcl_DictObjPut(NULL, row, r->cols[k].name, ResultValueObj(&r->cols[k], i));
+        else
+            Tcl_ListObjAppendElement(NULL, row, ResultValueObj(&r->cols[k], i));
+    }
+    return row;
+}
+
+static int ResultCreate(Tcl_Interp *ip, Tcl_Size objc, Tcl_Obj *const objv[]) {
+    Tcl_WideInt maxRows    = 0;
+    int         dateFormat = -1;
+    if (objc < 3 || (objc % 2) != 1) {
+        Tcl_WrongNumArgs(ip, 2, objv, "statement-handle ?-max rows? ?-dateformat format?");
+        return TCL_ERROR;
+    }
+    OradpiStmt *st = Oradpi_LookupStmt(ip, objv[2]);
+    if (!st)
+        return Oradpi_SetError(ip, NULL, -1, "invalid statement handle");
+    for (Tcl_Size i = 3; i + 1 < objc; i += 2) {
+        int optIdx;
+        if (Tcl_GetIndexFromObj(ip, objv[i], resultCreateOpts, "option", 0, &optIdx) != TCL_OK)
+            return TCL_ERROR;
+        switch ((enum ResultCreateOptIdx)optIdx) {
+        case RCO_MAX:
+            if (Tcl_GetWideIntFromObj(ip, objv[i + 1], &maxRows) != TCL_OK)
+                return TCL_ERROR;
+            if (maxRows < 0)
+                return Oradpi_SetError(ip, (OradpiBase *)st, -1, "oraresult: -max must be >= 0");
+            break;
+        case RCO_DATEFORMAT:
+            if (Tcl_GetIndexFromObj(ip, objv[i + 1], Oradpi_DateFormatNames, "date format", 0, &dateFormat) != TCL_OK)
+                return TCL_ERROR;
+            break;
+        }
+    }
+    OradpiResult *r = NULL;
+    if (Oradpi_FetchToResult(ip, st, maxRows, dateFormat, &r) != TCL_OK)
+        return TCL_ERROR;
+    Tcl_SetObjResult(ip, ResultRegister(ip, r));
+    return TCL_OK;
+}
+
+/*
+ * oraresult subcommand ?args...?
+ *
+ *   Subcommands: create stmt ?-max N? ?-dateformat f?, count res ?col?,
+ *   sum|avg|min|max res col, distinct res col, filter res col op value,
+ *   sort res col ?-decreasing?, rows res ?-asdict?, row res index
+ *   ?-asdict?, fetch res ?-max N? ?-asdict?, column res col, columns res,
+ *   close res.
+ *   create fetches the remaining rows of an executed query into a columnar
+ *   result; filter and sort return new result handles.  fetch reads the
+ *   result like a cursor: each call returns the next rows (all remaining,
+ *   or at most N) and an empty list once the result is exhausted.
+ *   Returns: a result handle (create/filter/sort), a value or list.
+ *   Errors:  fetch errors; invalid handle; unknown column; non-numeric
+ *   column for sum/avg.
+ *   Thread-safety: results belong to the interp that created them.
+ */
+int Oradpi_Cmd_Result(void *cd, Tcl_Interp *ip, Tcl_Size objc, Tcl_Obj *const objv[]) {
+    (void)cd;
+    if (objc < 3) {
+        Tcl_WrongNumArgs(ip, 1, objv, "subcommand handle ?args...?");
+        return TCL_ERROR;
+    }
+
+    int subIdx;
+    if (Tcl_GetIndexFromObj(ip, objv[1], resultSubcmds, "subcommand", 0, &subIdx) != TCL_OK)
+        return TCL_ERROR;
+    if (subIdx == RES_CREATE)
+        return ResultCreate(ip, objc, objv);
+
+    OradpiResult *r = ResultLookup(ip, objv[2]);
+    if (!r)
+        return Oradpi_SetError(ip, NULL, -1, "invalid result handle");
+
+    uint32_t c = 0;
+    switch ((enum ResultSubcmdIdx)subIdx) {
+    case RES_COUNT:
+        if (objc != 3 && objc != 4) {
+            Tcl_WrongNumArgs(ip, 2, objv, "result-handle ?column?");
+            return TCL_ERROR;
+        }
+        if (objc == 3) {
+            Tcl_SetObjResult(ip, Tcl_NewWideIntObj((Tcl_WideInt)r->numRows));
+            return TCL_OK;
+        }
+        if (ResultColumnIndex(ip, r, objv[3], &c) != TCL_OK)
+            return TCL_ERROR;
+        Tcl_SetObjResult(ip, Tcl_NewWideIntObj((Tcl_WideInt)(r->numRows - r->cols[c].nullCount)));
+        return TCL_OK;
+
+    case RES_SUM:
+    case RES_AVG: {
+        if (objc != 4) {
+            Tcl_WrongNumArgs(ip, 2, objv, "result-handle column");
+            return TCL_ERROR;
+        }
+        if (ResultColumnIndex(ip, r, objv[3], &c) != TCL_OK)
+            return TCL_ERROR;
+        const OradpiResultCol *col = &r->cols[c];
+        Tcl_Size               n   = r->numRows - col->nullCount;
+        if (col->kind == RESCOL_TEXT)
+            return Oradpi_SetError(ip, NULL, -1, "oraresult: column is not numeric");
+        if (col->kind == RESCOL_NONE || n == 0) {
+            Tcl_SetObjResult(ip, Tcl_NewObj());
+            return TCL_OK;
+        }
+        if (subIdx == RES_SUM) {
+            Tcl_SetObjResult(ip, col->kind == RESCOL_INT ? ResultSumInt(col->i64, r->numRows) : ResultDoubleObj(ResultSumDouble(col->f64, r->numRows)));
+            return TCL_OK;
+        }
+        double sum = 0.0;
+        if (col->kind == RESCOL_INT) {
+            for (Tcl_Size i = 0; i < r->numRows; i++)
+                sum += (double)col->i64[i];
+        } else
+            sum = ResultSumDouble(col->f64, r->numRows);
+        Tcl_SetObjResult(ip, Tcl_NewDoubleObj(sum / (double)n));
+        return TCL_OK;
+    }
+
+    case RES_MIN:
+    case RES_MAX: {
+        if (objc != 4) {
+            Tcl_WrongNumArgs(ip, 2, objv, "result-handle column");
+            return TCL_ERROR;
+        }
+        if (ResultColumnIndex(ip, r, objv[3], &c) != TCL_OK)
+            return TCL_ERROR;
+        Tcl_Size i = ResultExtremeIndex(&r->cols[c], r->numRows, subIdx == RES_MIN ? -1 : 1);
+        Tcl_SetObjResult(ip, i < 0 ? Tcl_NewObj() : ResultValueObj(&r->cols[c], i));
+        return TCL_OK;
+    }
+
+    case RES_DISTINCT: {
+        if (objc != 4) {
+            Tcl_WrongNumArgs(ip, 2, objv, "result-handle column");
+            return TCL_ERROR;
+        }
+        if (ResultColumnIndex(ip, r, objv[3], &c) != TCL_OK)
+            return TCL_ERROR;
+        const OradpiResultCol *col  = &r->cols[c];
+        Tcl_Obj               *list = Tcl_NewListObj(0, NULL);
+        Tcl_Size               n    = 0;
+        if (col->kind == RESCOL_NONE || r->numRows == 0) {
+            Tcl_SetObjResult(ip, list);
+            return TCL_OK;
+        }
+        Tcl_Size *idx = (Tcl_Size *)Tcl_Alloc((size_t)r->numRows * sizeof(Tcl_Size));
+        for (Tcl_Size i = 0; i < r->numRows; i++)
+            if (!RES_ISNULL(col, i))
+                idx[n++] = i;
+        ResultSortIndex(col, idx, n, 0);
+        for (Tcl_Size i = 0; i < n; i++) {
+            if (i > 0 && ResultCompareCells(col, idx[i - 1], idx[i]) == 0)
+                continue;
+            Tcl_ListObjAppendElement(NULL, list, ResultValueObj(col, idx[i]));
+        }
+        Tcl_Free((char *)idx);
+        Tcl_SetObjResult(ip, list);
+        return TCL_OK;
+    }
+
+    case RES_FILTER:
+    case RES_SORT: {
+        int       op = 0, decreasing = 0;
+        Tcl_Size  n  = 0;
+        if (subIdx == RES_FILTER && objc != 6) {
+            Tcl_WrongNumArgs(ip, 2, objv, "result-handle column operator value");
+            return TCL_ERROR;
+        }
+        if (subIdx == RES_SORT && objc != 4 && objc != 5) {
+            Tcl_WrongNumArgs(ip, 2, objv, "result-handle column ?-decreasing?");
+            return TCL_ERROR;
+        }
+        if (ResultColumnIndex(ip, r, objv[3], &c) != TCL_OK)
+            return TCL_ERROR;
+        if (subIdx == RES_FILTER && Tcl_GetIndexFromObj(ip, objv[4], filterOps, "operator", 0, &op) != TCL_OK)
+            return TCL_ERROR;
+        if (subIdx == RES_SORT && objc == 5) {
+            static const char *const sortOpts[] = {"-decreasing", NULL};
+            int                      optIdx;
+            if (Tcl_GetIndexFromObj(ip, objv[4], sortOpts, "option", 0, &optIdx) != TCL_OK)
+                return TCL_ERROR;
+            decreasing = 1;
+        }
+        Tcl_Size *idx = (Tcl_Size *)Tcl_Alloc((size_t)(r->numRows ? r->numRows : 1) * sizeof(Tcl_Size));
+        if (subIdx == RES_FILTER) {
+            if (ResultFilterIndex(ip, &r->cols[c], r->numRows, op, objv[5], idx, &n) != TCL_OK) {
+                Tcl_Free((char *)idx);
+                return TCL_ERROR;
+            }
+        } else {
+            for (Tcl_Size i = 0; i < r->numRows; i++)
+                idx[i] = i;
+            n = r->numRows;
+            ResultSortIndex(&r->cols[c], idx, n, decreasing);
+        }
+        OradpiResult *out = ResultGather(r, idx, n);
+        Tcl_Free((char *)idx);
+        Tcl_SetObjResult(ip, ResultRegister(ip, out));
+        return TCL_OK;
+    }
+
+    case RES_ROWS: {
+        int asDict = 0;
+        if (objc == 4) {
+            static const char *const rowsOpts[] = {"-asdict", NULL};
+            int                      optIdx;
+            if (Tcl_GetIndexFromObj(ip, objv[3], rowsOpts, "option", 0, &optIdx) != TCL_OK)
+                return TCL_ERROR;
+            asDict = 1;
+        } else if (objc != 3) {
+            Tcl_WrongNumArgs(ip, 2, objv, "result-handle ?-asdict?");
+            return TCL_ERROR;
+        }
+        Tcl_Obj *list = Tcl_NewListObj(0, NULL);
+        for (Tcl_Size i = 0; i < r->numRows; i++)
+            Tcl_ListObjAppendElement(NULL, list, ResultRowObj(r, i, asDict));
+        Tcl_SetObjResult(ip, list);
+        return TCL_OK;
+    }
+
+    case RES_ROW: {
+        Tcl_WideInt index;
+        int         asDict = 0;
+        if (objc == 5) {
+            static const char *const rowOpts[] = {"-asdict", NULL};
+            int                      optIdx;
+            if (Tcl_GetIndexFromObj(ip, objv[4], rowOpts, "option", 0, &optIdx) != TCL_OK)
+                return TCL_ERROR;
+            asDict = 1;
+        } else if (objc != 4) {
+            Tcl_WrongNumArgs(ip, 2, objv, "result-handle index ?-asdict?");
+            return TCL_ERROR;
+        }
+        if (Tcl_GetWideIntFromObj(ip, objv[3], &index) != TCL_OK)
+            return TCL_ERROR;
+        if (index < 0 || index >= (Tcl_WideInt)r->numRows)
+            return Oradpi_SetError(ip, NULL, -1, "oraresult: row index out of range");
+        Tcl_SetObjResult(ip, ResultRowObj(r, (Tcl_Size)index, asDict));
+        return TCL_OK;
+    }
+
+    case RES_FETCH: {
+        static const char *const fetchOpts[] = {"-max", "-asdict", NULL};
+        enum FetchOptIdx { RFO_MAX, RFO_ASDICT };
+        Tcl_WideInt maxRows = 0;
+        int         asDict  = 0;
+        for (Tcl_Size i = 3; i < objc; i++) {
+            int optIdx;
+            if (Tcl_GetIndexFromObj(ip, objv[i], fetchOpts, "option", 0, &optIdx) != TCL_OK)
+                return TCL_ERROR;
+            if (optIdx == RFO_ASDICT) {
+                asDict = 1;
+                continue;
+            }
+            if (i + 1 >= objc) {
+                Tcl_WrongNumArgs(ip, 2, objv, "result-handle ?-max rows? ?-asdict?");
+                return TCL_ERROR;
+            }
+            if (Tcl_GetWideIntFromObj(ip, objv[++i], &maxRows) != TCL_OK)
+                return TCL_ERROR;
+            if (maxRows < 0)
+                return Oradpi_SetError(ip, NULL, -1, "oraresult: -max must be >= 0");
+        }
+        Tcl_Size end = r->numRows;
+        if (maxRows > 0 && maxRows < (Tcl_WideInt)(end - r->cursor))
+            end = r->cursor + (Tcl_Size)maxRows;
+        Tcl_Obj *list = Tcl_NewListObj(0, NULL);
+        for (; r->cursor < end; r->cursor++)
+            Tcl_ListObjAppendElement(NULL, list, ResultRowObj(r, r->cursor, asDict));
+        Tcl_SetObjResult(ip, list);
+        return TCL_OK;
+    }
+
+    case RES_COLUMN: {
+        if (objc != 4) {
+            Tcl_WrongNumArgs(ip, 2, objv, "result-handle column");
+            return TCL_ERROR;
+        }
+        if (ResultColumnIndex(ip, r, objv[3], &c) != TCL_OK)
+            return TCL_ERROR;
+        Tcl_Obj *list = Tcl_NewListObj(0, NULL);
+        for (Tcl_Size i = 0; i < r->numRows; i++)
+            Tcl_ListObjAppendElement(NULL, list, ResultValueObj(&r->cols[c], i));
+        Tcl_SetObjResult(ip, list);
+        return TCL_OK;
+    }
+
+    case RES_COLUMNS: {
+        if (objc != 3) {
+            Tcl_WrongNumArgs(ip, 2, objv, "result-handle");
+            return TCL_ERROR;
+        }
+        Tcl_Obj *list = Tcl_NewListObj(0, NULL);
+        for (uint32_t k = 0; k < r->numCols; k++)
+            Tcl_ListObjAppendElement(NULL, list, r->cols[k].name);
+        Tcl_SetObjResult(ip, list);
+        return TCL_OK;
+    }
+
+    case RES_CLOSE: {
+        if (objc != 3) {
+            Tcl_WrongNumArgs(ip, 2, objv, "result-handle");
+            return TCL_ERROR;
+        }
+        OradpiInterpState *st = Oradpi_GetInterpState(ip);
+        Tcl_HashEntry     *e  = Tcl_FindHashEntry(&st->results, Tcl_GetString(r->base.name));
+        if (e)
+            Tcl_DeleteHashEntry(e);
+        Oradpi_ResultFree(r);
+        Tcl_SetObjResult(ip, Tcl_NewIntObj(0));
+        return TCL_OK;
+    }
+
+    default:
+        break;
+    }
+    return TCL_OK;
+}
+
+/*
+ * orasnapshot save handle file ?-max N? ?-dateformat f?
+ * orasnapshot open file
+ *
+ *   save writes a result handle, or the remaining rows of an executed
+ *   statement handle, to file in the snapshot format described above.
+ *   open maps a snapshot file read-only and returns a result handle whose
+ *   columns are read in place; close the handle with "oraresult close".
+ *   Returns: save: the number of rows written; open: a result handle.
+ *   Errors:  invalid handle; fetch errors; I/O errors; not a snapshot file
+ *   or one that is truncated or was written with another byte order.
+ *   Thread-safety: results belong to the interp that created them.
+ */
+int Oradpi_Cmd_Snapshot(void *cd, Tcl_Interp *ip, Tcl_Size objc, Tcl_Obj *const objv[]) {
+    static const char *const snapSubcmds[] = {"save", "open", NULL};
+    enum SnapSubcmdIdx { SNAP_SAVE, SNAP_OPEN };
+    (void)cd;
+    if (objc < 3) {
+        Tcl_WrongNumArgs(ip, 1, objv, "subcommand ?args...?");
+        return TCL_ERROR;
+    }
+    int subIdx;
+    if (Tcl_GetIndexFromObj(ip, objv[1], snapSubcmds, "subcommand", 0, &subIdx) != TCL_OK)
+        return TCL_ERROR;
+
+    if (subIdx == SNAP_OPEN) {
+        if (objc != 3) {
+            Tcl_WrongNumArgs(ip, 2, objv, "file");
+            return TCL_ERROR;
+        }
+        OradpiResult *r = NULL;
+        if (SnapshotOpen(ip, objv[2], &r) != TCL_OK)
+            return TCL_ERROR;
+        Tcl_SetObjResult(ip, ResultRegister(ip, r));
+        return TCL_OK;
+    }
+
+    Tcl_WideInt maxRows    = 0;
+    int         dateFormat = -1;
+    if (objc < 4 || (objc % 2) != 0) {
+        Tcl_WrongNumArgs(ip, 2, objv, "handle file ?-max rows? ?-dateformat format?");
+        return TCL_ERROR;
+    }
+    for (Tcl_Size i = 4; i + 1 < objc; i += 2) {
+        int optIdx;
+        if (Tcl_GetIndexFromObj(ip, objv[i], resultCreateOpts, "option", 0, &optIdx) != TCL_OK)
+            return TCL_ERROR;
+        switch ((enum ResultCreateOptIdx)optIdx) {
+        case RCO_MAX:
+            if (Tcl_GetWideIntFromObj(ip, objv[i + 1], &maxRows) != TCL_OK)
+                return TCL_ERROR;
+            if (maxRows < 0)
+                return Oradpi_SetError(ip, NULL, -1, "orasnapshot: -max must be >= 0");
+            break;
+        case RCO_DATEFORMAT:
+            if (Tcl_GetIndexFromObj(ip, objv[i + 1], Oradpi_DateFormatNames, "date format", 0, &dateFormat) != TCL_OK)
+                return TCL_ERROR;
+            break;
+        }
+    }
+
+    OradpiResult *r = ResultLookup(ip, objv[2]);
+    if (r) {
+        if (objc > 4)
+            return Oradpi_SetError(ip, NULL, -1, "orasnapshot: -max and -dateformat apply to statement handles only");
+        if (SnapshotSave(ip, r, objv[3]) != TCL_OK)
+            return TCL_ERROR;
+        Tcl_SetObjResult(ip, Tcl_NewWideIntObj((Tcl_WideInt)r->numRows));
+        return TCL_OK;
+    }
+    OradpiStmt *st = Oradpi_LookupStmt(ip, objv[2]);
+    if (!st)
+        return Oradpi_SetError(ip, NULL, -1, "invalid result or statement handle");
+    if (Oradpi_FetchToResult(ip, st, maxRows, dateFormat, &r) != TCL_OK)
+        return TCL_ERROR;
+    int code = SnapshotSave(ip, r, objv[3]);
+    if (code == TCL_OK)
+        Tcl_SetObjResult(ip, Tcl_NewWideIntObj((Tcl_WideInt)r->numRows));
+    Oradpi_ResultFree(r);
+    return code;
+}
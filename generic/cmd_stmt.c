@@ -41,14 +41,17 @@ static int               Oradpi_ConfigStmt(Tcl_Interp *ip, OradpiStmt *s, Tcl_Si
  * ------------------------------------------------------------------------- */
 
 /* ---- Connection config option table ---- */
-static const char *const connOptNames[] = {"stmtcachesize", "fetcharraysize",  "prefetchrows",   "calltimeout",  "inlineLobs",       "foMaxAttempts",
-                                           "foBackoffMs",   "foBackoffFactor", "foErrorClasses", "foDebounceMs", "failovercallback", NULL};
+static const char *const connOptNames[] = {"stmtcachesize", "fetcharraysize",  "fetchbudget",    "prefetchrows", "calltimeout",      "inlineLobs", "inlineLobMax",
+                                           "exactNumbers",  "foMaxAttempts", "foBackoffMs",     "foBackoffFactor", "foErrorClasses", "foDebounceMs", "failovercallback", NULL};
 enum ConnOptIdx {
     COPT_STMTCACHE,
     COPT_FETCHARRAY,
+    COPT_FETCHBUDGET,
     COPT_PREFETCHROWS,
     COPT_CALLTIMEOUT,
     COPT_INLINELOBS,
+    COPT_INLINELOBMAX,
+    COPT_EXACTNUMBERS,
     COPT_FOMAXATT,
     COPT_FOBACKOFF,
     COPT_FOFACTOR,
@@ -95,9 +98,20 @@ static int GetRequiredPositiveU32(Tcl_Interp *ip, Tcl_Obj *obj, uint32_t *out, c
     return TCL_OK;
 }
 
+/* fetcharraysize / fetchrows accept "auto" in place of a row count. */
+static int IsAutoSize(Tcl_Obj *obj) {
+    return strcmp(Tcl_GetString(obj), "auto") == 0;
+}
+
+static Tcl_Obj *ConnFetchArrayObj(const OradpiConn *co) {
+    if (co->fetchAuto)
+        return Tcl_NewStringObj("auto", -1);
+    return Oradpi_NewUInt32Obj(co->fetchArraySize ? co->fetchArraySize : DPI_DEFAULT_FETCH_ARRAY_SIZE);
+}
+
 /* ---- Statement config option table ---- */
-static const char *const stmtOptNames[] = {"fetchrows", "prefetchrows", NULL};
-enum StmtOptIdx { SOPT_FETCHROWS, SOPT_PREFETCHROWS };
+static const char *const stmtOptNames[] = {"fetchrows", "prefetchrows", "internstrings", "readahead", "coltypes", "dateformat", "resultcache", NULL};
+enum StmtOptIdx { SOPT_FETCHROWS, SOPT_PREFETCHROWS, SOPT_INTERNSTRINGS, SOPT_READAHEAD, SOPT_COLTYPES, SOPT_DATEFORMAT, SOPT_RESULTCACHE };
 
 int Oradpi_Cmd_Stmt(void *cd, Tcl_Interp *ip, Tcl_Size objc, Tcl_Obj *const objv[]) {
     return Oradpi_Cmd_Open(cd, ip, objc, objv);
@@ -131,9 +145,10 @@ static int Oradpi_ConfigConn(Tcl_Interp *ip, OradpiConn *co, Tcl_Size objc, Tcl_
         LAPPEND_CHK(ip, res, Tcl_NewStringObj("stmtcachesize", -1));
         LAPPEND_CHK(ip, res, Oradpi_NewUInt32Obj(co->stmtCacheSize));
 
-        uint32_t fas = co->fetchArraySize ? co->fetchArraySize : DPI_DEFAULT_FETCH_ARRAY_SIZE;
         LAPPEND_CHK(ip, res, Tcl_NewStringObj("fetcharraysize", -1));
-        LAPPEND_CHK(ip, res, Oradpi_NewUInt32Obj(fas));
+        LAPPEND_CHK(ip, res, ConnFetchArrayObj(co));
+        LAPPEND_CHK(ip, res, Tcl_NewStringObj("fetchbudget", -1));
+        LAPPEND_CHK(ip, res, Oradpi_NewUInt32Obj(co->fetchBudget));
 
         LAPPEND_CHK(ip, res, Tcl_NewStringObj("prefetchrows", -1));
         LAPPEND_CHK(ip, res, Oradpi_NewUInt32Obj(co->prefetchRows));
@@ -149,6 +164,10 @@ static int Oradpi_ConfigConn(Tcl_Interp *ip, OradpiConn *co, Tcl_Size objc, Tcl_
 
         LAPPEND_CHK(ip, res, Tcl_NewStringObj("inlineLobs", -1));
         LAPPEND_CHK(ip, res, Tcl_NewBooleanObj(co->inlineLobs ? 1 : 0));
+        LAPPEND_CHK(ip, res, Tcl_NewStringObj("inlineLobMax", -1));
+        LAPPEND_CHK(ip, res, Oradpi_NewUInt32Obj(co->inlineLobMax));
+        LAPPEND_CHK(ip, res, Tcl_NewStringObj("exactNumbers", -1));
+        LAPPEND_CHK(ip, res, Tcl_NewBooleanObj(co->exactNumbers ? 1 : 0));
 
         LAPPEND_CHK(ip, res, Tcl_NewStringObj("foMaxAttempts", -1));
         LAPPEND_CHK(ip, res, Oradpi_NewUInt32Obj(co->foMaxAttempts));
@@ -193,11 +212,12 @@ static int Oradpi_ConfigConn(Tcl_Interp *ip, OradpiConn *co, Tcl_Size objc, Tcl_
             Tcl_SetObjResult(ip, Oradpi_NewUInt32Obj(co->stmtCacheSize));
             return TCL_OK;
         }
-        case COPT_FETCHARRAY: {
-            uint32_t fas = co->fetchArraySize ? co->fetchArraySize : DPI_DEFAULT_FETCH_ARRAY_SIZE;
-            Tcl_SetObjResult(ip, Oradpi_NewUInt32Obj(fas));
+        case COPT_FETCHARRAY:
+            Tcl_SetObjResult(ip, ConnFetchArrayObj(co));
+            return TCL_OK;
+        case COPT_FETCHBUDGET:
+            Tcl_SetObjResult(ip, Oradpi_NewUInt32Obj(co->fetchBudget));
             return TCL_OK;
-        }
         case COPT_PREFETCHROWS:
             Tcl_SetObjResult(ip, Oradpi_NewUInt32Obj(co->prefetchRows));
             return TCL_OK;
@@ -215,6 +235,12 @@ static int Oradpi_ConfigConn(Tcl_Interp *ip, OradpiConn *co, Tcl_Size objc, Tcl_
         case COPT_INLINELOBS:
             Tcl_SetObjResult(ip, Tcl_NewBooleanObj(co->inlineLobs ? 1 : 0));
             return TCL_OK;
+        case COPT_INLINELOBMAX:
+            Tcl_SetObjResult(ip, Oradpi_NewUInt32Obj(co->inlineLobMax));
+            return TCL_OK;
+        case COPT_EXACTNUMBERS:
+            Tcl_SetObjResult(ip, Tcl_NewBooleanObj(co->exactNumbers ? 1 : 0));
+            return TCL_OK;
         case COPT_FOMAXATT:
             Tcl_SetObjResult(ip, Oradpi_NewUInt32Obj(co->foMaxAttempts));
             return TCL_OK;
@@ -268,8 +294,20 @@ static int Oradpi_ConfigConn(Tcl_Interp *ip, OradpiConn *co, Tcl_Size objc, Tcl_
             break;
         }
         case COPT_FETCHARRAY: {
+            /* auto keeps fetchArraySize as the starting batch for new
+             * statements; the budget then bounds how far it may grow. */
+            if (IsAutoSize(objv[i + 1])) {
+                co->fetchAuto = 1;
+                break;
+            }
             if (GetRequiredPositiveU32(ip, objv[i + 1], &co->fetchArraySize, "fetcharraysize") != TCL_OK)
                 return TCL_ERROR;
+            co->fetchAuto = 0;
+            break;
+        }
+        case COPT_FETCHBUDGET: {
+            if (GetRequiredPositiveU32(ip, objv[i + 1], &co->fetchBudget, "fetchbudget") != TCL_OK)
+                return TCL_ERROR;
             break;
         }
         case COPT_PREFETCHROWS: {
@@ -297,6 +335,23 @@ static int Oradpi_ConfigConn(Tcl_Interp *ip, OradpiConn *co, Tcl_Size objc, Tcl_
             co->inlineLobs = v ? 1 : 0;
             break;
         }
+        case COPT_INLINELOBMAX: {
+            /* Chosen when a statement's fetch cache is built, so it
+             * applies to queries parsed after this call. */
+            uint32_t v = 0;
+            if (Oradpi_GetUInt32FromObj(ip, objv[i + 1], &v, "inlineLobMax") != TCL_OK)
+                return TCL_ERROR;
+            co->inlineLobMax = v;
+            break;
+        }
+        case COPT_EXACTNUMBERS: {
+            /* Like inlineLobMax, applies from the next fetch-cache build. */
+            int v = 0;
+            if (Tcl_GetBooleanFromObj(ip, objv[i + 1], &v) != TCL_OK)
+                return TCL_ERROR;
+            co->exactNumbers = v ? 1 : 0;
+            break;
+        }
         case COPT_FOMAXATT: {
             uint32_t v = 0;
             if (Oradpi_GetUInt32FromObj(ip, objv[i + 1], &v, "foMaxAttempts") != TCL_OK)
@@ -406,6 +461,16 @@ static int Oradpi_ConfigStmt(Tcl_Interp *ip, OradpiStmt *s, Tcl_Size objc, Tcl_O
         }
         LAPPEND_CHK(ip, res, Tcl_NewStringObj("prefetchrows", -1));
         LAPPEND_CHK(ip, res, Oradpi_NewUInt32Obj(pr));
+        LAPPEND_CHK(ip, res, Tcl_NewStringObj("internstrings", -1));
+        LAPPEND_CHK(ip, res, Oradpi_NewUInt32Obj(s->internMax));
+        LAPPEND_CHK(ip, res, Tcl_NewStringObj("readahead", -1));
+        LAPPEND_CHK(ip, res, Tcl_NewBooleanObj(s->readahead));
+        LAPPEND_CHK(ip, res, Tcl_NewStringObj("coltypes", -1));
+        LAPPEND_CHK(ip, res, s->colTypes ? s->colTypes : Tcl_NewObj());
+        LAPPEND_CHK(ip, res, Tcl_NewStringObj("dateformat", -1));
+        LAPPEND_CHK(ip, res, Tcl_NewStringObj(Oradpi_DateFormatNames[s->dateFormat], -1));
+        LAPPEND_CHK(ip, res, Tcl_NewStringObj("resultcache", -1));
+        LAPPEND_CHK(ip, res, Oradpi_NewUInt32Obj(s->resultCacheTtl));
         Tcl_SetObjResult(ip, res);
         return TCL_OK;
     }
@@ -428,6 +493,21 @@ static int Oradpi_ConfigStmt(Tcl_Interp *ip, OradpiStmt *s, Tcl_Size objc, Tcl_O
             Tcl_SetObjResult(ip, Oradpi_NewUInt32Obj(pr));
             return TCL_OK;
         }
+        case SOPT_INTERNSTRINGS:
+            Tcl_SetObjResult(ip, Oradpi_NewUInt32Obj(s->internMax));
+            return TCL_OK;
+        case SOPT_READAHEAD:
+            Tcl_SetObjResult(ip, Tcl_NewBooleanObj(s->readahead));
+            return TCL_OK;
+        case SOPT_COLTYPES:
+            Tcl_SetObjResult(ip, s->colTypes ? s->colTypes : Tcl_NewObj());
+            return TCL_OK;
+        case SOPT_DATEFORMAT:
+            Tcl_SetObjResult(ip, Tcl_NewStringObj(Oradpi_DateFormatNames[s->dateFormat], -1));
+            return TCL_OK;
+        case SOPT_RESULTCACHE:
+            Tcl_SetObjResult(ip, Oradpi_NewUInt32Obj(s->resultCacheTtl));
+            return TCL_OK;
         }
         /* unreachable */
         return TCL_ERROR;
@@ -439,8 +519,17 @@ static int Oradpi_ConfigStmt(Tcl_Interp *ip, OradpiStmt *s, Tcl_Size objc, Tcl_O
 
         switch ((enum StmtOptIdx)idx) {
         case SOPT_FETCHROWS: {
+            if (IsAutoSize(objv[3])) {
+                /* Rebuild the cache so the define buffers are sized from
+                 * the budget; the reported value is the learned batch. */
+                s->fetchAuto = 1;
+                Oradpi_FreeFetchCache(s);
+                Tcl_SetObjResult(ip, Oradpi_NewUInt32Obj(s->fetchArray));
+                return TCL_OK;
+            }
             if (GetRequiredPositiveU32(ip, objv[3], &s->fetchArray, "fetchrows") != TCL_OK)
                 return TCL_ERROR;
+            s->fetchAuto = 0;
             /* The output variable cache is sized to the old fetchArray.
              * Invalidate it so the next orafetch rebuilds vars with the new
              * maxArraySize; otherwise direct buffer access would overflow. */
@@ -473,6 +562,63 @@ static int Oradpi_ConfigStmt(Tcl_Interp *ip, OradpiStmt *s, Tcl_Size objc, Tcl_O
             Tcl_SetObjResult(ip, Oradpi_NewUInt32Obj(pr));
             return TCL_OK;
         }
+        case SOPT_INTERNSTRINGS: {
+            uint32_t n = 0;
+            if (Oradpi_GetUInt32FromObj(ip, objv[3], &n, "internstrings") != TCL_OK)
+                return TCL_ERROR;
+            /* Intern tables are built with the fetch cache; rebuild it so
+             * the new bound (or disabling) takes effect on the next fetch. */
+            s->internMax = n;
+            Oradpi_FreeFetchCache(s);
+            Tcl_SetObjResult(ip, Oradpi_NewUInt32Obj(n));
+            return TCL_OK;
+        }
+        case SOPT_READAHEAD: {
+            int on = 0;
+            if (Tcl_GetBooleanFromObj(ip, objv[3], &on) != TCL_OK)
+                return TCL_ERROR;
+            /* Any batch already read ahead is dropped; the cursor position
+             * moves past those rows either way. */
+            Oradpi_ReadaheadDiscard(s);
+            s->readahead = on;
+            Tcl_SetObjResult(ip, Tcl_NewBooleanObj(on));
+            return TCL_OK;
+        }
+        case SOPT_COLTYPES: {
+            Tcl_Size n = 0;
+            if (Oradpi_CheckColTypes(ip, objv[3]) != TCL_OK || Tcl_ListObjLength(ip, objv[3], &n) != TCL_OK)
+                return TCL_ERROR;
+            /* Defines are chosen when the fetch cache is built; rebuild it
+             * so the overrides apply from the next orafetch. */
+            Tcl_Obj *spec = n ? objv[3] : NULL;
+            if (spec)
+                Tcl_IncrRefCount(spec);
+            if (s->colTypes)
+                Tcl_DecrRefCount(s->colTypes);
+            s->colTypes = spec;
+            Oradpi_FreeFetchCache(s);
+            Tcl_SetObjResult(ip, spec ? spec : Tcl_NewObj());
+            return TCL_OK;
+        }
+        case SOPT_DATEFORMAT: {
+            /* Applied per orafetch call; the fetch cache is unaffected. */
+            int fmt = 0;
+            if (Tcl_GetIndexFromObj(ip, objv[3], Oradpi_DateFormatNames, "date format", 0, &fmt) != TCL_OK)
+                return TCL_ERROR;
+            s->dateFormat = fmt;
+            Tcl_SetObjResult(ip, Tcl_NewStringObj(Oradpi_DateFormatNames[fmt], -1));
+            return TCL_OK;
+        }
+        case SOPT_RESULTCACHE: {
+            /* Seconds a published result stays valid; 0 disables.  Takes
+             * effect from the next execute. */
+            uint32_t ttl = 0;
+            if (Oradpi_GetUInt32FromObj(ip, objv[3], &ttl, "resultcache") != TCL_OK)
+                return TCL_ERROR;
+            s->resultCacheTtl = ttl;
+            Tcl_SetObjResult(ip, Oradpi_NewUInt32Obj(ttl));
+            return TCL_OK;
+        }
         }
         /* unreachable */
         return TCL_ERROR;
@@ -519,26 +665,28 @@ int Oradpi_Cmd_Parse(void *cd, Tcl_Interp *ip, Tcl_Size objc, Tcl_Obj *const obj
     (void)cd;
     /* oraparse handle sql                (default: validates SQL with a PARSE_ONLY server round-trip)
      * oraparse handle -novalidate sql    (client-side prepare only; errors surface at execute time)
+     * oraparse handle -scrollable sql    (scrollable cursor for orafetch -position)
      *
      * The PARSE_ONLY round-trip catches syntax errors at parse time and is the
      * default.  Use -novalidate on hot paths where the SQL is known-good and
      * the per-parse round-trip cost is measurable. */
-    if (objc < 3 || objc > 4) {
-        Tcl_WrongNumArgs(ip, 1, objv, "statement-handle ?-novalidate? sql-text");
+    if (objc < 3 || objc > 5) {
+        Tcl_WrongNumArgs(ip, 1, objv, "statement-handle ?-novalidate? ?-scrollable? sql-text");
         return TCL_ERROR;
     }
     int      doValidate = 1; /* default: validate */
-    Tcl_Obj *sqlObj     = NULL;
-    if (objc == 4) {
-        const char *flag = Tcl_GetString(objv[2]);
-        if (strcmp(flag, "-novalidate") != 0) {
-            Tcl_WrongNumArgs(ip, 1, objv, "statement-handle ?-novalidate? sql-text");
+    int      scrollable = 0;
+    Tcl_Obj *sqlObj     = objv[objc - 1];
+    for (Tcl_Size i = 2; i < objc - 1; i++) {
+        const char *flag = Tcl_GetString(objv[i]);
+        if (strcmp(flag, "-novalidate") == 0) {
+            doValidate = 0;
+        } else if (strcmp(flag, "-scrollable") == 0) {
+            scrollable = 1;
+        } else {
+            Tcl_WrongNumArgs(ip, 1, objv, "statement-handle ?-novalidate? ?-scrollable? sql-text");
             return TCL_ERROR;
         }
-        doValidate = 0;
-        sqlObj     = objv[3];
-    } else {
-        sqlObj = objv[2];
     }
     OradpiStmt *s = Oradpi_LookupStmt(ip, objv[1]);
     if (!s)
@@ -555,6 +703,8 @@ int Oradpi_Cmd_Parse(void *cd, Tcl_Interp *ip, Tcl_Size objc, Tcl_Obj *const obj
     const char *stmtKey = Tcl_GetString(s->base.name);
     Oradpi_BindStoreForget(ip, stmtKey);
     Oradpi_PendingsForget(ip, stmtKey);
+    Oradpi_CursorBindsFree(s);
+    Oradpi_ReadaheadDiscard(s);
 
     CONN_GATE_ENTER(s->owner);
     if (s->stmt) {
@@ -562,10 +712,11 @@ int Oradpi_Cmd_Parse(void *cd, Tcl_Interp *ip, Tcl_Size objc, Tcl_Obj *const obj
         dpiStmt_release(s->stmt);
         s->stmt = NULL;
     }
-    Oradpi_FreeFetchCache(s);
+    Oradpi_FetchCacheReparse(s, sql, sqlLen);
     s->stmtIsDML = s->stmtIsPLSQL = s->stmtIsQuery = 0;
+    s->scrollable = scrollable;
 
-    if (dpiConn_prepareStmt(s->owner->conn, 0, sql, (uint32_t)sqlLen, NULL, 0, &s->stmt) != DPI_SUCCESS) {
+    if (dpiConn_prepareStmt(s->owner->conn, scrollable, sql, (uint32_t)sqlLen, NULL, 0, &s->stmt) != DPI_SUCCESS) {
         CONN_GATE_LEAVE(s->owner);
         return SetStmtAndOwnerODPIError(ip, s, "dpiConn_prepareStmt");
     }
@@ -578,6 +729,11 @@ int Oradpi_Cmd_Parse(void *cd, Tcl_Interp *ip, Tcl_Size objc, Tcl_Obj *const obj
     }
     {
         uint32_t pr = s->prefetchRows ? s->prefetchRows : (s->owner ? s->owner->prefetchRows : 0);
+        /* In auto mode the execute round trip must carry a single-row
+         * result together with its end-of-fetch, so -max 1 lookups never
+         * need a separate fetch. */
+        if (s->fetchAuto && pr < ORADPI_FETCHAUTO_PREFETCH)
+            pr = ORADPI_FETCHAUTO_PREFETCH;
         if (pr) {
             if (dpiStmt_setPrefetchRows(s->stmt, pr) != DPI_SUCCESS) {
                 CONN_GATE_LEAVE(s->owner);
@@ -604,6 +760,10 @@ int Oradpi_Cmd_Parse(void *cd, Tcl_Interp *ip, Tcl_Size objc, Tcl_Obj *const obj
 
     Oradpi_UpdateStmtType(s);
     CONN_GATE_LEAVE(s->owner);
+    Tcl_IncrRefCount(sqlObj);
+    if (s->sqlText)
+        Tcl_DecrRefCount(s->sqlText);
+    s->sqlText = sqlObj;
 
     Tcl_SetObjResult(ip, Tcl_NewIntObj(0));
     return TCL_OK;
@@ -168,6 +168,10 @@ static void RegisterCommands(Tcl_Interp *ip) {
     RegisterCommand(ip, nsPtr, "orabreak", Oradpi_Cmd_Break);
     RegisterCommand(ip, nsPtr, "oraexecasync", Oradpi_Cmd_ExecAsync);
     RegisterCommand(ip, nsPtr, "orawaitasync", Oradpi_Cmd_WaitAsync);
+    RegisterCommand(ip, nsPtr, "orafetchasync", Oradpi_Cmd_FetchAsync);
+    RegisterCommand(ip, nsPtr, "oraparallelscan", Oradpi_Cmd_ParallelScan);
+    RegisterCommand(ip, nsPtr, "oraresult", Oradpi_Cmd_Result);
+    RegisterCommand(ip, nsPtr, "orasnapshot", Oradpi_Cmd_Snapshot);
 
     if (internalNs)
         Tcl_CreateObjCommand2(ip, ORATCL_NAMESPACE "::internal::connGateId", Oradpi_Cmd_InternalConnGateId, NULL, NULL);
@@ -57,6 +57,19 @@ typedef struct GlobalConnRec {
     unsigned int       opDepth;
     char              *nameKey; /* owned copy for hash removal / diagnostics */
 
+    /* Lock elision.  While the record has a single reference (the wrapper
+     * that published it: no adopters, async jobs, read-ahead or LOB
+     * handles) only homeTid can use the connection, and it passes the
+     * gate by bumping fastDepth instead of taking connLock.  exclusive
+     * is cleared under gConnMapMutex as soon as a second reference is
+     * taken, before that reference is handed out; a thread then entering
+     * the gate the slow way waits until fastDepth drops to 0, and homeTid
+     * keeps using the fast path for calls nested in one already made
+     * that way.  exclusive is set again when the count returns to 1. */
+    Tcl_ThreadId       homeTid;
+    _Atomic(int)       exclusive;
+    _Atomic(unsigned)  fastDepth; /* written by homeTid only */
+
     /* Behavioral policy snapshot.  Populated at publish time from
      * the owner's wrapper, and updated by oraconfig.  Adopters copy these
      * instead of using hardcoded defaults, ensuring the same dpiConn*
@@ -64,7 +77,12 @@ typedef struct GlobalConnRec {
     int                snap_autocommit;
     uint32_t           snap_fetchArraySize;
     uint32_t           snap_prefetchRows;
+    int                snap_fetchAuto;
+    uint32_t           snap_fetchBudget;
     int                snap_inlineLobs;
+    uint32_t           snap_inlineLobMax;
+    int                snap_exactNumbers;
+    int                snap_events;
     uint32_t           snap_foMaxAttempts;
     uint32_t           snap_foBackoffMs;
     double             snap_foBackoffFactor;
@@ -133,6 +151,12 @@ static void GlobalConnMap_Init(void) {
     Tcl_MutexUnlock(&gConnMapMutex);
 }
 
+/* Caller holds gConnMapMutex.  A reference taken on another thread than
+ * homeTid clears exclusive here, before the caller can use it. */
+static void GlobalConn_UpdateExclusiveLocked(GlobalConnRec *gr) {
+    atomic_store(&gr->exclusive, gr->refCount == 1);
+}
+
 static GlobalConnRec *GlobalConn_PublishAndRef(const char *name, dpiConn *conn, dpiPool *pool) {
     GlobalConnRec *gr = NULL;
 
@@ -151,6 +175,8 @@ static GlobalConnRec *GlobalConn_PublishAndRef(const char *name, dpiConn *conn,
     gr->ownerAlive = 1;
     atomic_store_explicit(&gr->pubConn, conn, memory_order_release);
     gr->refCount++;
+    gr->homeTid = Tcl_GetCurrentThread();
+    GlobalConn_UpdateExclusiveLocked(gr);
     /* Retain pool lifetime in the shared record.  addRef so the pool
      * survives after the owner's wrapper releases its local reference. */
     if (pool && !gr->pool) {
@@ -176,6 +202,7 @@ static GlobalConnRec *GlobalConn_LookupForAdoptAndRef(const char *name, dpiConn
             if (res && ownerAlive) {
                 if (dpiConn_addRef(res) == DPI_SUCCESS) {
                     gr->refCount++;
+                    GlobalConn_UpdateExclusiveLocked(gr);
                 } else {
                     gr  = NULL;
                     res = NULL;
@@ -209,6 +236,7 @@ void Oradpi_SharedConnAddRef(GlobalConnRec *gr) {
         return;
     Tcl_MutexLock(&gConnMapMutex);
     gr->refCount++;
+    GlobalConn_UpdateExclusiveLocked(gr);
     Tcl_MutexUnlock(&gConnMapMutex);
 }
 
@@ -221,6 +249,7 @@ void Oradpi_SharedConnRelease(GlobalConnRec *gr) {
     Tcl_MutexLock(&gConnMapMutex);
     if (gr->refCount > 0)
         gr->refCount--;
+    GlobalConn_UpdateExclusiveLocked(gr);
     if (gr->refCount == 0) {
         if (gConnMapInited && gr->nameKey) {
             Tcl_HashEntry *he = Tcl_FindHashEntry(&gConnByName, gr->nameKey);
@@ -256,6 +285,49 @@ static void GlobalConn_DeadlineFromNow(Tcl_Time *deadline, int timeoutMs) {
     }
 }
 
+/* Leave the fast path; wake a thread waiting for fastDepth to drain once
+ * the connection is no longer exclusive. */
+static void GlobalConn_FastLeave(GlobalConnRec *gr, unsigned depth) {
+    if (depth > 1) {
+        atomic_store_explicit(&gr->fastDepth, depth - 1, memory_order_relaxed);
+        return;
+    }
+    atomic_store(&gr->fastDepth, 0);
+    if (!atomic_load(&gr->exclusive)) {
+        Tcl_MutexLock(&gr->connLock);
+        Tcl_ConditionNotify(&gr->connCond);
+        Tcl_MutexUnlock(&gr->connLock);
+    }
+}
+
+/* Pass the gate without connLock if gr is exclusive to this thread, or
+ * this thread already holds it that way.  Returns 0 when the slow path
+ * must be taken. */
+static int GlobalConn_FastEnter(GlobalConnRec *gr, Tcl_ThreadId self) {
+    if (gr->homeTid != self)
+        return 0;
+    unsigned depth = atomic_load_explicit(&gr->fastDepth, memory_order_relaxed);
+    if (depth > 0) {
+        atomic_store_explicit(&gr->fastDepth, depth + 1, memory_order_relaxed);
+        return 1;
+    }
+    if (!atomic_load_explicit(&gr->exclusive, memory_order_relaxed))
+        return 0;
+    /* Publish fastDepth before re-reading exclusive (sequentially
+     * consistent, against the store in GlobalConn_UpdateExclusiveLocked
+     * and the fastDepth read of a slow-path waiter). */
+    atomic_store(&gr->fastDepth, 1);
+    if (atomic_load(&gr->exclusive))
+        return 1;
+    GlobalConn_FastLeave(gr, 1);
+    return 0;
+}
+
+/* Caller holds connLock. */
+static int GlobalConn_GateBusyLocked(GlobalConnRec *gr, Tcl_ThreadId self) {
+    return gr->opDepth > 0 || (gr->homeTid != self && atomic_load(&gr->fastDepth) > 0);
+}
+
 int Oradpi_SharedConnGateEnterTimed(GlobalConnRec *gr, int timeoutMs) {
     Tcl_ThreadId self;
 
@@ -263,6 +335,8 @@ int Oradpi_SharedConnGateEnterTimed(GlobalConnRec *gr, int timeoutMs) {
         return 1;
 
     self = Tcl_GetCurrentThread();
+    if (GlobalConn_FastEnter(gr, self))
+        return 1;
     Tcl_MutexLock(&gr->connLock);
 
     if (gr->opDepth > 0 && gr->opOwner == self) {
@@ -274,9 +348,9 @@ int Oradpi_SharedConnGateEnterTimed(GlobalConnRec *gr, int timeoutMs) {
     if (timeoutMs >= 0) {
         Tcl_Time deadline;
         GlobalConn_DeadlineFromNow(&deadline, timeoutMs);
-        while (gr->opDepth > 0) {
+        while (GlobalConn_GateBusyLocked(gr, self)) {
             Tcl_ConditionWait(&gr->connCond, &gr->connLock, &deadline);
-            if (gr->opDepth == 0)
+            if (!GlobalConn_GateBusyLocked(gr, self))
                 break;
             Tcl_Time now;
             Tcl_GetTime(&now);
@@ -286,7 +360,7 @@ int Oradpi_SharedConnGateEnterTimed(GlobalConnRec *gr, int timeoutMs) {
             }
         }
     } else {
-        while (gr->opDepth > 0)
+        while (GlobalConn_GateBusyLocked(gr, self))
             Tcl_ConditionWait(&gr->connCond, &gr->connLock, NULL);
     }
 
@@ -304,8 +378,18 @@ void Oradpi_SharedConnGateLeave(GlobalConnRec *gr) {
     if (!gr)
         return;
 
+    /* Entries made on the fast path are always the innermost ones. */
+    Tcl_ThreadId self = Tcl_GetCurrentThread();
+    if (gr->homeTid == self) {
+        unsigned depth = atomic_load_explicit(&gr->fastDepth, memory_order_relaxed);
+        if (depth > 0) {
+            GlobalConn_FastLeave(gr, depth);
+            return;
+        }
+    }
+
     Tcl_MutexLock(&gr->connLock);
-    if (gr->opDepth > 0 && gr->opOwner == Tcl_GetCurrentThread()) {
+    if (gr->opDepth > 0 && gr->opOwner == self) {
         gr->opDepth--;
         if (gr->opDepth == 0) {
             gr->opOwner = (Tcl_ThreadId)0;
@@ -357,7 +441,12 @@ void Oradpi_SharedConnSyncBehavior(OradpiConn *co) {
     gr->snap_autocommit      = co->autocommit;
     gr->snap_fetchArraySize  = co->fetchArraySize;
     gr->snap_prefetchRows    = co->prefetchRows;
+    gr->snap_fetchAuto       = co->fetchAuto;
+    gr->snap_fetchBudget     = co->fetchBudget;
     gr->snap_inlineLobs      = co->inlineLobs;
+    gr->snap_inlineLobMax    = co->inlineLobMax;
+    gr->snap_exactNumbers    = co->exactNumbers;
+    gr->snap_events          = co->events;
     gr->snap_foMaxAttempts   = co->foMaxAttempts;
     gr->snap_foBackoffMs     = co->foBackoffMs;
     gr->snap_foBackoffFactor = co->foBackoffFactor;
@@ -420,6 +509,12 @@ void Oradpi_FreeConn(OradpiConn *co) {
         Tcl_DecrRefCount(co->failoverCallback);
         co->failoverCallback = NULL;
     }
+    Oradpi_ResultCacheConnClosed(co);
+    Oradpi_ParallelScanConnClosed(co);
+    if (co->rcIdentity) {
+        Tcl_Free(co->rcIdentity);
+        co->rcIdentity = NULL;
+    }
 
     if (co->conn) {
         if (co->ownerClose) {
@@ -493,6 +588,7 @@ void Oradpi_FreeStmt(Tcl_Interp *ip, OradpiStmt *s) {
          * On timeout, we proceed with cleanup; the worker's own addRef'd
          * handles will be released when it eventually returns. */
         (void)Oradpi_StmtWaitForAsync(s, 1 /*cancel*/, 30000 /*30s timeout*/);
+        Oradpi_ReadaheadDiscard(s);
         /* Use timed gate to avoid infinite hang if a worker still holds the
          * gate (e.g. breakExecution failed to interrupt a stuck OCI call).
          * On timeout: detach wrapper without calling dpiStmt_close/release —
@@ -512,12 +608,21 @@ void Oradpi_FreeStmt(Tcl_Interp *ip, OradpiStmt *s) {
     }
     s->owner = NULL;
     Oradpi_FreeFetchCache(s);
+    if (s->colTypes) {
+        Tcl_DecrRefCount(s->colTypes);
+        s->colTypes = NULL;
+    }
+    if (s->sqlText) {
+        Tcl_DecrRefCount(s->sqlText);
+        s->sqlText = NULL;
+    }
     /* Clean up bind stores and pending refs for this statement */
     if (ip && s->base.name) {
         const char *skey = Tcl_GetString(s->base.name);
         Oradpi_BindStoreForget(ip, skey);
         Oradpi_PendingsForget(ip, skey);
     }
+    Oradpi_CursorBindsFree(s);
     if (s->base.name) {
         Tcl_DecrRefCount(s->base.name);
         s->base.name = NULL;
@@ -604,6 +709,8 @@ OradpiInterpState *Oradpi_GetInterpState(Tcl_Interp *ip) {
      * are torn down in the correct phase order by Oradpi_DeleteInterpData. */
     Tcl_InitHashTable(&st->bindStoreMap.byStmt, TCL_STRING_KEYS);
     Tcl_InitHashTable(&st->pendingMap.byStmt, TCL_STRING_KEYS);
+    Tcl_InitHashTable(&st->fetchNames, TCL_STRING_KEYS);
+    Tcl_InitHashTable(&st->results, TCL_STRING_KEYS);
     Tcl_SetAssocData(ip, "oradpi", Oradpi_DeleteInterpData, st);
     return st;
 }
@@ -650,6 +757,10 @@ void Oradpi_DeleteInterpData(void *clientData, Tcl_Interp *ip) {
         Oradpi_FreeConn((OradpiConn *)Tcl_GetHashValue(e));
     Tcl_DeleteHashTable(&st->conns);
 
+    /* Phase 5: Result sets and shared fetch cache name objects */
+    Oradpi_FreeResults(st);
+    Oradpi_FreeFetchNames(st);
+
     Tcl_Free((char *)st);
 }
 
@@ -664,8 +775,11 @@ OradpiConn *Oradpi_NewConn(Tcl_Interp *ip, dpiConn *conn, dpiPool *pool) {
     co->autocommit     = 0;
     co->fetchArraySize = DPI_DEFAULT_FETCH_ARRAY_SIZE;
     co->prefetchRows   = DPI_DEFAULT_PREFETCH_ROWS;
+    co->fetchBudget    = ORADPI_FETCHAUTO_BUDGET;
     co->callTimeout    = 0;
     co->inlineLobs     = 0;
+    co->inlineLobMax   = 0;
+    co->exactNumbers   = 0;
     co->stmtCacheSize  = 0;
     co->ownerClose     = 1;
     co->cachedEncoding = NULL;
@@ -712,7 +826,12 @@ static OradpiConn *Oradpi_AdoptConn(Tcl_Interp *ip, const char *handleName, Glob
     co->autocommit      = shared->snap_autocommit;
     co->fetchArraySize  = shared->snap_fetchArraySize;
     co->prefetchRows    = shared->snap_prefetchRows;
+    co->fetchAuto       = shared->snap_fetchAuto;
+    co->fetchBudget     = shared->snap_fetchBudget;
     co->inlineLobs      = shared->snap_inlineLobs;
+    co->inlineLobMax    = shared->snap_inlineLobMax;
+    co->exactNumbers    = shared->snap_exactNumbers;
+    co->events          = shared->snap_events;
     co->foMaxAttempts   = shared->snap_foMaxAttempts;
     co->foBackoffMs     = shared->snap_foBackoffMs;
     co->foBackoffFactor = shared->snap_foBackoffFactor;
@@ -792,8 +911,10 @@ OradpiStmt *Oradpi_NewStmt(Tcl_Interp *ip, OradpiConn *co) {
     /* Inherit connection-level fetchArraySize so that the
      * parse-time dpiStmt_setFetchArraySize() call at cmd_stmt.c fires,
      * and so the statement-level getter reports the effective value. */
-    if (co)
+    if (co) {
         s->fetchArray = co->fetchArraySize;
+        s->fetchAuto  = co->fetchAuto;
+    }
     int            newEntry;
     Tcl_HashEntry *e = Tcl_CreateHashEntry(&st->stmts, Tcl_GetString(s->base.name), &newEntry);
     Tcl_SetHashValue(e, s);
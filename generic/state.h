@@ -71,14 +71,20 @@ typedef struct OradpiConn {
     OradpiBase     base;
     dpiConn       *conn;
     dpiPool       *pool;
+    uint32_t       poolMaxSessions; /* oralogon -pool max; sizes oraparallelscan's acquires */
     int            autocommit;
 
     /* Connection-level configuration */
     uint32_t       stmtCacheSize;
     uint32_t       fetchArraySize;
     uint32_t       prefetchRows;
+    int            fetchAuto;   /* fetcharraysize auto */
+    uint32_t       fetchBudget; /* define-buffer bytes per statement in auto mode */
     uint32_t       callTimeout;
     int            inlineLobs;
+    uint32_t       inlineLobMax; /* > 0: LOB columns are defined as LONG up to this many bytes */
+    int            exactNumbers; /* wide/fractional NUMBERs are defined as decimal text */
+    int            events; /* opened with "oralogon -events 1" */
 
     /* Cached encoding string from ODPI (avoids per-bind round-trip) */
     char          *cachedEncoding;
@@ -112,14 +118,43 @@ typedef struct OradpiConn {
     int            ownerClose;
     GlobalConnRec *shared;  /* shared per-dpiConn gate and adoption record */
     int            adopted; /* nonzero if this handle was adopted from another interp */
+
+    /* Result cache (cmd_fetch.c).  rcIdentity names the session's user,
+     * schema, database, time zone and NLS settings for cache keys; it is
+     * read on first use and again after a statement that may have altered
+     * the session.  rcSubscr is the change-notification registration of
+     * cached queries. */
+    char          *rcIdentity;
+    dpiSubscr     *rcSubscr;
+    uint64_t       rcSubscrId;
+
+    /* oraparallelscan runs still delivering batches (cmd_fetch.c). */
+    struct OradpiParallelScan *scans;
 } OradpiConn;
 
+/* REF CURSOR OUT bind ("orabind $S :name -cursor").  var is the
+ * DPI_ORACLE_TYPE_STMT variable bound for the next execute; handle is the
+ * statement handle its cursor was registered as by the last one. */
+typedef struct OradpiCursorBind {
+    Tcl_Obj *name; /* bind name without the colon */
+    dpiVar  *var;
+    dpiData *data;
+    Tcl_Obj *handle;
+} OradpiCursorBind;
+
 typedef struct OradpiStmt {
     OradpiBase        base;
     OradpiConn       *owner;
     dpiStmt          *stmt;
     uint32_t          fetchArray;
     uint32_t          prefetchRows; /* per-statement override; 0 = use connection default */
+    /* Adaptive sizing ("fetchrows auto").  fetchArray is then the learned
+     * rows per round trip, kept <= fetchAutoCap, the define-buffer row
+     * count derived from the owner's fetchBudget at fetch-cache build. */
+    int               fetchAuto;
+    uint32_t          fetchAutoCap;
+    int               dateFormat; /* ORADPI_DATEFMT_*, "oraconfig $S dateformat" */
+    Tcl_Obj          *sqlText;    /* last prepared SQL text, for result cache keys */
 
     uint32_t          numCols;
     int               defined;
@@ -137,6 +172,7 @@ typedef struct OradpiStmt {
      * upper_copy allocations, and Tcl_ObjPrintf calls in tight fetch loops.
      * Owned by cmd_fetch.c; lifecycle managed via Oradpi_FreeFetchCache. */
     uint32_t          fetchCacheNumCols; /* 0 = cache invalid */
+    int               fetchRedefine;     /* kept across a re-parse; defines pending */
     int              *fetchIsChar;       /* [fetchCacheNumCols] column char-type flags */
     Tcl_Obj         **fetchColNames;     /* [fetchCacheNumCols] upper-cased, IncrRefCount'd */
     Tcl_Obj         **fetchNumberKeys;   /* [fetchCacheNumCols] "0".."N-1", IncrRefCount'd */
@@ -149,6 +185,8 @@ typedef struct OradpiStmt {
     dpiVar          **fetchVars;        /* [fetchCacheNumCols] addRef'd dpiVar handles */
     dpiData         **fetchVarData;     /* [fetchCacheNumCols] var buffer pointer arrays */
     dpiNativeTypeNum *fetchNativeTypes; /* [fetchCacheNumCols] native type per column */
+    dpiOracleTypeNum *fetchOracleTypes; /* [fetchCacheNumCols] define Oracle type per column */
+    uint32_t         *fetchDefineSizes; /* [fetchCacheNumCols] define size in bytes per column */
 
     /* Set to 1 when any column in the result set has a LOB native type.
      * Derived once at cache-build time.  When 0, SnapshotCellLocked in the
@@ -156,6 +194,75 @@ typedef struct OradpiStmt {
      * can be skipped entirely, removing per-row lock contention for the
      * common case of scalar-only queries. */
     int               fetchHasLobCols;
+
+    /* Columns of a LOB type defined as LONG_VARCHAR/LONG_RAW because the
+     * connection's inlineLobMax was set when the cache was built; each
+     * fetched batch is checked against fetchLobMax.  NULL when none. */
+    unsigned char    *fetchLongLob; /* [fetchCacheNumCols] */
+    uint32_t          fetchLobMax;
+
+    /* Per-column intern tables for repeated character values, enabled by
+     * "oraconfig $S internstrings N".  Keyed on the raw bytes of the define
+     * buffer; each table holds at most internMax shared Tcl_Obj values.
+     * Built with the fetch cache; NULL when disabled, and NULL per column
+     * for non-character columns. */
+    uint32_t          internMax;   /* 0 = interning disabled */
+    Tcl_HashTable   **fetchIntern; /* [fetchCacheNumCols] */
+
+    /* Per-column define overrides ("oraconfig $S coltypes {col type ...}"),
+     * resolved against the result columns when the fetch cache is built.
+     * fetchDateFmt records the ORADPI_DATEFMT_* chosen for each date
+     * column (0xFF where not overridden); NULL when there are none. */
+    Tcl_Obj          *colTypes;
+    unsigned char    *fetchDateFmt; /* [fetchCacheNumCols] */
+    /* Nonzero per column for NUMBERs defined as exact decimal text by the
+     * precision-aware define selection; NULL when no column is. */
+    unsigned char    *fetchNumText; /* [fetchCacheNumCols] */
+    /* Nonzero per column for TIMESTAMP WITH (LOCAL) TIME ZONE, which
+     * "-dateformat clock" returns as UTC epoch seconds; NULL if none. */
+    unsigned char    *fetchDateTz; /* [fetchCacheNumCols] */
+
+    /* Double-buffered readahead ("oraconfig $S readahead 1").  While the
+     * interp converts one batch, a pool worker fetches the next one and
+     * snapshots it out of the define buffers.  ra is created lazily by
+     * orafetch and released by Oradpi_ReadaheadDiscard. */
+    int               readahead;
+    struct OradpiReadahead *ra;
+
+    /* Scrollable cursor ("oraparse -scrollable").  scrollWin holds the
+     * converted rows of recent list fetches, numbered from scrollWinFirst,
+     * so paging back and forth inside it needs no round trip; scrollNext
+     * is the row the cursor must return next after a page was served
+     * from it (0 = the cursor is in step).  Both are dropped with the
+     * readahead state, whenever the cursor is reset. */
+    int               scrollable;
+    Tcl_Obj          *scrollWin;
+    uint64_t          scrollWinFirst;
+    int               scrollWinShape;
+    uint64_t          scrollNext;
+
+    /* Result cache ("oraconfig $S resultcache seconds").  After oraexec,
+     * rcHit is the entry answering the query (the execute was skipped)
+     * or rcKey the key its rows are to be published under.  On an events
+     * connection stmt is prepared through the change-notification
+     * subscription (rcSubscrStmt), so the execute that produced the rows
+     * registered them as query rcQueryId; rcChangeSeq is the notification
+     * count seen before that execute. */
+    uint32_t          resultCacheTtl;
+    struct OradpiResultCacheEntry *rcHit;
+    char             *rcKey;
+    int               rcSubscrStmt;
+    uint64_t          rcSubscrId;
+    uint64_t          rcQueryId;
+    uint64_t          rcChangeSeq;
+
+    /* REF CURSOR OUT binds, in bind order. */
+    OradpiCursorBind *cursorBinds;
+    Tcl_Size          nCursorBinds;
+
+    /* Active orafetchasync, or NULL.  The statement counts as busy
+     * (Oradpi_StmtIsAsyncBusy) while this is set. */
+    struct OradpiFetchAsync *fetchAsync;
 } OradpiStmt;
 
 typedef struct OradpiLob {
@@ -173,6 +280,14 @@ typedef struct OradpiInterpState {
      * controls teardown in the correct phase order. */
     BindStoreMap  bindStoreMap;
     PendingMap    pendingMap;
+    /* Fetch cache name objects shared by the interp's statements
+     * (cmd_fetch.c): raw column name -> upper-cased Tcl_Obj, and the
+     * "-indexbynumber" keys "0".."n-1". */
+    Tcl_HashTable fetchNames;
+    Tcl_Obj     **fetchNumberKeys;
+    uint32_t      numFetchNumberKeys;
+    /* oraresult handles (cmd_result.c) */
+    Tcl_HashTable results;
 } OradpiInterpState;
 
 OradpiLob *Oradpi_LookupLob(Tcl_Interp *ip, Tcl_Obj *nameObj);